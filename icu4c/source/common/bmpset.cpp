@@ -23,6 +23,7 @@
 #include "cmemory.h"
 #include "bmpset.h"
 #include "uassert.h"
+#include "ustr_ascii.h"
 
 U_NAMESPACE_BEGIN
 
@@ -48,13 +49,16 @@ BMPSet::BMPSet(const int32_t *parentList, int32_t parentListLength) :
     containsFFFD=containsSlow(0xfffd, list4kStarts[0xf], list4kStarts[0x10]);
 
     initBits();
+    initASCIIRanges();
     overrideIllegal();
 }
 
 BMPSet::BMPSet(const BMPSet &otherBMPSet, const int32_t *newParentList, int32_t newParentListLength) :
+        asciiRangesLength(otherBMPSet.asciiRangesLength),
         containsFFFD(otherBMPSet.containsFFFD),
         list(newParentList), listLength(newParentListLength) {
     uprv_memcpy(latin1Contains, otherBMPSet.latin1Contains, sizeof(latin1Contains));
+    uprv_memcpy(asciiRanges, otherBMPSet.asciiRanges, sizeof(asciiRanges));
     uprv_memcpy(table7FF, otherBMPSet.table7FF, sizeof(table7FF));
     uprv_memcpy(bmpBlockBits, otherBMPSet.bmpBlockBits, sizeof(bmpBlockBits));
     uprv_memcpy(list4kStarts, otherBMPSet.list4kStarts, sizeof(list4kStarts));
@@ -218,6 +222,35 @@ void BMPSet::initBits() {
     }
 }
 
+/*
+ * Collect the ASCII part of the set as a short list of ranges.
+ * Typical tokenizer sets like [:Letter:] or [\t\n\r\x20] have only a few ranges
+ * below U+0080, which can be classified with a few vector comparisons.
+ */
+void BMPSet::initASCIIRanges() {
+    int32_t length=0;
+    UChar32 c=0;
+    for(;;) {
+        while(c<0x80 && !latin1Contains[c]) {
+            ++c;
+        }
+        if(c==0x80) {
+            break;
+        }
+        if(length==ASCII_RANGES_CAPACITY) {
+            length=-1;  // Too many ranges.
+            break;
+        }
+        asciiRanges[2*length]=(uint8_t)c;
+        while(c<0x80 && latin1Contains[c]) {
+            ++c;
+        }
+        asciiRanges[2*length+1]=(uint8_t)(c-1);
+        ++length;
+    }
+    asciiRangesLength=(int8_t)length;
+}
+
 /*
  * Override some bits and bytes to the result of contains(FFFD)
  * for faster validity checking at runtime.
@@ -315,6 +348,132 @@ BMPSet::contains(UChar32 c) const {
     }
 }
 
+#if UPRV_HAVE_SSE2
+
+namespace {
+
+// Returns a mask with 0xff for each byte in v that is in one of the ranges.
+// Signed comparisons are fine because all ranges are in 0..7F;
+// bytes 80..FF compare as negative values and are not in any range.
+inline __m128i inASCIIRanges(__m128i v, const uint8_t *ranges, int32_t rangesLength) {
+    __m128i in=_mm_setzero_si128();
+    for(int32_t i=0; i<rangesLength; ++i) {
+        __m128i ge=_mm_cmpgt_epi8(v, _mm_set1_epi8((char)(ranges[2*i]-1)));
+        __m128i gt=_mm_cmpgt_epi8(v, _mm_set1_epi8((char)ranges[2*i+1]));
+        in=_mm_or_si128(in, _mm_andnot_si128(gt, ge));
+    }
+    return in;
+}
+
+// TRUE if all bytes in v are ASCII with spanCondition==contains(b).
+inline UBool spansASCIIBlock(__m128i v, const uint8_t *ranges, int32_t rangesLength,
+                             USetSpanCondition spanCondition) {
+    int32_t mask=_mm_movemask_epi8(inASCIIRanges(v, ranges, rangesLength));
+    if(!spanCondition) {
+        // ASCII and not in the set.
+        mask=~(mask|_mm_movemask_epi8(v))&0xffff;
+    }
+    return mask==0xffff;
+}
+
+}  // namespace
+
+#elif UPRV_HAVE_NEON
+
+namespace {
+
+// Returns a mask with 0xff for each byte in v that is in one of the ranges.
+// All ranges are in 0..7F, so bytes 80..FF are not in any range.
+inline uint8x16_t inASCIIRanges(uint8x16_t v, const uint8_t *ranges, int32_t rangesLength) {
+    uint8x16_t in=vdupq_n_u8(0);
+    for(int32_t i=0; i<rangesLength; ++i) {
+        in=vorrq_u8(in, vandq_u8(vcgeq_u8(v, vdupq_n_u8(ranges[2*i])),
+                                 vcleq_u8(v, vdupq_n_u8(ranges[2*i+1]))));
+    }
+    return in;
+}
+
+// TRUE if all bytes in v are ASCII with spanCondition==contains(b).
+inline UBool spansASCIIBlock(uint8x16_t v, const uint8_t *ranges, int32_t rangesLength,
+                             USetSpanCondition spanCondition) {
+    uint8x16_t in=inASCIIRanges(v, ranges, rangesLength);
+    if(!spanCondition) {
+        // ASCII and not in the set.
+        in=vbicq_u8(vcltq_u8(v, vdupq_n_u8(0x80)), in);
+    }
+    return vminvq_u8(in)==0xff;
+}
+
+}  // namespace
+
+#endif
+
+int32_t
+BMPSet::spanASCIIBlocks(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const {
+    int32_t i=0;
+#if UPRV_HAVE_SSE2 || UPRV_HAVE_NEON
+    if(asciiRangesLength<0) {
+        return 0;
+    }
+    for(; (length-i)>=16; i+=16) {
+#if UPRV_HAVE_SSE2
+        __m128i v=_mm_loadu_si128((const __m128i *)(s+i));
+#else
+        uint8x16_t v=vld1q_u8(s+i);
+#endif
+        if(!spansASCIIBlock(v, asciiRanges, asciiRangesLength, spanCondition)) {
+            break;
+        }
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)spanCondition;
+#endif
+    return i;
+}
+
+int32_t
+BMPSet::spanASCIIBlocks(const UChar *s, int32_t length, USetSpanCondition spanCondition) const {
+    int32_t i=0;
+#if UPRV_HAVE_SSE2 || UPRV_HAVE_NEON
+    if(asciiRangesLength<0) {
+        return 0;
+    }
+#if UPRV_HAVE_SSE2
+    const __m128i nonASCII=_mm_set1_epi16((short)0xff80);
+    const __m128i zero=_mm_setzero_si128();
+#endif
+    for(; (length-i)>=16; i+=16) {
+        // Narrow 16 UChars to bytes if they are all ASCII.
+#if UPRV_HAVE_SSE2
+        __m128i v1=_mm_loadu_si128((const __m128i *)(s+i));
+        __m128i v2=_mm_loadu_si128((const __m128i *)(s+i+8));
+        __m128i bad=_mm_and_si128(_mm_or_si128(v1, v2), nonASCII);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(bad, zero))!=0xffff) {
+            break;
+        }
+        __m128i v=_mm_packus_epi16(v1, v2);
+#else
+        uint16x8_t v1=vld1q_u16((const uint16_t *)(s+i));
+        uint16x8_t v2=vld1q_u16((const uint16_t *)(s+i+8));
+        if(vmaxvq_u16(vorrq_u16(v1, v2))>0x7f) {
+            break;
+        }
+        uint8x16_t v=vcombine_u8(vmovn_u16(v1), vmovn_u16(v2));
+#endif
+        if(!spansASCIIBlock(v, asciiRanges, asciiRangesLength, spanCondition)) {
+            break;
+        }
+    }
+#else
+    (void)s;
+    (void)length;
+    (void)spanCondition;
+#endif
+    return i;
+}
+
 /*
  * Check for sufficient length for trail unit for each surrogate pair.
  * Handle single surrogates as surrogate code points as usual in ICU.
@@ -323,6 +482,12 @@ const UChar *
 BMPSet::span(const UChar *s, const UChar *limit, USetSpanCondition spanCondition) const {
     UChar c, c2;
 
+    // Skip a leading run of ASCII characters 16 at a time.
+    s+=spanASCIIBlocks(s, (int32_t)(limit-s), spanCondition);
+    if(s==limit) {
+        return s;
+    }
+
     if(spanCondition) {
         // span
         do {
@@ -512,20 +677,25 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
     uint8_t b=*s;
     if(U8_IS_SINGLE(b)) {
         // Initial all-ASCII span.
+        s+=spanASCIIBlocks(s, length, spanCondition);
+        if(s==limit) {
+            return s;
+        }
+        b=*s;
         if(spanCondition) {
-            do {
+            while(U8_IS_SINGLE(b)) {
                 if(!latin1Contains[b] || ++s==limit) {
                     return s;
                 }
                 b=*s;
-            } while(U8_IS_SINGLE(b));
+            }
         } else {
-            do {
+            while(U8_IS_SINGLE(b)) {
                 if(latin1Contains[b] || ++s==limit) {
                     return s;
                 }
                 b=*s;
-            } while(U8_IS_SINGLE(b));
+            }
         }
         length=(int32_t)(limit-s);
     }
@@ -578,24 +748,29 @@ BMPSet::spanUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanConditi
         b=*s;
         if(U8_IS_SINGLE(b)) {
             // ASCII
+            s+=spanASCIIBlocks(s, (int32_t)(limit-s), spanCondition);
+            if(s==limit) {
+                return limit0;
+            }
+            b=*s;
             if(spanCondition) {
-                do {
+                while(U8_IS_SINGLE(b)) {
                     if(!latin1Contains[b]) {
                         return s;
                     } else if(++s==limit) {
                         return limit0;
                     }
                     b=*s;
-                } while(U8_IS_SINGLE(b));
+                }
             } else {
-                do {
+                while(U8_IS_SINGLE(b)) {
                     if(latin1Contains[b]) {
                         return s;
                     } else if(++s==limit) {
                         return limit0;
                     }
                     b=*s;
-                } while(U8_IS_SINGLE(b));
+                }
             }
         }
         ++s;  // Advance past the lead byte.
@@ -72,7 +72,22 @@ class BMPSet : public UMemory {
     int32_t spanBackUTF8(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const;
 
 private:
+    enum { ASCII_RANGES_CAPACITY=6 };
+
     void initBits();
+    void initASCIIRanges();
+
+    /*
+     * Span whole blocks of 16 ASCII characters for which each character c
+     * has spanCondition==contains(c), using vector instructions where available.
+     * The caller continues with its regular per-character code after the
+     * returned length, which is a multiple of 16 and at most length.
+     * Returns 0 when the ASCII part of the set has too many ranges
+     * or vector instructions are not available.
+     */
+    int32_t spanASCIIBlocks(const uint8_t *s, int32_t length, USetSpanCondition spanCondition) const;
+    int32_t spanASCIIBlocks(const UChar *s, int32_t length, USetSpanCondition spanCondition) const;
+
     void overrideIllegal();
 
     /**
@@ -101,6 +116,14 @@ class BMPSet : public UMemory {
      */
     UBool latin1Contains[0x100];
 
+    /*
+     * The ASCII part of the set as start/end pairs of up to
+     * ASCII_RANGES_CAPACITY ranges, for classifying 16 bytes at a time.
+     * asciiRangesLength is the number of ranges, or -1 if there are more.
+     */
+    uint8_t asciiRanges[2*ASCII_RANGES_CAPACITY];
+    int8_t asciiRangesLength;
+
     /* TRUE if contains(U+FFFD). */
     UBool containsFFFD;
 
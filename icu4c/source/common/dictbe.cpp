@@ -1077,6 +1077,9 @@ CjkBreakEngine::~CjkBreakEngine(){
 static const int32_t kMaxKatakanaLength = 8;
 static const int32_t kMaxKatakanaGroupLength = 20;
 static const uint32_t maxSnlp = 255;
+// Ranges up to this many code points are segmented without heap allocations
+// for the dynamic program.
+static const int32_t kStackRangeLength = 80;
 
 static inline uint32_t getKatakanaCost(int32_t wordLength){
     //TODO: fill array with actual values from dictionary!
@@ -1239,27 +1242,37 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         }
     }
                 
+    // Scratch arrays for the dynamic program.
+    // They stay on the stack for the short ranges that are typical of CJK text,
+    // so that most calls do not allocate memory.
+
     // bestSnlp[i] is the snlp of the best segmentation of the first i
     // code points in the range to be matched.
-    UVector32 bestSnlp(numCodePts + 1, status);
-    bestSnlp.addElement(0, status);
-    for(int32_t i = 1; i <= numCodePts; i++) {
-        bestSnlp.addElement(kuint32max, status);
-    }
-
+    MaybeStackArray<uint32_t, kStackRangeLength + 1> bestSnlp(numCodePts + 1);
 
     // prev[i] is the index of the last CJK code point in the previous word in 
     // the best segmentation of the first i characters.
-    UVector32 prev(numCodePts + 1, status);
+    MaybeStackArray<int32_t, kStackRangeLength + 1> prev(numCodePts + 1);
+
+    // t_boundary[] receives the segmentation, see below.
+    MaybeStackArray<int32_t, kStackRangeLength + 2> t_boundary(numCodePts + 2);
+    if (bestSnlp.getCapacity() <= numCodePts || prev.getCapacity() <= numCodePts ||
+            t_boundary.getCapacity() <= numCodePts + 1) {
+        return 0;
+    }
+    bestSnlp[0] = 0;
+    for(int32_t i = 1; i <= numCodePts; i++) {
+        bestSnlp[i] = kuint32max;
+    }
     for(int32_t i = 0; i <= numCodePts; i++){
-        prev.addElement(-1, status);
+        prev[i] = -1;
     }
 
+    // The dictionary matches at most one word per code unit of maxWordSize,
+    // plus the single-character word added below.
     const int32_t maxWordSize = 20;
-    UVector32 values(numCodePts, status);
-    values.setSize(numCodePts);
-    UVector32 lengths(numCodePts, status);
-    lengths.setSize(numCodePts);
+    int32_t values[maxWordSize + 1];
+    int32_t lengths[maxWordSize + 1];
 
     UText fu = UTEXT_INITIALIZER;
     utext_openUnicodeString(&fu, &inString, &status);
@@ -1272,14 +1285,14 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t ix = 0;
     bool is_prev_katakana = false;
     for (int32_t i = 0;  i < numCodePts;  ++i, ix = inString.moveIndex32(ix, 1)) {
-        if ((uint32_t)bestSnlp.elementAti(i) == kuint32max) {
+        if (bestSnlp[i] == kuint32max) {
             continue;
         }
 
         int32_t count;
         utext_setNativeIndex(&fu, ix);
-        count = fDictionary->matches(&fu, maxWordSize, numCodePts,
-                             NULL, lengths.getBuffer(), values.getBuffer(), NULL);
+        count = fDictionary->matches(&fu, maxWordSize, maxWordSize,
+                             NULL, lengths, values, NULL);
                              // Note: lengths is filled with code point lengths
                              //       The NULL parameter is the ignored code unit lengths.
 
@@ -1288,18 +1301,18 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
         // with the highest value possible, i.e. the least likely to occur.
         // Exclude Korean characters from this treatment, as they should be left
         // together by default.
-        if ((count == 0 || lengths.elementAti(0) != 1) &&
+        if ((count == 0 || lengths[0] != 1) &&
                 !fHangulWordSet.contains(inString.char32At(ix))) {
-            values.setElementAt(maxSnlp, count);   // 255
-            lengths.setElementAt(1, count++);
+            values[count] = maxSnlp;   // 255
+            lengths[count++] = 1;
         }
 
         for (int32_t j = 0; j < count; j++) {
-            uint32_t newSnlp = (uint32_t)bestSnlp.elementAti(i) + (uint32_t)values.elementAti(j);
-            int32_t ln_j_i = lengths.elementAti(j) + i;
-            if (newSnlp < (uint32_t)bestSnlp.elementAti(ln_j_i)) {
-                bestSnlp.setElementAt(newSnlp, ln_j_i);
-                prev.setElementAt(i, ln_j_i);
+            uint32_t newSnlp = bestSnlp[i] + (uint32_t)values[j];
+            int32_t ln_j_i = lengths[j] + i;
+            if (newSnlp < bestSnlp[ln_j_i]) {
+                bestSnlp[ln_j_i] = newSnlp;
+                prev[ln_j_i] = i;
             }
         }
 
@@ -1320,10 +1333,10 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
                 katakanaRunLength++;
             }
             if (katakanaRunLength < kMaxKatakanaGroupLength) {
-                uint32_t newSnlp = bestSnlp.elementAti(i) + getKatakanaCost(katakanaRunLength);
-                if (newSnlp < (uint32_t)bestSnlp.elementAti(i+katakanaRunLength)) {
-                    bestSnlp.setElementAt(newSnlp, i+katakanaRunLength);
-                    prev.setElementAt(i, i+katakanaRunLength);  // prev[j] = i;
+                uint32_t newSnlp = bestSnlp[i] + getKatakanaCost(katakanaRunLength);
+                if (newSnlp < bestSnlp[i+katakanaRunLength]) {
+                    bestSnlp[i+katakanaRunLength] = newSnlp;
+                    prev[i+katakanaRunLength] = i;  // prev[j] = i;
                 }
             }
         }
@@ -1335,26 +1348,21 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     // prev[numCodePts] is guaranteed to be meaningful.
     // We'll first push in the reverse order, i.e.,
     // t_boundary[0] = numCodePts, and afterwards do a swap.
-    UVector32 t_boundary(numCodePts+1, status);
-
     int32_t numBreaks = 0;
     // No segmentation found, set boundary to end of range
-    if ((uint32_t)bestSnlp.elementAti(numCodePts) == kuint32max) {
-        t_boundary.addElement(numCodePts, status);
-        numBreaks++;
+    if (bestSnlp[numCodePts] == kuint32max) {
+        t_boundary[numBreaks++] = numCodePts;
     } else {
-        for (int32_t i = numCodePts; i > 0; i = prev.elementAti(i)) {
-            t_boundary.addElement(i, status);
-            numBreaks++;
+        for (int32_t i = numCodePts; i > 0; i = prev[i]) {
+            t_boundary[numBreaks++] = i;
         }
-        U_ASSERT(prev.elementAti(t_boundary.elementAti(numBreaks - 1)) == 0);
+        U_ASSERT(prev[t_boundary[numBreaks - 1]] == 0);
     }
 
     // Add a break for the start of the dictionary range if there is not one
     // there already.
     if (foundBreaks.size() == 0 || foundBreaks.peeki() < rangeStart) {
-        t_boundary.addElement(0, status);
-        numBreaks++;
+        t_boundary[numBreaks++] = 0;
     }
 
     // Now that we're done, convert positions in t_boundary[] (indices in 
@@ -1363,7 +1371,7 @@ CjkBreakEngine::divideUpDictionaryRange( UText *inText,
     int32_t prevCPPos = -1;
     int32_t prevUTextPos = -1;
     for (int32_t i = numBreaks-1; i >= 0; i--) {
-        int32_t cpPos = t_boundary.elementAti(i);
+        int32_t cpPos = t_boundary[i];
         U_ASSERT(cpPos > prevCPPos);
         int32_t utextPos =  inputMap.isValid() ? inputMap->elementAti(cpPos) : cpPos + rangeStart;
         U_ASSERT(utextPos >= prevUTextPos);
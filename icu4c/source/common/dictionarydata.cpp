@@ -51,9 +51,9 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     int32_t wordCount = 0;
     int32_t codePointsMatched = 0;
 
-    for (UChar32 c = utext_next32(text); c >= 0; c=utext_next32(text)) {
+    for (UChar32 c = UTEXT_NEXT32(text); c >= 0; c=UTEXT_NEXT32(text)) {
         UStringTrieResult result = (codePointsMatched == 0) ? uct.first(c) : uct.next(c);
-        int32_t lengthMatched = (int32_t)utext_getNativeIndex(text) - startingTextIndex;
+        int32_t lengthMatched = (int32_t)UTEXT_GETNATIVEINDEX(text) - startingTextIndex;
         codePointsMatched += 1;
         if (USTRINGTRIE_HAS_VALUE(result)) {
             if (wordCount < limit) {
@@ -86,6 +86,16 @@ int32_t UCharsDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     return wordCount;
 }
 
+BytesDictionaryMatcher::BytesDictionaryMatcher(const char *c, int32_t t, UDataMemory *f)
+        : characters(c), transformConstant(t), file(f) {
+    BytesTrie bt(characters);
+    for (int32_t b = 0; b <= 0xff; ++b) {
+        UStringTrieResult result = bt.first(b);
+        firstResults[b] = (uint8_t)result;
+        firstStates[b] = result != USTRINGTRIE_NO_MATCH ? bt.getState64() : 0;
+    }
+}
+
 BytesDictionaryMatcher::~BytesDictionaryMatcher() {
     udata_close(file);
 }
@@ -118,9 +128,23 @@ int32_t BytesDictionaryMatcher::matches(UText *text, int32_t maxLength, int32_t
     int32_t wordCount = 0;
     int32_t codePointsMatched = 0;
 
-    for (UChar32 c = utext_next32(text); c >= 0; c=utext_next32(text)) {
-        UStringTrieResult result = (codePointsMatched == 0) ? bt.first(transform(c)) : bt.next(transform(c));
-        int32_t lengthMatched = (int32_t)utext_getNativeIndex(text) - startingTextIndex;
+    for (UChar32 c = UTEXT_NEXT32(text); c >= 0; c=UTEXT_NEXT32(text)) {
+        UStringTrieResult result;
+        if (codePointsMatched == 0) {
+            // Same as bt.first(transform(c)), from the precomputed states.
+            int32_t b = transform(c);
+            if (b < 0) {
+                b += 0x100;
+            }
+            if (b <= 0xff && (result = (UStringTrieResult)firstResults[b]) != USTRINGTRIE_NO_MATCH) {
+                bt.resetToState64(firstStates[b]);
+            } else {
+                result = USTRINGTRIE_NO_MATCH;
+            }
+        } else {
+            result = bt.next(transform(c));
+        }
+        int32_t lengthMatched = (int32_t)UTEXT_GETNATIVEINDEX(text) - startingTextIndex;
         codePointsMatched += 1;
         if (USTRINGTRIE_HAS_VALUE(result)) {
             if (wordCount < limit) {
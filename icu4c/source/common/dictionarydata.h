@@ -120,8 +120,7 @@ class U_COMMON_API BytesDictionaryMatcher : public DictionaryMatcher {
     // constructs a new BytesTrieDictionaryMatcher
     // the transform constant should be the constant read from the file, not a masked version!
     // the UDataMemory * fed in here will be closed on this object's destruction
-    BytesDictionaryMatcher(const char *c, int32_t t, UDataMemory *f)
-            : characters(c), transformConstant(t), file(f) { }
+    BytesDictionaryMatcher(const char *c, int32_t t, UDataMemory *f);
     virtual ~BytesDictionaryMatcher();
     virtual int32_t matches(UText *text, int32_t maxLength, int32_t limit,
                             int32_t *lengths, int32_t *cpLengths, int32_t *values,
@@ -133,6 +132,11 @@ class U_COMMON_API BytesDictionaryMatcher : public DictionaryMatcher {
     const char *characters;
     int32_t transformConstant;
     UDataMemory *file;
+    // The trie result and state (BytesTrie::getState64()) after the first byte,
+    // for each byte value, so that matching skips the large branch at the root.
+    // The state is 0 where the result is USTRINGTRIE_NO_MATCH.
+    uint64_t firstStates[256];
+    uint8_t firstResults[256];
 };
 
 U_NAMESPACE_END
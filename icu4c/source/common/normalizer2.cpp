@@ -20,11 +20,16 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/appendable.h"
+#include "unicode/bytestream.h"
 #include "unicode/edits.h"
 #include "unicode/normalizer2.h"
 #include "unicode/stringoptions.h"
 #include "unicode/unistr.h"
 #include "unicode/unorm.h"
+#include "unicode/utf8.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
 #include "cstring.h"
 #include "mutex.h"
 #include "norm2allmodes.h"
@@ -304,6 +309,197 @@ static UBool U_CALLCONV uprv_normalizer2_cleanup() {
 
 U_CDECL_END
 
+// StreamingNormalizer ----------------------------------------------------- ***
+
+namespace {
+
+// Ill-formed sequences and unpaired surrogates might be completed by the next chunk
+// or might complete the previous one, so they are never used as boundaries.
+inline UBool isBoundaryBefore(const Normalizer2 &norm2, UChar32 c) {
+    return c >= 0 && !U_IS_SURROGATE(c) && norm2.hasBoundaryBefore(c);
+}
+
+// Returns the index of the first boundary in s, or -1 if there is none.
+int32_t firstBoundaryUTF8(const Normalizer2 &norm2, const uint8_t *s, int32_t length) {
+    for (int32_t i = 0; i < length;) {
+        int32_t start = i;
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if (isBoundaryBefore(norm2, c)) {
+            return start;
+        }
+    }
+    return -1;
+}
+
+// Returns the index of the last boundary in s, or -1 if there is none.
+int32_t lastBoundaryUTF8(const Normalizer2 &norm2, const uint8_t *s, int32_t length) {
+    for (int32_t i = length; i > 0;) {
+        UChar32 c;
+        U8_PREV(s, 0, i, c);
+        if (isBoundaryBefore(norm2, c)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int32_t firstBoundaryUTF16(const Normalizer2 &norm2, const UChar *s, int32_t length) {
+    for (int32_t i = 0; i < length;) {
+        int32_t start = i;
+        UChar32 c;
+        U16_NEXT(s, i, length, c);
+        if (isBoundaryBefore(norm2, c)) {
+            return start;
+        }
+    }
+    return -1;
+}
+
+int32_t lastBoundaryUTF16(const Normalizer2 &norm2, const UChar *s, int32_t length) {
+    for (int32_t i = length; i > 0;) {
+        UChar32 c;
+        U16_PREV(s, 0, i, c);
+        if (isBoundaryBefore(norm2, c)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+StreamingNormalizer::StreamingNormalizer(const Normalizer2 &n2) :
+        norm2(n2), pending8(nullptr), pending8Length(0), pending8Capacity(0) {}
+
+StreamingNormalizer::~StreamingNormalizer() {
+    uprv_free(pending8);
+}
+
+void StreamingNormalizer::reset() {
+    pending16.remove();
+    pending8Length = 0;
+}
+
+UBool StreamingNormalizer::appendPendingUTF8(const char *s, int32_t length, UErrorCode &errorCode) {
+    if (length <= 0) {
+        return TRUE;  // s may be nullptr for an empty chunk
+    }
+    if (length > (pending8Capacity - pending8Length)) {
+        if (length > (INT32_MAX - pending8Length)) {
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return FALSE;
+        }
+        int32_t newCapacity = pending8Length + length;
+        if (newCapacity < 200) {
+            newCapacity = 200;
+        } else if (newCapacity <= (INT32_MAX / 2)) {
+            newCapacity *= 2;
+        }
+        char *newPending = (char *)uprv_realloc(pending8, newCapacity);
+        if (newPending == nullptr) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return FALSE;
+        }
+        pending8 = newPending;
+        pending8Capacity = newCapacity;
+    }
+    uprv_memcpy(pending8 + pending8Length, s, length);
+    pending8Length += length;
+    return TRUE;
+}
+
+void StreamingNormalizer::appendUTF8(StringPiece chunk, ByteSink &sink, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (!pending16.isEmpty()) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const uint8_t *s = reinterpret_cast<const uint8_t *>(chunk.data());
+    int32_t length = chunk.length();
+    int32_t last = lastBoundaryUTF8(norm2, s, length);
+    if (last < 0) {
+        // Nothing in this chunk can be written yet.
+        appendPendingUTF8(chunk.data(), length, errorCode);
+        return;
+    }
+    // The text before the first boundary belongs with the pending text.
+    int32_t start = 0;
+    if (pending8Length > 0) {
+        start = firstBoundaryUTF8(norm2, s, length);
+        if (!appendPendingUTF8(chunk.data(), start, errorCode)) {
+            return;
+        }
+        norm2.normalizeUTF8(0, StringPiece(pending8, pending8Length), sink, nullptr, errorCode);
+        pending8Length = 0;
+    }
+    if (start < last) {
+        norm2.normalizeUTF8(0, StringPiece(chunk.data() + start, last - start), sink, nullptr, errorCode);
+    }
+    appendPendingUTF8(chunk.data() + last, length - last, errorCode);
+}
+
+void StreamingNormalizer::finishUTF8(ByteSink &sink, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (pending8Length > 0) {
+        norm2.normalizeUTF8(0, StringPiece(pending8, pending8Length), sink, nullptr, errorCode);
+    }
+    reset();
+}
+
+void StreamingNormalizer::normalizeToAppendable(const UnicodeString &src, Appendable &dest,
+                                                UErrorCode &errorCode) const {
+    UnicodeString result;
+    norm2.normalize(src, result, errorCode);
+    if (U_SUCCESS(errorCode) && !result.isEmpty()) {
+        dest.appendString(result.getBuffer(), result.length());
+    }
+}
+
+void StreamingNormalizer::append(const UnicodeString &chunk, Appendable &dest, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (pending8Length > 0 || chunk.isBogus()) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    const UChar *s = chunk.getBuffer();
+    int32_t length = chunk.length();
+    int32_t last = lastBoundaryUTF16(norm2, s, length);
+    if (last < 0) {
+        // Nothing in this chunk can be written yet.
+        pending16.append(chunk);
+        return;
+    }
+    // The text before the first boundary belongs with the pending text.
+    int32_t start = 0;
+    if (!pending16.isEmpty()) {
+        start = firstBoundaryUTF16(norm2, s, length);
+        pending16.append(chunk, 0, start);
+        normalizeToAppendable(pending16, dest, errorCode);
+    }
+    if (start < last) {
+        // Read-only alias, no copy of the chunk.
+        normalizeToAppendable(UnicodeString(FALSE, s + start, last - start), dest, errorCode);
+    }
+    pending16.setTo(chunk, last);
+}
+
+void StreamingNormalizer::finish(Appendable &dest, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (!pending16.isEmpty()) {
+        normalizeToAppendable(pending16, dest, errorCode);
+    }
+    reset();
+}
+
 U_NAMESPACE_END
 
 // C API ------------------------------------------------------------------- ***
@@ -40,6 +40,7 @@
 #include "uassert.h"
 #include "ucptrie_impl.h"
 #include "uset_imp.h"
+#include "ustr_ascii.h"
 #include "uvector.h"
 
 U_NAMESPACE_BEGIN
@@ -579,6 +580,16 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
     }
 }
 
+void
+Normalizer2Impl::decompose(const uint8_t *src, const uint8_t *limit,
+                           UnicodeString &dest, UErrorCode &errorCode) const {
+    dest.remove();
+    ReorderingBuffer buffer(*this, dest);
+    if(buffer.init((int32_t)(limit-src), errorCode)) {
+        decomposeShort(src, limit, FALSE, FALSE, buffer, errorCode);
+    }
+}
+
 // Dual functionality:
 // buffer!=NULL: normalize
 // buffer==NULL: isNormalized/spanQuickCheckYes
@@ -605,7 +616,9 @@ Normalizer2Impl::decompose(const UChar *src, const UChar *limit,
 
     for(;;) {
         // count code units below the minimum or with irrelevant data for the quick check
-        for(prevSrc=src; src!=limit;) {
+        prevSrc=src;
+        src+=uprv_countUCharsBelow(src, (int32_t)(limit-src), (UChar)minNoCP);
+        while(src!=limit) {
             if( (c=*src)<minNoCP ||
                 isMostDecompYesAndZeroCC(norm16=UCPTRIE_FAST_BMP_GET(normTrie, UCPTRIE_16, c))
             ) {
@@ -1332,6 +1345,8 @@ Normalizer2Impl::compose(const UChar *src, const UChar *limit,
         const UChar *prevSrc;
         UChar32 c = 0;
         uint16_t norm16 = 0;
+        // Skip blocks of code units below minNoMaybeCP before the per-character loop.
+        src += uprv_countUCharsBelow(src, (int32_t)(limit - src), (UChar)minNoMaybeCP);
         for (;;) {
             if (src == limit) {
                 if (prevBoundary != limit && doCompose) {
@@ -1596,6 +1611,8 @@ Normalizer2Impl::composeQuickCheck(const UChar *src, const UChar *limit,
         const UChar *prevSrc;
         UChar32 c = 0;
         uint16_t norm16 = 0;
+        // Skip blocks of code units below minNoMaybeCP before the per-character loop.
+        src += uprv_countUCharsBelow(src, (int32_t)(limit - src), (UChar)minNoMaybeCP);
         for (;;) {
             if(src==limit) {
                 return src;
@@ -1743,6 +1760,8 @@ Normalizer2Impl::composeUTF8(uint32_t options, UBool onlyContiguous,
         // or with (compYes && ccc==0) properties.
         const uint8_t *prevSrc;
         uint16_t norm16 = 0;
+        // Skip blocks of bytes below minNoMaybeLead before the per-character loop.
+        src += uprv_countBytesBelow(src, (int32_t)(limit - src), minNoMaybeLead);
         for (;;) {
             if (src == limit) {
                 if (prevBoundary != limit && sink != nullptr) {
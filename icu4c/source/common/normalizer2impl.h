@@ -483,6 +483,13 @@ class U_COMMON_API Normalizer2Impl : public UObject {
     void decompose(const UChar *src, const UChar *limit,
                    UnicodeString &dest, int32_t destLengthEstimate,
                    UErrorCode &errorCode) const;
+    /**
+     * Decomposes the well-formed UTF-8 text [src, limit[ and writes the UTF-16 result to dest.
+     * Reuses the dest buffer if it has enough capacity.
+     * The caller must have checked that the text has no ill-formed sequences.
+     */
+    void decompose(const uint8_t *src, const uint8_t *limit,
+                   UnicodeString &dest, UErrorCode &errorCode) const;
 
     const UChar *decompose(const UChar *src, const UChar *limit,
                            ReorderingBuffer *buffer, UErrorCode &errorCode) const;
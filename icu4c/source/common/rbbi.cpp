@@ -36,6 +36,7 @@
 #include "rbbirb.h"
 #include "uassert.h"
 #include "umutex.h"
+#include "ustr_imp.h"
 #include "uvectr32.h"
 
 #ifdef RBBI_DEBUG
@@ -746,6 +747,95 @@ struct LookAheadResults {
 };
 
 
+//-----------------------------------------------------------------------------------
+//
+//  Text access for the state machine loops.
+//     next() and previous() move over one code point and return its
+//     character category, or -1 at the end/start of the text.
+//
+//-----------------------------------------------------------------------------------
+namespace {
+
+class UTextBreakText {
+public:
+    UTextBreakText(UText *text, const UTrie2 *trie) : fText(text), fTrie(trie) {}
+
+    void setIndex(int32_t index) { UTEXT_SETNATIVEINDEX(fText, index); }
+    int32_t getIndex() const { return (int32_t)UTEXT_GETNATIVEINDEX(fText); }
+
+    int32_t next() {
+        UChar32 c = UTEXT_NEXT32(fText);
+        // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
+        //        not the size of the character going in, which is a UChar32.
+        return c >= 0 ? UTRIE2_GET16(fTrie, c) : -1;
+    }
+    int32_t previous() {
+        UChar32 c = UTEXT_PREVIOUS32(fText);
+        return c >= 0 ? UTRIE2_GET16(fTrie, c) : -1;
+    }
+
+private:
+    UText *fText;
+    const UTrie2 *fTrie;
+};
+
+/**
+ * Reads the bytes of a UTF-8 UText directly, without the UText chunk
+ * conversion to UTF-16, and looks up the categories via the UTF-8 trie macros.
+ * Code point boundaries and the handling of ill-formed sequences
+ * (as U+FFFD) are the same as for the UTF-8 UText.
+ */
+class UTF8BreakText {
+public:
+    UTF8BreakText(const uint8_t *s, int32_t length, const UTrie2 *trie) :
+            fText(s), fLength(length), fIndex(0), fTrie(trie) {}
+
+    void setIndex(int32_t index) {
+        if (index <= 0) {
+            index = 0;
+        } else if (index >= fLength) {
+            index = fLength;
+        } else {
+            U8_SET_CP_START(fText, 0, index);
+        }
+        fIndex = index;
+    }
+    int32_t getIndex() const { return fIndex; }
+
+    int32_t next() {
+        if (fIndex >= fLength) {
+            return -1;
+        }
+        const uint8_t *p = fText + fIndex;
+        uint16_t category;
+        UTRIE2_U8_NEXT16(fTrie, p, fText + fLength, category);
+        if (category == fTrie->errorValue && !U8_IS_SINGLE(fText[fIndex])) {
+            // Possibly an ill-formed sequence, for which the UText returns U+FFFD.
+            UChar32 c;
+            U8_NEXT_OR_FFFD(fText, fIndex, fLength, c);
+            return UTRIE2_GET16(fTrie, c);
+        }
+        fIndex = (int32_t)(p - fText);
+        return category;
+    }
+    int32_t previous() {
+        if (fIndex <= 0) {
+            return -1;
+        }
+        UChar32 c;
+        U8_PREV_OR_FFFD(fText, 0, fIndex, c);
+        return UTRIE2_GET16(fTrie, c);
+    }
+
+private:
+    const uint8_t *fText;
+    int32_t fLength;
+    int32_t fIndex;
+    const UTrie2 *fTrie;
+};
+
+}  // namespace
+
 //-----------------------------------------------------------------------------------
 //
 //  handleNext()
@@ -753,12 +843,25 @@ struct LookAheadResults {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleNext() {
+    int32_t length;
+    const char *s = utext_getUTF8Contents(&fText, &length);
+    if (s != NULL) {
+        UTF8BreakText text(reinterpret_cast<const uint8_t *>(s), length, fData->fTrie);
+        return handleNext(text);
+    } else {
+        UTextBreakText text(&fText, fData->fTrie);
+        return handleNext(text);
+    }
+}
+
+template<typename BreakText>
+int32_t RuleBasedBreakIterator::handleNext(BreakText &text) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIRunMode         mode;
 
     RBBIStateTableRow  *row;
-    UChar32             c;
+    int32_t             nextCategory;
     LookAheadResults    lookAheadMatches;
     int32_t             result             = 0;
     int32_t             initialPosition    = 0;
@@ -767,7 +870,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
     uint32_t            tableRowLen        = statetable->fRowLen;
     #ifdef RBBI_DEBUG
         if (gTrace) {
-            RBBIDebugPuts("Handle Next   pos   char  state category");
+            RBBIDebugPuts("Handle Next   pos   state category");
         }
     #endif
 
@@ -779,10 +882,10 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
     // if we're already at the end of the text, return DONE.
     initialPosition = fPosition;
-    UTEXT_SETNATIVEINDEX(&fText, initialPosition);
+    text.setIndex(initialPosition);
     result          = initialPosition;
-    c               = UTEXT_NEXT32(&fText);
-    if (c==U_SENTINEL) {
+    nextCategory    = text.next();
+    if (nextCategory < 0) {
         fDone = TRUE;
         return UBRK_DONE;
     }
@@ -804,7 +907,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
     // loop until we reach the end of the text or transition to state 0
     //
     for (;;) {
-        if (c == U_SENTINEL) {
+        if (nextCategory < 0) {
             // Reached end of input string.
             if (mode == RBBI_END) {
                 // We have already run the loop one last time with the
@@ -823,12 +926,9 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //      that we shouldn't get a category from an actual text input character.
         //
         if (mode == RBBI_RUN) {
-            // look up the current character's character category, which tells us
+            // The current character's character category tells us
             // which column in the state table to look at.
-            // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
-            //        not the size of the character going in, which is a UChar32.
-            //
-            category = UTRIE2_GET16(fData->fTrie, c);
+            category = (uint16_t)nextCategory;
 
             // Check the dictionary bit in the character's category.
             //    Counter is only used by dictionary based iteration.
@@ -844,12 +944,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
 
        #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4" PRId64 "   ", utext_getNativeIndex(&fText));
-                if (0x20<=c && c<0x7f) {
-                    RBBIDebugPrintf("\"%c\"  ", c);
-                } else {
-                    RBBIDebugPrintf("%5x  ", c);
-                }
+                RBBIDebugPrintf("             %4d   ", text.getIndex());
                 RBBIDebugPrintf("%3d  %3d\n", state, category);
             }
         #endif
@@ -868,7 +963,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         if (row->fAccepting == -1) {
             // Match found, common case.
             if (mode != RBBI_START) {
-                result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+                result = text.getIndex();
             }
             fRuleStatusIndex = row->fTagIdx;   // Remember the break status (tag) values.
         }
@@ -886,7 +981,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         int16_t rule = row->fLookAhead;
         if (rule != 0) {
             // At the position of a '/' in a look-ahead match. Record it.
-            int32_t  pos = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+            int32_t  pos = text.getIndex();
             lookAheadMatches.setPosition(rule, pos);
         }
 
@@ -902,7 +997,7 @@ int32_t RuleBasedBreakIterator::handleNext() {
         //    the input position.  The next iteration will be processing the
         //    first real input character.
         if (mode == RBBI_RUN) {
-            c = UTEXT_NEXT32(&fText);
+            nextCategory = text.next();
         } else {
             if (mode == RBBI_START) {
                 mode = RBBI_RUN;
@@ -916,9 +1011,9 @@ int32_t RuleBasedBreakIterator::handleNext() {
     //   (This really indicates a defect in the break rules.  They should always match
     //    at least one character.)
     if (result == initialPosition) {
-        utext_setNativeIndex(&fText, initialPosition);
-        utext_next32(&fText);
-        result = (int32_t)utext_getNativeIndex(&fText);
+        text.setIndex(initialPosition);
+        text.next();
+        result = text.getIndex();
         fRuleStatusIndex = 0;
     }
 
@@ -943,52 +1038,57 @@ int32_t RuleBasedBreakIterator::handleNext() {
 //
 //-----------------------------------------------------------------------------------
 int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
+    int32_t length;
+    const char *s = utext_getUTF8Contents(&fText, &length);
+    if (s != NULL) {
+        UTF8BreakText text(reinterpret_cast<const uint8_t *>(s), length, fData->fTrie);
+        return handleSafePrevious(fromPosition, text);
+    } else {
+        UTextBreakText text(&fText, fData->fTrie);
+        return handleSafePrevious(fromPosition, text);
+    }
+}
+
+template<typename BreakText>
+int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition, BreakText &text) {
     int32_t             state;
     uint16_t            category        = 0;
     RBBIStateTableRow  *row;
-    UChar32             c;
+    int32_t             prevCategory;
     int32_t             result          = 0;
 
     const RBBIStateTable *stateTable = fData->fReverseTable;
-    UTEXT_SETNATIVEINDEX(&fText, fromPosition);
+    text.setIndex(fromPosition);
     #ifdef RBBI_DEBUG
         if (gTrace) {
-            RBBIDebugPuts("Handle Previous   pos   char  state category");
+            RBBIDebugPuts("Handle Previous   pos   state category");
         }
     #endif
 
     // if we're already at the start of the text, return DONE.
-    if (fData == NULL || UTEXT_GETNATIVEINDEX(&fText)==0) {
+    if (fData == NULL || text.getIndex()==0) {
         return BreakIterator::DONE;
     }
 
     //  Set the initial state for the state machine
-    c = UTEXT_PREVIOUS32(&fText);
+    prevCategory = text.previous();
     state = START_STATE;
     row = (RBBIStateTableRow *)
             (stateTable->fTableData + (stateTable->fRowLen * state));
 
     // loop until we reach the start of the text or transition to state 0
     //
-    for (; c != U_SENTINEL; c = UTEXT_PREVIOUS32(&fText)) {
+    for (; prevCategory >= 0; prevCategory = text.previous()) {
 
-        // look up the current character's character category, which tells us
+        // The current character's character category tells us
         // which column in the state table to look at.
-        // Note:  the 16 in UTRIE_GET16 refers to the size of the data being returned,
-        //        not the size of the character going in, which is a UChar32.
-        //
         //  And off the dictionary flag bit. For reverse iteration it is not used.
-        category = UTRIE2_GET16(fData->fTrie, c);
+        category = (uint16_t)prevCategory;
         category &= ~0x4000;
 
         #ifdef RBBI_DEBUG
             if (gTrace) {
-                RBBIDebugPrintf("             %4d   ", (int32_t)utext_getNativeIndex(&fText));
-                if (0x20<=c && c<0x7f) {
-                    RBBIDebugPrintf("\"%c\"  ", c);
-                } else {
-                    RBBIDebugPrintf("%5x  ", c);
-                }
+                RBBIDebugPrintf("             %4d   ", text.getIndex());
                 RBBIDebugPrintf("%3d  %3d\n", state, category);
             }
         #endif
@@ -1009,7 +1109,7 @@ int32_t RuleBasedBreakIterator::handleSafePrevious(int32_t fromPosition) {
     }
 
     // The state machine is done.  Check whether it found a match...
-    result = (int32_t)UTEXT_GETNATIVEINDEX(&fText);
+    result = text.getIndex();
     #ifdef RBBI_DEBUG
         if (gTrace) {
             RBBIDebugPrintf("result = %d\n\n", result);
@@ -1059,6 +1159,84 @@ int32_t RuleBasedBreakIterator::getRuleStatusVec(
 }
 
 
+//-------------------------------------------------------------------------------
+//
+//   nextBoundaries()  Bulk forward iteration. Runs the state machine directly,
+//                     bypassing the BreakCache, which is reset to the final
+//                     position when done.
+//
+//-------------------------------------------------------------------------------
+int32_t RuleBasedBreakIterator::nextBoundaries(int32_t limit,
+                                               int32_t *boundaries, int32_t *ruleStatuses,
+                                               int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    int32_t pos = fBreakCache->current();
+    int32_t ruleStatusIdx = fRuleStatusIndex;
+    int32_t length = 0;
+    const int32_t *statusTable = fData->fRuleStatusTable;
+
+    // First take any remaining boundaries of a dictionary segment that the
+    // iteration position is in, then alternate between rule based boundaries
+    // and the subdivision of rule based segments that contain dictionary characters.
+    int32_t dictPos, dictStatusIdx;
+    UBool atLimit = FALSE;
+    for (;;) {
+        while (length < capacity && fDictionaryCache->following(pos, &dictPos, &dictStatusIdx)) {
+            if (dictPos > limit) {
+                atLimit = TRUE;
+                break;
+            }
+            boundaries[length] = pos = dictPos;
+            ruleStatusIdx = dictStatusIdx;
+            if (ruleStatuses != NULL) {
+                ruleStatuses[length] = statusTable[ruleStatusIdx + statusTable[ruleStatusIdx]];
+            }
+            ++length;
+        }
+        if (atLimit || length >= capacity || pos >= limit) {
+            break;
+        }
+
+        fPosition = pos;
+        int32_t nextPos = handleNext();
+        if (nextPos == UBRK_DONE) {
+            break;
+        }
+        if (fDictionaryCharCount > 0) {
+            fDictionaryCache->populateDictionary(pos, nextPos, ruleStatusIdx, fRuleStatusIndex);
+            if (fDictionaryCache->fStart == pos && pos < fDictionaryCache->fLimit) {
+                // The segment was subdivided. Take its boundaries at the top of the loop.
+                continue;
+            }
+        }
+        if (nextPos > limit) {
+            break;
+        }
+        boundaries[length] = pos = nextPos;
+        ruleStatusIdx = fRuleStatusIndex;
+        if (ruleStatuses != NULL) {
+            ruleStatuses[length] = statusTable[ruleStatusIdx + statusTable[ruleStatusIdx]];
+        }
+        ++length;
+    }
+
+    if (length > 0) {
+        fBreakCache->reset(pos, ruleStatusIdx);
+    }
+    fPosition = pos;
+    fRuleStatusIndex = ruleStatusIdx;
+    fDone = FALSE;
+    return length;
+}
+
+
 
 //-------------------------------------------------------------------------------
 //
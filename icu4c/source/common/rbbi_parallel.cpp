@@ -0,0 +1,301 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+
+// file: rbbi_parallel.cpp
+//
+// ChunkedSegmentation, segmentation of a long text in chunks
+// that can be processed on multiple threads.
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_BREAK_ITERATION
+
+#include "unicode/rbbi.h"
+#include "unicode/utext.h"
+
+#include "rbbi_cache.h"
+
+#include "cmemory.h"
+#include "rbbidata.h"
+#include "uvector.h"
+#include "uvectr32.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+// Texts are not divided into chunks shorter than this.
+constexpr int32_t kMinChunkLength = 0x4000;
+
+/**
+ * The boundaries of one chunk of text, from running the rules from the
+ * chunk start until reaching the start of the next chunk.
+ * Unless the chunk start is 0, the boundaries near the start need not match
+ * those of a serial iteration. They are used only after the first position
+ * from which the rules run for both the preceding chunk and this one.
+ */
+struct RBBIChunk : public UMemory {
+    RBBIChunk(RuleBasedBreakIterator *iter, int32_t chunkStart, UErrorCode &errorCode) :
+            bi(iter), start(chunkStart), limit(0),
+            boundaries(errorCode), statusIndexes(errorCode), resumePositions(errorCode),
+            segmented(FALSE), startIndex(0), limitIndex(0) {}
+
+    LocalPointer<RuleBasedBreakIterator> bi;
+    int32_t start;
+    int32_t limit;
+    UVector32 boundaries;
+    UVector32 statusIndexes;
+    UVector32 resumePositions;
+    UBool segmented;
+    // The range of boundaries that this chunk contributes to the result, set by join().
+    int32_t startIndex;
+    int32_t limitIndex;
+};
+
+U_CDECL_BEGIN
+static void U_CALLCONV
+deleteRBBIChunk(void *obj) {
+    delete static_cast<RBBIChunk *>(obj);
+}
+U_CDECL_END
+
+}  // namespace
+
+void RuleBasedBreakIterator::segmentForward(int32_t fromPosition, int32_t limit,
+                                            UVector32 &boundaries, UVector32 &statusIndexes,
+                                            UVector32 &resumePositions, UErrorCode &status) {
+    int32_t pos = fromPosition;
+    int32_t ruleStatusIdx = 0;
+    while (pos < limit && U_SUCCESS(status)) {
+        fPosition = pos;
+        int32_t nextPos = handleNext();
+        if (nextPos == UBRK_DONE) {
+            break;
+        }
+        if (fDictionaryCharCount > 0) {
+            fDictionaryCache->populateDictionary(pos, nextPos, ruleStatusIdx, fRuleStatusIndex);
+            if (fDictionaryCache->fStart == pos && pos < fDictionaryCache->fLimit) {
+                // As for next(), the rules continue from the last dictionary boundary,
+                // which may be beyond the end of the rule based segment.
+                const UVector32 &breaks = fDictionaryCache->fBreaks;
+                ruleStatusIdx = fDictionaryCache->fOtherRuleStatusIndex;
+                for (int32_t i = 1; i < breaks.size(); ++i) {
+                    boundaries.addElement(breaks.elementAti(i), status);
+                    statusIndexes.addElement(ruleStatusIdx, status);
+                }
+                pos = fDictionaryCache->fLimit;
+                resumePositions.addElement(pos, status);
+                continue;
+            }
+        }
+        ruleStatusIdx = fRuleStatusIndex;
+        boundaries.addElement(nextPos, status);
+        statusIndexes.addElement(ruleStatusIdx, status);
+        pos = nextPos;
+        resumePositions.addElement(pos, status);
+    }
+}
+
+ChunkedSegmentation::ChunkedSegmentation(const RuleBasedBreakIterator &bi, int32_t maxChunkCount,
+                                         UErrorCode &status) :
+        fChunks(NULL), fTextLength(0), fJoined(FALSE) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    LocalPointer<UVector> chunks(new UVector(deleteRBBIChunk, NULL, status), status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    fChunks = chunks.orphan();
+    fTextLength = (int32_t)utext_nativeLength(const_cast<UText *>(&bi.fText));
+
+    // Divide the text near equally spaced positions.
+    int32_t chunkCount = uprv_max(1, uprv_min(maxChunkCount, fTextLength / kMinChunkLength));
+    RBBIChunk *prev = NULL;
+    for (int32_t i = 0; i < chunkCount; ++i) {
+        LocalPointer<RuleBasedBreakIterator> clone(
+            static_cast<RuleBasedBreakIterator *>(bi.clone()), status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        int32_t start = 0;
+        if (i > 0) {
+            // Any code point boundary works as a chunk start.
+            // It may take a boundary or two to fall into step with the preceding chunk.
+            // (The safe reverse rules would find a start that is in step right away,
+            // but for line and sentence breaks they often back up to the start of the text.)
+            utext_setNativeIndex(&clone->fText, (int64_t)fTextLength * i / chunkCount);
+            start = (int32_t)utext_getNativeIndex(&clone->fText);
+            if (start <= prev->start) {
+                continue;
+            }
+            prev->limit = start;
+        }
+        LocalPointer<RBBIChunk> chunk(new RBBIChunk(clone.orphan(), start, status), status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        prev = chunk.getAlias();
+        fChunks->addElement(chunk.orphan(), status);
+        if (U_FAILURE(status)) {
+            delete prev;
+            return;
+        }
+    }
+    prev->limit = fTextLength;
+}
+
+ChunkedSegmentation::~ChunkedSegmentation() {
+    delete fChunks;
+}
+
+int32_t ChunkedSegmentation::getChunkCount() const {
+    return fChunks != NULL ? fChunks->size() : 0;
+}
+
+void ChunkedSegmentation::segmentChunk(int32_t chunkIndex, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return;
+    }
+    if (chunkIndex < 0 || chunkIndex >= getChunkCount()) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    RBBIChunk &chunk = *static_cast<RBBIChunk *>(fChunks->elementAt(chunkIndex));
+    if (chunk.segmented) {
+        return;
+    }
+    if (chunk.start == 0) {
+        // The boundary at the start of the text, as from first().
+        chunk.boundaries.addElement(0, status);
+        chunk.statusIndexes.addElement(0, status);
+    }
+    chunk.resumePositions.addElement(chunk.start, status);
+    chunk.bi->segmentForward(chunk.start, chunk.limit, chunk.boundaries,
+                             chunk.statusIndexes, chunk.resumePositions, status);
+    chunk.segmented = U_SUCCESS(status);
+}
+
+void ChunkedSegmentation::join(UErrorCode &status) {
+    // Each chunk contributes its boundaries from the first one after the position
+    // from which the rules run for both it and the preceding contributing chunk,
+    // up to and including that position for the next chunk.
+    RBBIChunk *prev = static_cast<RBBIChunk *>(fChunks->elementAt(0));
+    for (int32_t i = 1; i < fChunks->size() && U_SUCCESS(status); ++i) {
+        RBBIChunk &chunk = *static_cast<RBBIChunk *>(fChunks->elementAt(i));
+        UVector32 &prevResume = prev->resumePositions;
+        const UVector32 &chunkResume = chunk.resumePositions;
+
+        // Find the first common resume position, extending the preceding chunk as necessary.
+        int32_t pi = prevResume.size() - 1;
+        while (pi > 0 && prevResume.elementAti(pi - 1) >= chunk.start) {
+            --pi;
+        }
+        int32_t ci = 0;
+        UBool inStep = FALSE;
+        while (ci < chunkResume.size() && U_SUCCESS(status)) {
+            if (pi == prevResume.size()) {
+                int32_t from = prevResume.lastElementi();
+                if (from >= fTextLength) {
+                    break;
+                }
+                // One more rule based segment.
+                prev->bi->segmentForward(from, from + 1, prev->boundaries, prev->statusIndexes,
+                                         prevResume, status);
+                continue;
+            }
+            int32_t prevPos = prevResume.elementAti(pi);
+            int32_t chunkPos = chunkResume.elementAti(ci);
+            if (prevPos < chunkPos) {
+                ++pi;
+            } else if (chunkPos < prevPos) {
+                ++ci;
+            } else {
+                inStep = TRUE;
+                break;
+            }
+        }
+
+        if (inStep) {
+            int32_t pos = prevResume.elementAti(pi);
+            int32_t limitIndex = prev->boundaries.size();
+            while (limitIndex > prev->startIndex && prev->boundaries.elementAti(limitIndex - 1) > pos) {
+                --limitIndex;
+            }
+            prev->limitIndex = limitIndex;
+            int32_t startIndex = 0;
+            while (startIndex < chunk.boundaries.size() && chunk.boundaries.elementAti(startIndex) <= pos) {
+                ++startIndex;
+            }
+            chunk.startIndex = startIndex;
+            prev = &chunk;
+        } else if (prevResume.lastElementi() < chunk.limit) {
+            // The chunk does not fall into step. Segment its text serially instead.
+            prev->bi->segmentForward(prevResume.lastElementi(), chunk.limit, prev->boundaries,
+                                     prev->statusIndexes, prevResume, status);
+        }
+    }
+    prev->limitIndex = prev->boundaries.size();
+}
+
+int32_t ChunkedSegmentation::getBoundaries(int32_t *boundaries, int32_t *ruleStatuses,
+                                           int32_t capacity, UErrorCode &status) {
+    if (U_FAILURE(status)) {
+        return 0;
+    }
+    if (fChunks == NULL) {
+        status = U_INVALID_STATE_ERROR;
+        return 0;
+    }
+    if (capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (!fJoined) {
+        for (int32_t i = 0; i < fChunks->size(); ++i) {
+            if (!static_cast<RBBIChunk *>(fChunks->elementAt(i))->segmented) {
+                status = U_INVALID_STATE_ERROR;
+                return 0;
+            }
+        }
+        join(status);
+        if (U_FAILURE(status)) {
+            return 0;
+        }
+        fJoined = TRUE;
+    }
+
+    int32_t length = 0;
+    for (int32_t i = 0; i < fChunks->size(); ++i) {
+        const RBBIChunk &chunk = *static_cast<RBBIChunk *>(fChunks->elementAt(i));
+        length += chunk.limitIndex - chunk.startIndex;
+    }
+    if (length > capacity) {
+        status = U_BUFFER_OVERFLOW_ERROR;
+        return length;
+    }
+    int32_t *p = boundaries;
+    for (int32_t i = 0; i < fChunks->size(); ++i) {
+        const RBBIChunk &chunk = *static_cast<RBBIChunk *>(fChunks->elementAt(i));
+        int32_t chunkLength = chunk.limitIndex - chunk.startIndex;
+        if (chunkLength > 0) {
+            uprv_memcpy(p, chunk.boundaries.getBuffer() + chunk.startIndex,
+                        chunkLength * sizeof(int32_t));
+            if (ruleStatuses != NULL) {
+                const int32_t *statusTable = chunk.bi->fData->fRuleStatusTable;
+                const int32_t *statusIndexes = chunk.statusIndexes.getBuffer();
+                int32_t *q = ruleStatuses + (p - boundaries);
+                for (int32_t j = 0; j < chunkLength; ++j) {
+                    int32_t idx = statusIndexes[chunk.startIndex + j];
+                    q[j] = statusTable[idx + statusTable[idx]];
+                }
+            }
+            p += chunkLength;
+        }
+    }
+    return length;
+}
+
+U_NAMESPACE_END
+
+#endif // #if !UCONFIG_NO_BREAK_ITERATION
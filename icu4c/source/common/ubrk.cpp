@@ -353,5 +353,43 @@ ubrk_getBinaryRules(UBreakIterator *bi,
     return (int32_t)rulesLength;
 }
 
+U_CAPI int32_t U_EXPORT2
+ubrk_nextBoundaries(UBreakIterator *bi, int32_t limit,
+                    int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                    UErrorCode *status)
+{
+    if (U_FAILURE(*status)) {
+        return 0;
+    }
+    if (capacity < 0 || (boundaries == NULL && capacity > 0)) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    BreakIterator *brki = reinterpret_cast<BreakIterator *>(bi);
+    RuleBasedBreakIterator *rbbi = dynamic_cast<RuleBasedBreakIterator *>(brki);
+    if (rbbi != NULL) {
+        return rbbi->nextBoundaries(limit, boundaries, ruleStatuses, capacity, *status);
+    }
+    // Other BreakIterator subclasses: step through the boundaries one at a time,
+    // without moving past the last one that fits.
+    int32_t length = 0;
+    while (length < capacity) {
+        int32_t next = brki->next();
+        if (next == UBRK_DONE) {
+            break;
+        }
+        if (next > limit) {
+            brki->previous();
+            break;
+        }
+        boundaries[length] = next;
+        if (ruleStatuses != NULL) {
+            ruleStatuses[length] = brki->getRuleStatus();
+        }
+        ++length;
+    }
+    return length;
+}
+
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -2393,7 +2393,7 @@ ucnv_convertEx(UConverter *targetCnv, UConverter *sourceCnv,
 }
 
 /* internal implementation of ucnv_convert() etc. with preflighting */
-static int32_t
+U_CFUNC int32_t
 ucnv_internalConvert(UConverter *outConverter, UConverter *inConverter,
                      char *target, int32_t targetCapacity,
                      const char *source, int32_t sourceLength,
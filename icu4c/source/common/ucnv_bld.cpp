@@ -46,6 +46,11 @@
 #include "ucln_cmn.h"
 #include "ustr_cnv.h"
 
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#endif
 
 #if 0
 #include <stdio.h>
@@ -195,8 +200,44 @@ static struct {
 /*initializes some global variables */
 static UHashtable *SHARED_DATA_HASHTABLE = NULL;
 static icu::UMutex cnvCacheMutex;
-/*  Note:  the global mutex is used for      */
-/*         reference count updates.          */
+/*  Note:  the global mutex guards all changes to the cache.          */
+/*         Reference counts are updated atomically without it.         */
+
+static_assert(sizeof(icu::u_atomic_int32_t) == sizeof(int32_t),
+              "UConverterSharedData.referenceCounter has a different size in C code.");
+
+/*
+ * Index of the cached shared data, for lookups without cnvCacheMutex.
+ * An open-addressing table with linear probing, keyed by staticData->name
+ * like SHARED_DATA_HASHTABLE.
+ * New shared data is added into empty slots of the current index while it is
+ * at most half full. Otherwise, and when ucnv_flushCache() removes shared data,
+ * a new index is built and published.
+ * A replaced index (and shared data removed by ucnv_flushCache())
+ * is freed only after all lookups that might still see it have finished:
+ * Readers register in one of two counters selected by gCacheEpoch;
+ * the writer advances the epoch, and the previous counter must drain.
+ * A replaced index is kept as gRetiredIndex until the next time the epoch
+ * advances, by which time its readers have normally finished,
+ * so that the writer need not wait while it holds the mutex.
+ */
+typedef struct SharedDataIndex {
+    int32_t mask;                           /* capacity-1, capacity is a power of 2 */
+    int32_t count;                          /* number of non-NULL entries */
+    /* variable length, NULL for empty slots */
+    std::atomic<UConverterSharedData *> entries[1];
+} SharedDataIndex;
+
+static std::atomic<SharedDataIndex *> gSharedDataIndex(NULL);
+static icu::u_atomic_int32_t gCacheEpoch(0);
+static icu::u_atomic_int32_t gCacheReaders[2];   /* zero-initialized */
+/* The replaced index and the epoch of its readers, guarded by cnvCacheMutex. */
+static SharedDataIndex *gRetiredIndex = NULL;
+static int32_t gRetiredEpoch = 0;
+
+/* ucnv_getPoolStatistics(), see the converter pool for ucnv_acquire() below */
+static icu::u_atomic_int32_t gConverterPoolHits(0);
+static icu::u_atomic_int32_t gConverterPoolMisses(0);
 
 static const char **gAvailableConverters = NULL;
 static uint16_t gAvailableConverterCount = 0;
@@ -246,7 +287,15 @@ static UBool U_CALLCONV ucnv_cleanup(void) {
     if (SHARED_DATA_HASHTABLE != NULL && uhash_count(SHARED_DATA_HASHTABLE) == 0) {
         uhash_close(SHARED_DATA_HASHTABLE);
         SHARED_DATA_HASHTABLE = NULL;
+        /* an empty cache has no index */
+        U_ASSERT(gSharedDataIndex.load() == NULL);
     }
+    /* no lookups are running during cleanup */
+    uprv_free(gRetiredIndex);
+    gRetiredIndex = NULL;
+    /* ucnv_flushCache() closed the pooled converters */
+    gConverterPoolHits.store(0);
+    gConverterPoolMisses.store(0);
 
     /* Isn't called from flushCache because other threads may have preexisting references to the table. */
     ucnv_flushAvailableConverterCache();
@@ -314,7 +363,8 @@ ucnv_data_unFlattenClone(UConverterLoadArgs *pArgs, UDataMemory *pData, UErrorCo
     }
 
     /* copy initial values from the static structure for this type */
-    uprv_memcpy(data, converterData[type], sizeof(UConverterSharedData));
+    /* (the void * cast avoids a warning about copying the atomic referenceCounter) */
+    uprv_memcpy((void *)data, converterData[type], sizeof(UConverterSharedData));
 
     data->staticData = source;
 
@@ -426,6 +476,197 @@ getAlgorithmicTypeFromName(const char *realName)
 */
 #define UCNV_CACHE_LOAD_FACTOR 2
 
+/* Lock-free lookups in the shared data cache ------------------------------ */
+
+/* Registers a reader of gSharedDataIndex and returns the epoch for ucnv_leaveCacheReader(). */
+static int32_t
+ucnv_enterCacheReader() {
+    for (;;) {
+        int32_t epoch = gCacheEpoch.load();
+        icu::umtx_atomic_inc(&gCacheReaders[epoch & 1]);
+        if (gCacheEpoch.load() == epoch) {
+            return epoch;
+        }
+        /* a writer advanced the epoch in between, it may not wait for this counter */
+        icu::umtx_atomic_dec(&gCacheReaders[epoch & 1]);
+    }
+}
+
+static void
+ucnv_leaveCacheReader(int32_t epoch) {
+    icu::umtx_atomic_dec(&gCacheReaders[epoch & 1]);
+}
+
+/*
+ * Waits until the readers registered with the given epoch have finished.
+ * Readers never block while registered, so this is normally short,
+ * but a reader may have been preempted: Spin with a pause hint for a few rounds,
+ * then yield the processor to let it run.
+ */
+static void
+ucnv_drainCacheReaders(int32_t epoch) {
+    for (int32_t round = 0; gCacheReaders[epoch & 1].load() != 0; ++round) {
+        if (round < 16) {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__i386__) || defined(__x86_64__))
+            __builtin_ia32_pause();
+#elif defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+            _mm_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+/*
+ * Frees the retired index once its readers have finished.
+ * Must be called before the epoch advances again,
+ * so that each counter is drained before it is reused.
+ * Must be called with the cnvCacheMutex held.
+ */
+static void
+ucnv_freeRetiredSharedDataIndex() {
+    if (gRetiredIndex != NULL) {
+        ucnv_drainCacheReaders(gRetiredEpoch);
+        uprv_free(gRetiredIndex);
+        gRetiredIndex = NULL;
+    }
+}
+
+/*
+ * Waits until no reader can still see an index or shared data
+ * that was unpublished before this call.
+ * Must be called with the cnvCacheMutex held, which serializes the writers.
+ */
+static void
+ucnv_waitForCacheReaders() {
+    ucnv_freeRetiredSharedDataIndex();
+    int32_t epoch = gCacheEpoch.load();
+    gCacheEpoch.store(epoch + 1);
+    ucnv_drainCacheReaders(epoch);
+}
+
+/*
+ * Keeps an unpublished index until the readers that might still see it have finished,
+ * without waiting for them now.
+ * Must be called with the cnvCacheMutex held.
+ */
+static void
+ucnv_retireSharedDataIndex(SharedDataIndex *oldIndex) {
+    ucnv_freeRetiredSharedDataIndex();
+    int32_t epoch = gCacheEpoch.load();
+    gCacheEpoch.store(epoch + 1);
+    gRetiredIndex = oldIndex;
+    gRetiredEpoch = epoch;
+}
+
+/*
+ * Adds one reference to cached shared data unless ucnv_flushCache() is unloading it.
+ * @return TRUE if the reference was added
+ */
+static UBool
+ucnv_acquireSharedData(UConverterSharedData *sharedData) {
+    int32_t count = sharedData->referenceCounter.load();
+    do {
+        if (count < 0) {
+            return FALSE;
+        }
+    } while (!sharedData->referenceCounter.compare_exchange_weak(count, count + 1));
+    return TRUE;
+}
+
+/*
+ * Adds shared data to an index that has an empty slot for it.
+ * Lookups that run concurrently either find it or fall back to the hashtable.
+ */
+static void
+ucnv_addToSharedDataIndex(SharedDataIndex *index, UConverterSharedData *data, int32_t hashcode) {
+    int32_t i = hashcode & index->mask;
+    while (index->entries[i].load(std::memory_order_relaxed) != NULL) {
+        i = (i + 1) & index->mask;
+    }
+    index->entries[i].store(data, std::memory_order_release);
+    ++index->count;
+}
+
+/*
+ * Rebuilds the lock-free index from SHARED_DATA_HASHTABLE,
+ * skipping shared data that is being unloaded, and retires the previous index.
+ * The new index is at most one quarter full, so that following additions
+ * rarely need another rebuild.
+ * Must be called with the cnvCacheMutex held.
+ * If the new index cannot be allocated, then lookups just fall back to
+ * the mutex-protected hashtable.
+ */
+static void
+ucnv_publishSharedDataIndex() {
+    SharedDataIndex *index = NULL;
+    int32_t count = 0;
+    int32_t pos = UHASH_FIRST;
+    const UHashElement *e;
+    if (SHARED_DATA_HASHTABLE != NULL) {
+        while ((e = uhash_nextElement(SHARED_DATA_HASHTABLE, &pos)) != NULL) {
+            if (((UConverterSharedData *)e->value.pointer)->referenceCounter.load() >= 0) {
+                ++count;
+            }
+        }
+    }
+    if (count > 0) {
+        int32_t capacity = 16;
+        while (capacity < 4 * count) {
+            capacity <<= 1;
+        }
+        index = (SharedDataIndex *)uprv_malloc(
+            sizeof(SharedDataIndex) + (capacity - 1) * sizeof(std::atomic<UConverterSharedData *>));
+        if (index != NULL) {
+            index->mask = capacity - 1;
+            index->count = 0;
+            for (int32_t i = 0; i < capacity; ++i) {
+                index->entries[i].store(NULL, std::memory_order_relaxed);
+            }
+            pos = UHASH_FIRST;
+            while ((e = uhash_nextElement(SHARED_DATA_HASHTABLE, &pos)) != NULL) {
+                UConverterSharedData *data = (UConverterSharedData *)e->value.pointer;
+                if (data->referenceCounter.load() >= 0) {
+                    ucnv_addToSharedDataIndex(index, data, e->hashcode);
+                }
+            }
+        }
+    }
+    SharedDataIndex *oldIndex = gSharedDataIndex.exchange(index);
+    if (oldIndex != NULL) {
+        ucnv_retireSharedDataIndex(oldIndex);
+    }
+}
+
+/*
+ * Looks up a converter name in the lock-free index and adds a reference.
+ * @return the shared data, or NULL if it is not in the index
+ */
+static UConverterSharedData *
+ucnv_getCachedSharedData(const char *name) {
+    UConverterSharedData *found = NULL;
+    int32_t epoch = ucnv_enterCacheReader();
+    const SharedDataIndex *index = gSharedDataIndex.load(std::memory_order_acquire);
+    if (index != NULL) {
+        UHashTok key;
+        key.pointer = (void *)name;
+        int32_t i = uhash_hashChars(key) & index->mask;
+        UConverterSharedData *data;
+        while ((data = index->entries[i].load(std::memory_order_acquire)) != NULL) {
+            if (uprv_strcmp(data->staticData->name, name) == 0) {
+                if (ucnv_acquireSharedData(data)) {
+                    found = data;
+                }
+                break;
+            }
+            i = (i + 1) & index->mask;
+        }
+    }
+    ucnv_leaveCacheReader(epoch);
+    return found;
+}
+
 /* Puts the shared data in the static hashtable SHARED_DATA_HASHTABLE */
 /*   Will always be called with the cnvCacheMutex alrady being held   */
 /*     by the calling function.                                       */
@@ -471,6 +712,17 @@ ucnv_shareConverterData(UConverterSharedData * data)
             &err);
     UCNV_DEBUG_LOG("put", data->staticData->name,data);
 
+    /* make it visible to lookups without the mutex */
+    if (U_SUCCESS(err)) {
+        SharedDataIndex *index = gSharedDataIndex.load(std::memory_order_relaxed);
+        if (index != NULL && 2 * (index->count + 1) <= index->mask + 1) {
+            UHashTok key;
+            key.pointer = (void *)data->staticData->name;
+            ucnv_addToSharedDataIndex(index, data, uhash_hashChars(key));
+        } else {
+            ucnv_publishSharedDataIndex();
+        }
+    }
 }
 
 /*  Look up a converter name in the shared data cache.                    */
@@ -571,7 +823,8 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
     {
         /* The data for this converter was already in the cache.            */
         /* Update the reference counter on the shared data: one more client */
-        mySharedConverterData->referenceCounter++;
+        /* (It cannot be in the middle of being unloaded while we hold the mutex.) */
+        ucnv_acquireSharedData(mySharedConverterData);
     }
 
     return mySharedConverterData;
@@ -579,17 +832,23 @@ ucnv_load(UConverterLoadArgs *pArgs, UErrorCode *err) {
 
 /**
  * Unload a non-algorithmic converter.
- * It must be sharedData->isReferenceCounted
- * and this function must be called inside umtx_lock(&cnvCacheMutex).
+ * It must be sharedData->isReferenceCounted.
+ * The cnvCacheMutex is not needed: Cached data is only released here,
+ * and uncached data is not visible to other clients.
  */
 U_CAPI void
 ucnv_unload(UConverterSharedData *sharedData) {
     if(sharedData != NULL) {
-        if (sharedData->referenceCounter > 0) {
-            sharedData->referenceCounter--;
-        }
+        /*
+         * Read this before releasing our reference:
+         * Once the counter is 0, ucnv_flushCache() may delete cached data at any time.
+         */
+        UBool isCached = sharedData->sharedDataCached;
+        int32_t count = sharedData->referenceCounter.load();
+        while (count > 0 &&
+                !sharedData->referenceCounter.compare_exchange_weak(count, count - 1)) {}
 
-        if((sharedData->referenceCounter <= 0)&&(sharedData->sharedDataCached == FALSE)) {
+        if(count <= 1 && !isCached) {
             ucnv_deleteSharedConverterData(sharedData);
         }
     }
@@ -599,9 +858,7 @@ U_CFUNC void
 ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData)
 {
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
         ucnv_unload(sharedData);
-        umtx_unlock(&cnvCacheMutex);
     }
 }
 
@@ -609,9 +866,8 @@ U_CFUNC void
 ucnv_incrementRefCount(UConverterSharedData *sharedData)
 {
     if(sharedData != NULL && sharedData->isReferenceCounted) {
-        umtx_lock(&cnvCacheMutex);
-        sharedData->referenceCounter++;
-        umtx_unlock(&cnvCacheMutex);
+        /* the caller already holds a reference, so this cannot race with unloading */
+        icu::umtx_atomic_inc(&sharedData->referenceCounter);
     }
 }
 
@@ -805,16 +1061,20 @@ ucnv_loadSharedData(const char *converterName,
     if (mySharedConverterData == NULL)
     {
         /* it is a data-based converter, get its shared data.               */
-        /* Hold the cnvCacheMutex through the whole process of checking the */
-        /*   converter data cache, and adding new entries to the cache      */
-        /*   to prevent other threads from modifying the cache during the   */
-        /*   process.                                                       */
+        /* Already-loaded data is found without locking.                    */
+        /* Otherwise, hold the cnvCacheMutex through the whole process of   */
+        /*   checking the converter data cache, and adding new entries to   */
+        /*   the cache to prevent other threads from modifying the cache    */
+        /*   during the process.                                            */
         pArgs->nestedLoads=1;
         pArgs->pkg=NULL;
 
-        umtx_lock(&cnvCacheMutex);
-        mySharedConverterData = ucnv_load(pArgs, err);
-        umtx_unlock(&cnvCacheMutex);
+        mySharedConverterData = ucnv_getCachedSharedData(pArgs->name);
+        if (mySharedConverterData == NULL) {
+            umtx_lock(&cnvCacheMutex);
+            mySharedConverterData = ucnv_load(pArgs, err);
+            umtx_unlock(&cnvCacheMutex);
+        }
         if (U_FAILURE (*err) || (mySharedConverterData == NULL))
         {
             return NULL;
@@ -1025,6 +1285,173 @@ ucnv_createConverterFromSharedData(UConverter *myUConverter,
     return myUConverter;
 }
 
+/* Converter pool for ucnv_acquire()/ucnv_release() ------------------------ */
+
+/*
+ * Lock-free pool of released converters: Each slot holds one converter or NULL,
+ * and a thread owns a converter once it has swapped it out of its slot.
+ * gConverterPoolKeys[i] is the shared data of the converter last put into slot i;
+ * it is only a hint that lets ucnv_acquire() skip other converters
+ * without dereferencing them (they may be taken and closed concurrently).
+ * Converters are put near a slot derived from their shared data
+ * so that lookups usually succeed after a few probes.
+ */
+#define UCNV_POOL_CAPACITY 64
+
+static std::atomic<UConverter *> gConverterPool[UCNV_POOL_CAPACITY];
+static std::atomic<const UConverterSharedData *> gConverterPoolKeys[UCNV_POOL_CAPACITY];
+
+/* Only these option bits are set from converter names; open functions may add others. */
+#define UCNV_POOL_OPTIONS_MASK (UCNV_OPTION_VERSION|UCNV_OPTION_SWAP_LFNL)
+
+static UBool
+ucnv_isPoolable(const UConverterSharedData *sharedData) {
+    /*
+     * ISO-2022, LMBCS and SCSU converters are also initialized from the locale,
+     * which is not part of the pool key.
+     * Converters loaded from a package are not cached and would never be found again.
+     */
+    UConverterType type = (UConverterType)sharedData->staticData->conversionType;
+    return
+        type != UCNV_ISO_2022 && type != UCNV_SCSU &&
+        !(UCNV_LMBCS_1 <= type && type <= UCNV_LMBCS_LAST) &&
+        (!sharedData->isReferenceCounted || sharedData->sharedDataCached);
+}
+
+static inline int32_t
+ucnv_poolStartIndex(const UConverterSharedData *sharedData) {
+    return (int32_t)(((uintptr_t)sharedData / sizeof(UConverterSharedData)) % UCNV_POOL_CAPACITY);
+}
+
+/* Puts the converter into an empty slot. @return FALSE if the pool is full */
+static UBool
+ucnv_putIntoPool(UConverter *cnv) {
+    int32_t start = ucnv_poolStartIndex(cnv->sharedData);
+    for (int32_t n = 0; n < UCNV_POOL_CAPACITY; ++n) {
+        int32_t i = (start + n) % UCNV_POOL_CAPACITY;
+        UConverter *empty = NULL;
+        if (gConverterPool[i].load(std::memory_order_relaxed) == NULL) {
+            gConverterPoolKeys[i].store(cnv->sharedData, std::memory_order_relaxed);
+            if (gConverterPool[i].compare_exchange_strong(empty, cnv)) {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/* Takes a converter with the given shared data and options out of the pool, or returns NULL. */
+static UConverter *
+ucnv_takeFromPool(const UConverterSharedData *sharedData, uint32_t options) {
+    int32_t start = ucnv_poolStartIndex(sharedData);
+    for (int32_t n = 0; n < UCNV_POOL_CAPACITY; ++n) {
+        int32_t i = (start + n) % UCNV_POOL_CAPACITY;
+        if (gConverterPoolKeys[i].load(std::memory_order_relaxed) == sharedData &&
+                gConverterPool[i].load(std::memory_order_relaxed) != NULL) {
+            UConverter *cnv = gConverterPool[i].exchange(NULL);
+            if (cnv != NULL) {
+                if (cnv->sharedData == sharedData &&
+                        (cnv->options & UCNV_POOL_OPTIONS_MASK) == (options & UCNV_POOL_OPTIONS_MASK)) {
+                    return cnv;
+                }
+                /* the key was stale, or the options differ */
+                if (!ucnv_putIntoPool(cnv)) {
+                    ucnv_close(cnv);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Closes all pooled converters. @return the number of closed converters */
+static int32_t
+ucnv_drainPool() {
+    int32_t count = 0;
+    for (int32_t i = 0; i < UCNV_POOL_CAPACITY; ++i) {
+        UConverter *cnv = gConverterPool[i].exchange(NULL);
+        if (cnv != NULL) {
+            ucnv_close(cnv);
+            ++count;
+        }
+    }
+    return count;
+}
+
+U_CAPI UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err)
+{
+    UConverterNamePieces stackPieces;
+    UConverterLoadArgs stackArgs=UCNV_LOAD_ARGS_INITIALIZER;
+    UConverterSharedData *mySharedConverterData;
+    UConverter *cnv;
+
+    if(err == NULL || U_FAILURE(*err)) {
+        return NULL;
+    }
+
+    /* resolve the name and get a reference to the shared data, like ucnv_open() */
+    mySharedConverterData = ucnv_loadSharedData(converterName, &stackPieces, &stackArgs, err);
+    if(U_FAILURE(*err) || mySharedConverterData == NULL) {
+        return NULL;
+    }
+
+    if(stackArgs.locale[0] == 0 && ucnv_isPoolable(mySharedConverterData)) {
+        cnv = ucnv_takeFromPool(mySharedConverterData, stackArgs.options);
+        if(cnv != NULL) {
+            /* the pooled converter already holds a reference */
+            ucnv_unloadSharedDataIfReady(mySharedConverterData);
+            icu::umtx_atomic_inc(&gConverterPoolHits);
+            return cnv;
+        }
+    }
+
+    icu::umtx_atomic_inc(&gConverterPoolMisses);
+    return ucnv_createConverterFromSharedData(NULL, mySharedConverterData, &stackArgs, err);
+}
+
+U_CAPI void U_EXPORT2
+ucnv_release(UConverter *converter)
+{
+    if(converter == NULL) {
+        return;
+    }
+    if(converter->isCopyLocal || !ucnv_isPoolable(converter->sharedData)) {
+        ucnv_close(converter);
+        return;
+    }
+
+    /* reset the state while the caller's callbacks are still set, then restore the defaults */
+    ucnv_reset(converter);
+    const UConverterStaticData *staticData = converter->sharedData->staticData;
+    converter->fromCharErrorBehaviour = UCNV_TO_U_DEFAULT_CALLBACK;
+    converter->fromUCharErrorBehaviour = UCNV_FROM_U_DEFAULT_CALLBACK;
+    converter->toUContext = NULL;
+    converter->fromUContext = NULL;
+    converter->useFallback = FALSE;
+    converter->subChar1 = staticData->subChar1;
+    converter->subCharLen = staticData->subCharLen;
+    /* subChars may point to a buffer allocated by ucnv_setSubstString(); keep it */
+    uprv_memcpy(converter->subChars, staticData->subChar, converter->subCharLen);
+
+    /* An algorithmic converter's shared data does not register the cleanup. */
+    ucnv_enableCleanup();
+    if(!ucnv_putIntoPool(converter)) {
+        ucnv_close(converter);
+    }
+}
+
+U_CAPI void U_EXPORT2
+ucnv_getPoolStatistics(int32_t *pHits, int32_t *pMisses)
+{
+    if(pHits != NULL) {
+        *pHits = gConverterPoolHits.load();
+    }
+    if(pMisses != NULL) {
+        *pMisses = gConverterPoolMisses.load();
+    }
+}
+
 /*Frees all shared immutable objects that aren't referred to (reference count = 0)
  */
 U_CAPI int32_t U_EXPORT2
@@ -1039,6 +1466,9 @@ ucnv_flushCache ()
 
     UTRACE_ENTRY_OC(UTRACE_UCNV_FLUSH_CACHE);
 
+    /* Pooled converters are unused but hold references to their shared data. */
+    ucnv_drainPool();
+
     /* Close the default converter without creating a new one so that everything will be flushed. */
     u_flushDefaultConverter();
 
@@ -1054,12 +1484,14 @@ ucnv_flushCache ()
     * table
     *
     * Synchronization:  holding cnvCacheMutex will prevent any other thread from
-    *                   accessing or modifying the hash table during the iteration.
-    *                   The reference count of an entry may be decremented by
-    *                   ucnv_close while the iteration is in process, but this is
-    *                   benign.  It can't be incremented (in ucnv_createConverter())
-    *                   because the sequence of looking up in the cache + incrementing
-    *                   is protected by cnvCacheMutex.
+    *                   modifying the hash table during the iteration.
+    *                   The reference count of an entry may be changed concurrently
+    *                   by ucnv_close and by lookups without the mutex.
+    *                   Therefore, an unused entry is first marked as being unloaded
+    *                   by atomically setting its counter from 0 to -1,
+    *                   which prevents new references, and removed from the
+    *                   lock-free index. It is deleted only after all lookups
+    *                   that might have seen it in the old index have finished.
     */
     umtx_lock(&cnvCacheMutex);
     /*
@@ -1070,23 +1502,38 @@ ucnv_flushCache ()
      */
     i = 0;
     do {
+        int32_t unloading = 0;
         remaining = 0;
         pos = UHASH_FIRST;
         while ((e = uhash_nextElement (SHARED_DATA_HASHTABLE, &pos)) != NULL)
         {
             mySharedData = (UConverterSharedData *) e->value.pointer;
             /*deletes only if reference counter == 0 */
-            if (mySharedData->referenceCounter == 0)
+            int32_t count = 0;
+            if (mySharedData->referenceCounter.compare_exchange_strong(count, -1)) {
+                ++unloading;
+            } else {
+                ++remaining;
+            }
+        }
+        if (unloading > 0) {
+            ucnv_publishSharedDataIndex();
+            ucnv_waitForCacheReaders();
+            pos = UHASH_FIRST;
+            while ((e = uhash_nextElement (SHARED_DATA_HASHTABLE, &pos)) != NULL)
             {
-                tableDeletedNum++;
+                mySharedData = (UConverterSharedData *) e->value.pointer;
+                if (mySharedData->referenceCounter.load() < 0)
+                {
+                    tableDeletedNum++;
 
-                UCNV_DEBUG_LOG("del",mySharedData->staticData->name,mySharedData);
+                    UCNV_DEBUG_LOG("del",mySharedData->staticData->name,mySharedData);
 
-                uhash_removeElement(SHARED_DATA_HASHTABLE, e);
-                mySharedData->sharedDataCached = FALSE;
-                ucnv_deleteSharedConverterData (mySharedData);
-            } else {
-                ++remaining;
+                    uhash_removeElement(SHARED_DATA_HASHTABLE, e);
+                    mySharedData->sharedDataCached = FALSE;
+                    mySharedData->referenceCounter.store(0);
+                    ucnv_deleteSharedConverterData (mySharedData);
+                }
             }
         }
     } while(++i == 1 && remaining > 0);
@@ -31,6 +31,10 @@
 #include "ucnv_ext.h"
 #include "udataswp.h"
 
+#ifdef __cplusplus
+#include "umutex.h"
+#endif
+
 /* size of the overflow buffers in UConverter, enough for escaping callbacks */
 #define UCNV_ERROR_BUFFER_LENGTH 32
 
@@ -95,7 +99,17 @@ typedef struct UConverterStaticData {   /* +offset: size */
  */
 struct UConverterSharedData {
     uint32_t structSize;            /* Size of this structure */
-    uint32_t referenceCounter;      /* used to count number of clients, unused for static/immutable SharedData */
+#ifdef __cplusplus
+    /*
+     * Number of clients, unused for static/immutable SharedData.
+     * Updated atomically so that ucnv_open() of cached data, ucnv_clone() and ucnv_close()
+     * do not need the converter cache mutex.
+     * Negative while ucnv_flushCache() is unloading the cached data.
+     */
+    icu::u_atomic_int32_t referenceCounter;
+#else
+    int32_t referenceCounter;       /* same size as u_atomic_int32_t, for C code that uses sizeof */
+#endif
 
     const void *dataMemory;         /* from udata_openChoice() - for cleanup */
 
@@ -127,7 +141,7 @@ struct UConverterSharedData {
 /** UConverterSharedData initializer for static, non-reference-counted converters. */
 #define UCNV_IMMUTABLE_SHARED_DATA_INITIALIZER(pStaticData, pImpl) \
     { \
-        sizeof(UConverterSharedData), ~((uint32_t)0), \
+        sizeof(UConverterSharedData), { -1 }, \
         NULL, pStaticData, FALSE, FALSE, pImpl, \
         0, UCNV_MBCS_TABLE_INITIALIZER \
     }
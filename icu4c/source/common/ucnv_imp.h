@@ -127,6 +127,19 @@ ucnv_unloadSharedDataIfReady(UConverterSharedData *sharedData);
 U_CFUNC void
 ucnv_incrementRefCount(UConverterSharedData *sharedData);
 
+/*
+ * Converts a complete string from inConverter's charset to outConverter's charset
+ * with ucnv_convertEx(), flushing at the end, with preflighting and NUL-termination
+ * like ucnv_convert(). Does not reset the converters.
+ * Used by ucnv_convert(), ucnv_convertParallel() etc.
+ * @internal
+ */
+U_CFUNC int32_t
+ucnv_internalConvert(UConverter *outConverter, UConverter *inConverter,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     UErrorCode *pErrorCode);
+
 /**
  * These are the default error handling callbacks for the charset conversion framework.
  * For performance reasons, they are only called to handle an error (not normally called for a reset or close).
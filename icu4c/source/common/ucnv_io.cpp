@@ -115,6 +115,14 @@
  * and all strings lowercased. In the future, the options in section 7 may state
  * other types of normalization.
  *
+ * 10) Starting with formatVersion 3.1, when section 9 is present, this is a hash
+ * table for looking up normalized aliases in O(length) instead of a binary
+ * search with one string comparison per step. Its length is a power of 2.
+ * It uses open addressing with linear probing, starting at
+ * ucnv_io_hashNormalizedName(normalized alias) modulo the length.
+ * Each entry is 1 + an index into sections 3 and 4, or 0 for an empty slot.
+ * See ucnv_io_fillAliasHashTable().
+ *
  * Here is the concept of section 5 and 6. It's a 3D cube. Each tag
  * has a unique alias among all converters. That same alias can
  * be mentioned in other standards on different converters,
@@ -188,6 +196,7 @@ enum {
     tableOptionsIndex=7,
     stringTableIndex=8,
     normalizedStringTableIndex=9,
+    aliasHashTableIndex=10,
     offsetsCount,    /* length of the swapper's temporary offsets[] */
     minTocLength=8 /* min. tocLength in the file, does not count the tocLengthIndex! */
 };
@@ -267,6 +276,9 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     if (tableStart > 8) {
         gMainTable.normalizedStringTableSize = sectionSizes[9];
     }
+    if (tableStart > 9) {
+        gMainTable.aliasHashTableSize = sectionSizes[10];
+    }
 
     currOffset = tableStart * (sizeof(uint32_t)/sizeof(uint16_t)) + (sizeof(uint32_t)/sizeof(uint16_t));
     gMainTable.converterList = table + currOffset;
@@ -306,6 +318,18 @@ static void U_CALLCONV initAliasData(UErrorCode &errCode) {
     currOffset += gMainTable.stringTableSize;
     gMainTable.normalizedStringTable = ((gMainTable.optionTable->stringNormalizationType == UCNV_IO_UNNORMALIZED)
         ? gMainTable.stringTable : (table + currOffset));
+
+    currOffset += gMainTable.normalizedStringTableSize;
+    if (gMainTable.optionTable->stringNormalizationType == UCNV_IO_STD_NORMALIZED
+        && gMainTable.aliasHashTableSize > gMainTable.untaggedConvArraySize
+        && (gMainTable.aliasHashTableSize & (gMainTable.aliasHashTableSize - 1)) == 0)
+    {
+        gMainTable.aliasHashTable = table + currOffset;
+    }
+    else {
+        /* Older data, or the hash table is not usable. Use the binary search. */
+        gMainTable.aliasHashTableSize = 0;
+    }
 }
 
 
@@ -544,6 +568,39 @@ ucnv_compareNames(const char *name1, const char *name2) {
     }
 }
 
+U_CAPI void U_EXPORT2
+ucnv_io_fillAliasHashTable(uint16_t *hashTable, uint32_t capacity,
+                           const uint16_t *aliasList, uint32_t aliasCount,
+                           const char *normalizedStrings) {
+    uint32_t i, slot;
+    uprv_memset(hashTable, 0, (size_t)capacity * 2);
+    for (i = 0; i < aliasCount; ++i) {
+        slot = ucnv_io_hashNormalizedName(normalizedStrings + 2 * aliasList[i]) & (capacity - 1);
+        while (hashTable[slot] != 0) {
+            slot = (slot + 1) & (capacity - 1);
+        }
+        hashTable[slot] = (uint16_t)(i + 1);
+    }
+}
+
+/*
+ * Look up a normalized alias in the hash table.
+ * return the index into gMainTable.aliasList, or UINT32_MAX if not found
+ */
+static inline uint32_t
+findAliasInHashTable(const char *strippedName) {
+    uint32_t mask = gMainTable.aliasHashTableSize - 1;
+    uint32_t slot = ucnv_io_hashNormalizedName(strippedName) & mask;
+    uint32_t entry;
+    while ((entry = gMainTable.aliasHashTable[slot]) != 0) {
+        if (uprv_strcmp(strippedName, GET_NORMALIZED_STRING(gMainTable.aliasList[entry - 1])) == 0) {
+            return entry - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return UINT32_MAX;
+}
+
 /*
  * search for an alias
  * return the converter number index for gConverterList
@@ -567,50 +624,58 @@ findConverter(const char *alias, UBool *containsOption, UErrorCode *pErrorCode)
         alias = strippedName;
     }
 
-    /* do a binary search for the alias */
-    start = 0;
-    limit = gMainTable.untaggedConvArraySize;
-    mid = limit;
-    lastMid = UINT32_MAX;
-
-    for (;;) {
-        mid = (uint32_t)((start + limit) / 2);
-        if (lastMid == mid) {   /* Have we moved? */
-            break;  /* We haven't moved, and it wasn't found. */
-        }
-        lastMid = mid;
-        if (isUnnormalized) {
-            result = ucnv_compareNames(alias, GET_STRING(gMainTable.aliasList[mid]));
-        }
-        else {
-            result = uprv_strcmp(alias, GET_NORMALIZED_STRING(gMainTable.aliasList[mid]));
+    if (gMainTable.aliasHashTableSize > 0) {
+        /* the hash table is only used with normalized strings */
+        mid = findAliasInHashTable(alias);
+        if (mid == UINT32_MAX) {
+            return UINT32_MAX;
         }
-
-        if (result < 0) {
-            limit = mid;
-        } else if (result > 0) {
-            start = mid;
-        } else {
-            /* Since the gencnval tool folds duplicates into one entry,
-             * this alias in gAliasList is unique, but different standards
-             * may map an alias to different converters.
-             */
-            if (gMainTable.untaggedConvArray[mid] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
-                *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
+    } else {
+        /* do a binary search for the alias */
+        start = 0;
+        limit = gMainTable.untaggedConvArraySize;
+        mid = limit;
+        lastMid = UINT32_MAX;
+
+        for (;;) {
+            mid = (uint32_t)((start + limit) / 2);
+            if (lastMid == mid) {   /* Have we moved? */
+                return UINT32_MAX;  /* We haven't moved, and it wasn't found. */
+            }
+            lastMid = mid;
+            if (isUnnormalized) {
+                result = ucnv_compareNames(alias, GET_STRING(gMainTable.aliasList[mid]));
             }
-            /* State whether the canonical converter name contains an option.
-            This information is contained in this list in order to maintain backward & forward compatibility. */
-            if (containsOption) {
-                UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
-                *containsOption = (UBool)((containsCnvOptionInfo
-                    && ((gMainTable.untaggedConvArray[mid] & UCNV_CONTAINS_OPTION_BIT) != 0))
-                    || !containsCnvOptionInfo);
+            else {
+                result = uprv_strcmp(alias, GET_NORMALIZED_STRING(gMainTable.aliasList[mid]));
+            }
+
+            if (result < 0) {
+                limit = mid;
+            } else if (result > 0) {
+                start = mid;
+            } else {
+                break;
             }
-            return gMainTable.untaggedConvArray[mid] & UCNV_CONVERTER_INDEX_MASK;
         }
     }
 
-    return UINT32_MAX;
+    /* Since the gencnval tool folds duplicates into one entry,
+     * this alias in gAliasList is unique, but different standards
+     * may map an alias to different converters.
+     */
+    if (gMainTable.untaggedConvArray[mid] & UCNV_AMBIGUOUS_ALIAS_MAP_BIT) {
+        *pErrorCode = U_AMBIGUOUS_ALIAS_WARNING;
+    }
+    /* State whether the canonical converter name contains an option.
+    This information is contained in this list in order to maintain backward & forward compatibility. */
+    if (containsOption) {
+        UBool containsCnvOptionInfo = (UBool)gMainTable.optionTable->containsCnvOptionInfo;
+        *containsOption = (UBool)((containsCnvOptionInfo
+            && ((gMainTable.untaggedConvArray[mid] & UCNV_CONTAINS_OPTION_BIT) != 0))
+            || !containsCnvOptionInfo);
+    }
+    return gMainTable.untaggedConvArray[mid] & UCNV_CONVERTER_INDEX_MASK;
 }
 
 /*
@@ -1240,6 +1305,18 @@ ucnv_swapAliases(const UDataSwapper *ds,
                             2*(int32_t)(offsets[stringTableIndex]-offsets[converterListIndex]),
                             outTable+offsets[converterListIndex],
                             pErrorCode);
+            /*
+             * the alias hash table slots hold alias list indexes + 1 which just need
+             * 16-bit swapping; the slot positions depend only on the charset family,
+             * so the table is recomputed only in the else branch, when that changes
+             */
+            if(tocLength>=aliasHashTableIndex) {
+                ds->swapArray16(ds,
+                                inTable+offsets[aliasHashTableIndex],
+                                2*(int32_t)toc[aliasHashTableIndex],
+                                outTable+offsets[aliasHashTableIndex],
+                                pErrorCode);
+            }
         } else {
             /* allocate the temporary table for sorting */
             count=toc[aliasListIndex];
@@ -1320,6 +1397,33 @@ ucnv_swapAliases(const UDataSwapper *ds,
                 }
             }
 
+            /*
+             * The alias hash table hashes the bytes of the normalized strings,
+             * so it must be rebuilt from the outCharset strings in the new alias order.
+             */
+            if(U_SUCCESS(*pErrorCode) && tocLength>=aliasHashTableIndex && toc[aliasHashTableIndex]>0) {
+                uint32_t capacity=toc[aliasHashTableIndex];
+                uint16_t *hashTable=(uint16_t *)uprv_malloc(2*(size_t)capacity);
+                if(hashTable==NULL) {
+                    udata_printError(ds, "ucnv_swapAliases(): unable to allocate memory for the alias hash table (length: %u)\n",
+                                     capacity);
+                    *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+                } else {
+                    /* reuse the resort array for the platform-endian string indexes */
+                    uint16_t *r=tempTable.resort;
+                    for(i=0; i<count; ++i) {
+                        r[i]=tempTable.rows[i].strIndex;
+                    }
+                    ucnv_io_fillAliasHashTable(hashTable, capacity, r, count,
+                                               (const char *)(outTable+offsets[normalizedStringTableIndex]));
+                    q=outTable+offsets[aliasHashTableIndex];
+                    for(i=0; i<capacity; ++i) {
+                        ds->writeUInt16(q+i, hashTable[i]);
+                    }
+                    uprv_free(hashTable);
+                }
+            }
+
             if(tempTable.rows!=rows) {
                 uprv_free(tempTable.rows);
             }
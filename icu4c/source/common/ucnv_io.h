@@ -48,6 +48,7 @@ typedef struct UConverterAlias {
     const UConverterAliasOptions *optionTable;
     const uint16_t *stringTable;
     const uint16_t *normalizedStringTable;
+    const uint16_t *aliasHashTable;
 
     uint32_t converterListSize;
     uint32_t tagListSize;
@@ -58,8 +59,45 @@ typedef struct UConverterAlias {
     uint32_t optionTableSize;
     uint32_t stringTableSize;
     uint32_t normalizedStringTableSize;
+    uint32_t aliasHashTableSize;
 } UConverterAlias;
 
+/**
+ * Hash function for the alias hash table in cnvalias.icu (formatVersion 3.1 and up):
+ * 32-bit FNV-1a over the bytes of a normalized alias name,
+ * as returned by ucnv_io_stripForCompare().
+ * It is charset-family-specific; the data swapper rebuilds the table when
+ * it changes the charset family.
+ * @internal
+ */
+static inline uint32_t
+ucnv_io_hashNormalizedName(const char *name) {
+    uint32_t hash = 0x811c9dc5;
+    uint8_t c;
+    while ((c = (uint8_t)*name++) != 0) {
+        hash = (hash ^ c) * 0x01000193;
+    }
+    return hash;
+}
+
+/**
+ * Fills the alias hash table of cnvalias.icu:
+ * Open addressing with linear probing; each entry is 1+the index of an alias
+ * in the sorted alias list, or 0 for an empty slot.
+ * The aliases are inserted in alias list order, so that the
+ * table contents are a function of the alias list alone.
+ * @param hashTable receives capacity platform-endian entries
+ * @param capacity number of entries, a power of 2 larger than aliasCount
+ * @param aliasList platform-endian string indexes of the aliases, in 16-bit units
+ * @param aliasCount number of aliases
+ * @param normalizedStrings normalized string table
+ * @internal
+ */
+U_CAPI void U_EXPORT2
+ucnv_io_fillAliasHashTable(uint16_t *hashTable, uint32_t capacity,
+                           const uint16_t *aliasList, uint32_t aliasCount,
+                           const char *normalizedStrings);
+
 /**
  * \var ucnv_io_stripForCompare
  * Remove the underscores, dashes and spaces from the name, and convert
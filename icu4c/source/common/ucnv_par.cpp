@@ -0,0 +1,612 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  ucnv_par.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Bulk conversion of large inputs in chunks that are converted concurrently
+*   on a caller-supplied task runner (ucnv_convertParallel() etc.).
+*
+*   The input is split only where the source charset is known to be
+*   in its initial state, and only if neither the source nor the target
+*   charset carries state across characters. Each chunk is converted
+*   with its own clones of the converters into a temporary buffer,
+*   and the chunk outputs are then copied together.
+*   Everything else is converted serially.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_CONVERSION
+
+#include "unicode/ucnv.h"
+#include "unicode/ustring.h"
+#include "unicode/utf16.h"
+#include "cmemory.h"
+#include "cstring.h"
+#include "ustr_imp.h"
+#include "ucnv_imp.h"
+#include "ucnv_bld.h"
+#include "ucnv_cnv.h"
+#include "ucnvmbcs.h"
+#include "ucnv_ext.h"
+
+/* default number of source bytes per chunk */
+#define DEFAULT_CHUNK_LENGTH 0x100000
+
+/* how a source text may be split, see getSplitType() */
+enum {
+    SPLIT_NONE,         /* serial conversion only */
+    SPLIT_ANY,          /* at any byte */
+    SPLIT_AFTER_ASCII,  /* after a byte 00..7F (UTF-8, CESU-8) */
+    SPLIT_UTF16BE,      /* at an even index, not after a lead surrogate */
+    SPLIT_UTF16LE,
+    SPLIT_UTF32,        /* at a multiple of 4 */
+    SPLIT_AFTER_SAFE    /* after a byte that always ends a character (MBCS) */
+};
+
+/*
+ * Does the toUTable section at index i, entered in the given state,
+ * continue any input sequence beyond the end of a character?
+ */
+static UBool
+toUSectionContinuesAfterChar(const int32_t (*stateTable)[256], const uint32_t *toUTable,
+                             int32_t i, int32_t state) {
+    int32_t count=(int32_t)UCNV_EXT_TO_U_GET_BYTE(toUTable[i]);
+    while(count>0) {
+        uint32_t word=toUTable[++i];
+        uint32_t value=UCNV_EXT_TO_U_GET_VALUE(word);
+        int32_t entry=stateTable[state][UCNV_EXT_TO_U_GET_BYTE(word)];
+        --count;
+        if(value==0 || !UCNV_EXT_TO_U_IS_PARTIAL(value)) {
+            continue;  /* no longer input sequence */
+        }
+        if(MBCS_ENTRY_IS_FINAL(entry)) {
+            return TRUE;  /* the input continues with another character */
+        }
+        if(toUSectionContinuesAfterChar(stateTable, toUTable,
+                                        (int32_t)UCNV_EXT_TO_U_GET_PARTIAL_INDEX(value),
+                                        (int32_t)MBCS_ENTRY_TRANSITION_STATE(entry))) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Does the MBCS table have toUnicode extension mappings
+ * with input sequences of more than one character?
+ * (Those could continue across a split point.)
+ * Follows each input sequence through the state table.
+ */
+static UBool
+hasMultiCharToUExtension(const UConverterSharedData *sharedData) {
+    const int32_t *cx=sharedData->mbcs.extIndexes;
+    if(cx==NULL || cx[UCNV_EXT_TO_U_LENGTH]<=0 || (cx[UCNV_EXT_COUNT_BYTES]>>16)<=1) {
+        return FALSE;
+    }
+    return toUSectionContinuesAfterChar(sharedData->mbcs.stateTable,
+                                        UCNV_EXT_ARRAY(cx, UCNV_EXT_TO_U_INDEX, uint32_t), 0, 0);
+}
+
+/*
+ * Does the MBCS table have fromUnicode extension mappings
+ * with input strings of more than one code point?
+ * The fromUStage3b[] trie results map whole initial code points,
+ * so a partial-match result there means that more code points follow.
+ */
+static UBool
+hasMultiCodePointFromUExtension(const int32_t *cx) {
+    const uint32_t *stage3b;
+    int32_t i, length;
+
+    if(cx==NULL || (cx[UCNV_EXT_COUNT_UCHARS]>>16)<=1) {
+        return FALSE;
+    }
+    stage3b=UCNV_EXT_ARRAY(cx, UCNV_EXT_FROM_U_STAGE_3B_INDEX, uint32_t);
+    length=cx[UCNV_EXT_FROM_U_STAGE_3B_LENGTH];
+    for(i=0; i<length; ++i) {
+        uint32_t value=stage3b[i];
+        if(value!=0 && UCNV_EXT_FROM_U_IS_PARTIAL(value)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/*
+ * Returns the split type for converting from this charset.
+ * For SPLIT_AFTER_SAFE, also sets safeBytes[b] for each byte value b
+ * that is a complete character in the initial state
+ * and illegal in every other state, so that the initial state follows it
+ * no matter where the character before it started.
+ */
+static int32_t
+getSplitType(const UConverter *cnv, UBool safeBytes[256]) {
+    const UConverterSharedData *sharedData=cnv->sharedData;
+    const UConverterMBCSTable *mbcs;
+    const int32_t (*stateTable)[256];
+    int32_t b, state;
+    UBool hasSafeByte;
+
+    switch(sharedData->staticData->conversionType) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+        return SPLIT_ANY;
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+        return SPLIT_AFTER_ASCII;
+    case UCNV_UTF16_BigEndian:
+        return SPLIT_UTF16BE;
+    case UCNV_UTF16_LittleEndian:
+        return SPLIT_UTF16LE;
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return SPLIT_UTF32;
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        break;
+    default:
+        /* stateful, or with a BOM */
+        return SPLIT_NONE;
+    }
+
+    mbcs=&sharedData->mbcs;
+    if( mbcs->stateTable==NULL || mbcs->dbcsOnlyState!=0 ||
+        mbcs->outputType==MBCS_OUTPUT_2_SISO ||
+        hasMultiCharToUExtension(sharedData)
+    ) {
+        return SPLIT_NONE;
+    }
+    if(mbcs->countStates==1) {
+        return SPLIT_ANY;
+    }
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])mbcs->swapLFNLStateTable;
+    } else {
+        stateTable=mbcs->stateTable;
+    }
+    hasSafeByte=FALSE;
+    for(b=0; b<256; ++b) {
+        UBool isSafe=(UBool)MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(stateTable[0][b]);
+        for(state=1; isSafe && state<mbcs->countStates; ++state) {
+            int32_t entry=stateTable[state][b];
+            isSafe=(UBool)(MBCS_ENTRY_IS_FINAL(entry) &&
+                           MBCS_ENTRY_FINAL_ACTION(entry)==MBCS_STATE_ILLEGAL);
+        }
+        safeBytes[b]=isSafe;
+        hasSafeByte|=isSafe;
+    }
+    return hasSafeByte ? SPLIT_AFTER_SAFE : SPLIT_NONE;
+}
+
+/*
+ * Can text be converted from Unicode to this charset in pieces
+ * that end on code point boundaries, with the same result as converting it all at once?
+ */
+static UBool
+isStatelessFromUnicode(const UConverter *cnv) {
+    const UConverterSharedData *sharedData=cnv->sharedData;
+
+    switch(sharedData->staticData->conversionType) {
+    case UCNV_LATIN_1:
+    case UCNV_US_ASCII:
+    case UCNV_UTF8:
+    case UCNV_CESU8:
+    case UCNV_UTF16_BigEndian:
+    case UCNV_UTF16_LittleEndian:
+    case UCNV_UTF32_BigEndian:
+    case UCNV_UTF32_LittleEndian:
+        return TRUE;
+    case UCNV_SBCS:
+    case UCNV_DBCS:
+    case UCNV_MBCS:
+        /* no SI/SO state, and no extension mappings for sequences of code points */
+        return (UBool)(sharedData->mbcs.outputType!=MBCS_OUTPUT_2_SISO &&
+                       !hasMultiCodePointFromUExtension(sharedData->mbcs.extIndexes));
+    default:
+        return FALSE;
+    }
+}
+
+/*
+ * Returns the smallest index i>=start where the source may be split,
+ * or length if there is none.
+ */
+static int32_t
+findSplit(int32_t splitType, const UBool safeBytes[256],
+          const uint8_t *s, int32_t start, int32_t length) {
+    int32_t i=start;
+    switch(splitType) {
+    case SPLIT_ANY:
+        break;
+    case SPLIT_AFTER_ASCII:
+        while(i<length && s[i-1]>0x7f) {
+            ++i;
+        }
+        break;
+    case SPLIT_UTF16BE:
+        i+=i&1;
+        while(i<length && U16_IS_LEAD((s[i-2]<<8)|s[i-1])) {
+            i+=2;
+        }
+        break;
+    case SPLIT_UTF16LE:
+        i+=i&1;
+        while(i<length && U16_IS_LEAD((s[i-1]<<8)|s[i-2])) {
+            i+=2;
+        }
+        break;
+    case SPLIT_UTF32:
+        i=(i+3)&~3;
+        break;
+    case SPLIT_AFTER_SAFE:
+        while(i<length && !safeBytes[s[i-1]]) {
+            ++i;
+        }
+        break;
+    default:
+        return length;
+    }
+    return i<length ? i : length;
+}
+
+struct ParallelChunk {
+    /* source index range */
+    int32_t start, limit;
+    /* chunk output, and its index in the final output */
+    void *buffer;
+    int32_t *offsets;
+    int32_t length, destIndex;
+    UErrorCode errorCode;
+};
+
+struct ParallelConversion {
+    UConverter *targetCnv;  /* NULL for conversion to UTF-16 */
+    UConverter *sourceCnv;
+    const char *source;
+    ParallelChunk *chunks;
+    char *target;
+    UChar *dest;
+    int32_t *offsets;
+};
+
+/*
+ * Splits the source into chunks and allocates the chunk array.
+ * Returns the number of chunks, or 0 if the text is to be converted serially.
+ */
+static int32_t
+splitSource(ParallelConversion *pc, int32_t sourceLength, int32_t chunkLength,
+            UErrorCode *pErrorCode) {
+    UBool safeBytes[256];
+    int32_t splitType, maxCount, count, start, limit;
+
+    splitType=getSplitType(pc->sourceCnv, safeBytes);
+    if(splitType==SPLIT_NONE || (pc->targetCnv!=NULL && !isStatelessFromUnicode(pc->targetCnv))) {
+        return 0;
+    }
+    if(chunkLength==0) {
+        chunkLength=DEFAULT_CHUNK_LENGTH;
+    }
+    maxCount=sourceLength/chunkLength;
+    if(maxCount<2) {
+        return 0;
+    }
+
+    pc->chunks=(ParallelChunk *)uprv_malloc(maxCount*sizeof(ParallelChunk));
+    if(pc->chunks==NULL) {
+        *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    count=0;
+    start=0;
+    do {
+        if(count==maxCount-1) {
+            limit=sourceLength;
+        } else {
+            limit=findSplit(splitType, safeBytes, (const uint8_t *)pc->source,
+                            start+chunkLength, sourceLength);
+        }
+        ParallelChunk &chunk=pc->chunks[count++];
+        chunk.start=start;
+        chunk.limit=limit;
+        chunk.buffer=NULL;
+        chunk.offsets=NULL;
+        chunk.length=chunk.destIndex=0;
+        chunk.errorCode=U_ZERO_ERROR;
+        start=limit;
+    } while(start<sourceLength);
+
+    if(count<2) {
+        uprv_free(pc->chunks);
+        pc->chunks=NULL;
+        return 0;
+    }
+    return count;
+}
+
+/*
+ * Like ucnv_toUChars() but with offsets,
+ * and without resetting the converter or checking arguments.
+ */
+static int32_t
+toUCharsWithOffsets(UConverter *cnv,
+                    UChar *dest, int32_t destCapacity, int32_t *offsets,
+                    const char *src, int32_t srcLength,
+                    UErrorCode *pErrorCode) {
+    const char *srcLimit=src+srcLength;
+    UChar *destStart=dest;
+    int32_t destLength;
+
+    ucnv_toUnicode(cnv, &dest, dest+destCapacity, &src, srcLimit, offsets, TRUE, pErrorCode);
+    destLength=(int32_t)(dest-destStart);
+
+    /* if an overflow occurs, then get the preflighting length */
+    if(*pErrorCode==U_BUFFER_OVERFLOW_ERROR) {
+        UChar buffer[1024];
+
+        do {
+            dest=buffer;
+            *pErrorCode=U_ZERO_ERROR;
+            ucnv_toUnicode(cnv, &dest, buffer+UPRV_LENGTHOF(buffer), &src, srcLimit, NULL, TRUE, pErrorCode);
+            destLength+=(int32_t)(dest-buffer);
+        } while(*pErrorCode==U_BUFFER_OVERFLOW_ERROR);
+    }
+    return u_terminateUChars(destStart, destCapacity, destLength, pErrorCode);
+}
+
+U_CDECL_BEGIN
+
+/* Converts one chunk into its own buffer. */
+static void U_CALLCONV
+convertChunk(void *context, int32_t index) {
+    ParallelConversion *pc=(ParallelConversion *)context;
+    ParallelChunk &chunk=pc->chunks[index];
+    const char *s=pc->source+chunk.start;
+    int32_t sLength=chunk.limit-chunk.start;
+    UErrorCode *pErrorCode=&chunk.errorCode;
+    UConverter *sourceCnv, *targetCnv=NULL;
+    int32_t capacity, length;
+
+    /* The caller reset the converters, so the clones are in their initial states. */
+    sourceCnv=ucnv_safeClone(pc->sourceCnv, NULL, NULL, pErrorCode);
+    if(pc->targetCnv!=NULL) {
+        targetCnv=ucnv_safeClone(pc->targetCnv, NULL, NULL, pErrorCode);
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        ucnv_close(sourceCnv);
+        ucnv_close(targetCnv);
+        return;
+    }
+
+    /* Guess the output capacity; convert again with the exact capacity if too small. */
+    capacity=pc->targetCnv!=NULL ? 2*sLength+16 : sLength+16;
+    for(;;) {
+        if(targetCnv!=NULL) {
+            chunk.buffer=uprv_malloc(capacity);
+        } else {
+            chunk.buffer=uprv_malloc(capacity*U_SIZEOF_UCHAR);
+            if(pc->offsets!=NULL && chunk.buffer!=NULL) {
+                chunk.offsets=(int32_t *)uprv_malloc(capacity*4);
+                if(chunk.offsets==NULL) {
+                    uprv_free(chunk.buffer);
+                    chunk.buffer=NULL;
+                }
+            }
+        }
+        if(chunk.buffer==NULL) {
+            *pErrorCode=U_MEMORY_ALLOCATION_ERROR;
+            break;
+        }
+        if(targetCnv!=NULL) {
+            length=ucnv_internalConvert(targetCnv, sourceCnv,
+                                        (char *)chunk.buffer, capacity,
+                                        s, sLength, pErrorCode);
+        } else {
+            length=toUCharsWithOffsets(sourceCnv,
+                                       (UChar *)chunk.buffer, capacity, chunk.offsets,
+                                       s, sLength, pErrorCode);
+        }
+        if(*pErrorCode!=U_BUFFER_OVERFLOW_ERROR) {
+            chunk.length=length;
+            break;
+        }
+        uprv_free(chunk.buffer);
+        uprv_free(chunk.offsets);
+        chunk.buffer=NULL;
+        chunk.offsets=NULL;
+        *pErrorCode=U_ZERO_ERROR;
+        ucnv_resetToUnicode(sourceCnv);
+        if(targetCnv!=NULL) {
+            ucnv_resetFromUnicode(targetCnv);
+        }
+        capacity=length;
+    }
+    if(U_FAILURE(*pErrorCode)) {
+        uprv_free(chunk.buffer);
+        uprv_free(chunk.offsets);
+        chunk.buffer=NULL;
+        chunk.offsets=NULL;
+    } else {
+        /* ignore warnings like U_STRING_NOT_TERMINATED_WARNING */
+        *pErrorCode=U_ZERO_ERROR;
+    }
+    ucnv_close(sourceCnv);
+    ucnv_close(targetCnv);
+}
+
+/* Copies one chunk's output into the final output, and releases the chunk buffers. */
+static void U_CALLCONV
+copyChunk(void *context, int32_t index) {
+    ParallelConversion *pc=(ParallelConversion *)context;
+    ParallelChunk &chunk=pc->chunks[index];
+    int32_t i;
+
+    if(pc->targetCnv!=NULL) {
+        uprv_memcpy(pc->target+chunk.destIndex, chunk.buffer, chunk.length);
+    } else {
+        u_memcpy(pc->dest+chunk.destIndex, (const UChar *)chunk.buffer, chunk.length);
+        if(pc->offsets!=NULL) {
+            int32_t *offsets=pc->offsets+chunk.destIndex;
+            for(i=0; i<chunk.length; ++i) {
+                int32_t offset=chunk.offsets[i];
+                offsets[i]= offset>=0 ? chunk.start+offset : offset;
+            }
+        }
+    }
+    uprv_free(chunk.buffer);
+    uprv_free(chunk.offsets);
+    chunk.buffer=NULL;
+    chunk.offsets=NULL;
+}
+
+U_CDECL_END
+
+/*
+ * Runs the chunk conversions, then copies the results together if they fit.
+ * Returns the total output length.
+ */
+static int32_t
+convertChunks(ParallelConversion *pc, int32_t count, int32_t destCapacity,
+              UConverterTaskRunner *runner, const void *runnerContext,
+              UErrorCode *pErrorCode) {
+    int64_t length=0;
+    int32_t i;
+
+    runner(runnerContext, convertChunk, pc, count);
+
+    for(i=0; i<count; ++i) {
+        ParallelChunk &chunk=pc->chunks[i];
+        if(U_FAILURE(chunk.errorCode)) {
+            /* report the first error */
+            if(U_SUCCESS(*pErrorCode)) {
+                *pErrorCode=chunk.errorCode;
+            }
+        } else {
+            chunk.destIndex=(int32_t)length;
+            length+=chunk.length;
+        }
+    }
+    if(U_SUCCESS(*pErrorCode) && length>INT32_MAX) {
+        *pErrorCode=U_INDEX_OUTOFBOUNDS_ERROR;
+    }
+    if(U_SUCCESS(*pErrorCode) && length<=destCapacity) {
+        runner(runnerContext, copyChunk, pc, count);
+    }
+
+    for(i=0; i<count; ++i) {
+        uprv_free(pc->chunks[i].buffer);
+        uprv_free(pc->chunks[i].offsets);
+    }
+    uprv_free(pc->chunks);
+    return U_SUCCESS(*pErrorCode) ? (int32_t)length : 0;
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_convertParallel(UConverter *targetCnv, UConverter *sourceCnv,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     int32_t chunkLength,
+                     UConverterTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode) {
+    ParallelConversion pc;
+    int32_t count, length;
+
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if( targetCnv==NULL || sourceCnv==NULL ||
+        source==NULL || sourceLength<-1 ||
+        targetCapacity<0 || (targetCapacity>0 && target==NULL) ||
+        chunkLength<0
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    ucnv_resetToUnicode(sourceCnv);
+    ucnv_resetFromUnicode(targetCnv);
+    if(sourceLength<0) {
+        sourceLength=(int32_t)uprv_strlen(source);
+    }
+    if(sourceLength==0) {
+        return u_terminateChars(target, targetCapacity, 0, pErrorCode);
+    }
+
+    pc.targetCnv=targetCnv;
+    pc.sourceCnv=sourceCnv;
+    pc.source=source;
+    pc.chunks=NULL;
+    pc.target=target;
+    pc.dest=NULL;
+    pc.offsets=NULL;
+    count= runner!=NULL ? splitSource(&pc, sourceLength, chunkLength, pErrorCode) : 0;
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(count==0) {
+        return ucnv_internalConvert(targetCnv, sourceCnv,
+                                    target, targetCapacity,
+                                    source, sourceLength,
+                                    pErrorCode);
+    }
+
+    length=convertChunks(&pc, count, targetCapacity, runner, runnerContext, pErrorCode);
+    return u_terminateChars(target, targetCapacity, length, pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucnv_toUCharsParallel(UConverter *cnv,
+                      UChar *dest, int32_t destCapacity, int32_t *offsets,
+                      const char *src, int32_t srcLength,
+                      int32_t chunkLength,
+                      UConverterTaskRunner *runner, const void *runnerContext,
+                      UErrorCode *pErrorCode) {
+    ParallelConversion pc;
+    int32_t count, length;
+
+    if(pErrorCode==NULL || U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if( cnv==NULL ||
+        destCapacity<0 || (destCapacity>0 && dest==NULL) ||
+        srcLength<-1 || (srcLength!=0 && src==NULL) ||
+        chunkLength<0
+    ) {
+        *pErrorCode=U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+
+    ucnv_resetToUnicode(cnv);
+    if(srcLength<0) {
+        srcLength=(int32_t)uprv_strlen(src);
+    }
+    if(srcLength==0) {
+        return u_terminateUChars(dest, destCapacity, 0, pErrorCode);
+    }
+
+    pc.targetCnv=NULL;
+    pc.sourceCnv=cnv;
+    pc.source=src;
+    pc.chunks=NULL;
+    pc.target=NULL;
+    pc.dest=dest;
+    pc.offsets=offsets;
+    count= runner!=NULL ? splitSource(&pc, srcLength, chunkLength, pErrorCode) : 0;
+    if(U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if(count==0) {
+        return toUCharsWithOffsets(cnv, dest, destCapacity, offsets, src, srcLength, pErrorCode);
+    }
+
+    length=convertChunks(&pc, count, destCapacity, runner, runnerContext, pErrorCode);
+    return u_terminateUChars(dest, destCapacity, length, pErrorCode);
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include "ucnv_cnv.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "ustr_ascii.h"
 
 /* Prototypes --------------------------------------------------------------- */
 
@@ -94,6 +95,14 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8 (UConverterToUnicodeArgs * args,
         if (U8_IS_SINGLE(ch))        /* Simple case */
         {
             *(myTarget++) = (UChar) ch;
+            /* copy a following run of ASCII bytes in blocks */
+            int32_t length = (int32_t)(sourceLimit - mySource);
+            if (length > (int32_t)(targetLimit - myTarget)) {
+                length = (int32_t)(targetLimit - myTarget);
+            }
+            length = uprv_copyASCIIToUChars(myTarget, mySource, length);
+            mySource += length;
+            myTarget += length;
         }
         else
         {
@@ -212,6 +221,18 @@ static void  U_CALLCONV ucnv_toUnicode_UTF8_OFFSETS_LOGIC (UConverterToUnicodeAr
         {
             *(myTarget++) = (UChar) ch;
             *(myOffsets++) = offsetNum++;
+            /* copy a following run of ASCII bytes in blocks */
+            int32_t length = (int32_t)(sourceLimit - mySource);
+            if (length > (int32_t)(targetLimit - myTarget)) {
+                length = (int32_t)(targetLimit - myTarget);
+            }
+            length = uprv_copyASCIIToUChars(myTarget, mySource, length);
+            mySource += length;
+            myTarget += length;
+            while (length > 0) {
+                *(myOffsets++) = offsetNum++;
+                --length;
+            }
         }
         else
         {
@@ -325,6 +346,14 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8 (UConverterFromUnicodeArgs * args
         if (ch < 0x80)        /* Single byte */
         {
             *(myTarget++) = (uint8_t) ch;
+            /* copy a following run of ASCII characters in blocks */
+            int32_t length = (int32_t)(sourceLimit - mySource);
+            if (length > (int32_t)(targetLimit - myTarget)) {
+                length = (int32_t)(targetLimit - myTarget);
+            }
+            length = uprv_copyUCharsBelow(myTarget, mySource, length, 0x7f);
+            mySource += length;
+            myTarget += length;
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -446,6 +475,18 @@ U_CFUNC void  U_CALLCONV ucnv_fromUnicode_UTF8_OFFSETS_LOGIC (UConverterFromUnic
         {
             *(myOffsets++) = offsetNum++;
             *(myTarget++) = (char) ch;
+            /* copy a following run of ASCII characters in blocks */
+            int32_t length = (int32_t)(sourceLimit - mySource);
+            if (length > (int32_t)(targetLimit - myTarget)) {
+                length = (int32_t)(targetLimit - myTarget);
+            }
+            length = uprv_copyUCharsBelow(myTarget, mySource, length, 0x7f);
+            mySource += length;
+            myTarget += length;
+            while (length > 0) {
+                *(myOffsets++) = offsetNum++;
+                --length;
+            }
         }
         else if (ch < 0x800)  /* Double byte */
         {
@@ -723,9 +764,14 @@ ucnv_UTF8FromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
     while(count>0) {
         b=*source++;
         if(U8_IS_SINGLE(b)) {
-            /* convert ASCII */
+            /* convert ASCII, and copy a following run of ASCII bytes in blocks */
+            int32_t length;
             *target++=b;
             --count;
+            length=uprv_copyASCIIBytes(target, source, count);
+            source+=length;
+            target+=length;
+            count-=length;
             continue;
         } else {
             if(b>=0xe0) {
@@ -59,6 +59,7 @@
 #include "cmemory.h"
 #include "cstring.h"
 #include "umutex.h"
+#include "ustr_ascii.h"
 #include "ustr_imp.h"
 
 /* control optimizations according to the platform */
@@ -431,6 +432,11 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
                   UConverterToUnicodeArgs *pToUArgs,
                   UErrorCode *pErrorCode);
 
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode);
+
 static const UConverterImpl _SBCSUTF8Impl={
     UCNV_MBCS,
 
@@ -453,7 +459,7 @@ static const UConverterImpl _SBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_SBCSFromUTF8
 };
 
@@ -479,7 +485,7 @@ static const UConverterImpl _DBCSUTF8Impl={
     NULL,
     ucnv_MBCSGetUnicodeSet,
 
-    NULL,
+    ucnv_MBCSToUTF8,
     ucnv_DBCSFromUTF8
 };
 
@@ -504,7 +510,7 @@ static const UConverterImpl _MBCSImpl={
     ucnv_MBCSWriteSub,
     NULL,
     ucnv_MBCSGetUnicodeSet,
-    NULL,
+    ucnv_MBCSToUTF8,
     NULL
 };
 
@@ -513,7 +519,7 @@ static const UConverterImpl _MBCSImpl={
  */
 
 const UConverterSharedData _MBCSData={
-    sizeof(UConverterSharedData), 1,
+    sizeof(UConverterSharedData), { 1 },
     NULL, NULL, FALSE, TRUE, &_MBCSImpl,
     0, UCNV_MBCS_TABLE_INITIALIZER
 };
@@ -5622,6 +5628,184 @@ ucnv_DBCSFromUTF8(UConverterFromUnicodeArgs *pFromUArgs,
     pFromUArgs->target=(char *)target;
 }
 
+/* MBCS-to-UTF-8 conversion function ---------------------------------------- */
+
+/*
+ * Direct conversion from any MBCS codepage to UTF-8, for ucnv_convertEx().
+ *
+ * This function walks the toUnicode state table just like
+ * ucnv_MBCSToUnicodeWithOffsets() and writes the code points
+ * of all round-trip (and, if enabled, fallback) mappings directly as UTF-8.
+ *
+ * It does not handle anything that needs the converter's error and
+ * extension machinery: unassigned and illegal sequences, extension-table
+ * mappings, fallbacks stored outside of the state table, and
+ * partial characters at the end of the input.
+ * For those, it stops before the character and returns U_USING_DEFAULT_WARNING
+ * so that ucnv_convertEx() converts the next few characters by pivoting
+ * through UTF-16, after which it calls this function again.
+ */
+static void U_CALLCONV
+ucnv_MBCSToUTF8(UConverterFromUnicodeArgs *pFromUArgs,
+                UConverterToUnicodeArgs *pToUArgs,
+                UErrorCode *pErrorCode) {
+    UConverter *utf8, *cnv;
+    const uint8_t *source, *sourceLimit, *charStart;
+    uint8_t *target;
+    const uint8_t *targetLimit;
+
+    const int32_t (*stateTable)[256];
+    const uint16_t *unicodeCodeUnits;
+
+    uint32_t offset;
+    uint8_t state, nextState;
+    int32_t entry, length;
+    UChar32 c;
+    uint8_t action;
+    UBool useFallback, copyASCII;
+
+    /* set up the local pointers */
+    cnv=pToUArgs->converter;
+    utf8=pFromUArgs->converter;
+
+    if(cnv->toULength>0 || utf8->fromUChar32!=0) {
+        /* finish a partial character or a pending lead surrogate by pivoting */
+        *pErrorCode=U_USING_DEFAULT_WARNING;
+        return;
+    }
+
+    source=(const uint8_t *)pToUArgs->source;
+    sourceLimit=(const uint8_t *)pToUArgs->sourceLimit;
+    target=(uint8_t *)pFromUArgs->target;
+    targetLimit=(const uint8_t *)pFromUArgs->targetLimit;
+
+    if((cnv->options&UCNV_OPTION_SWAP_LFNL)!=0) {
+        stateTable=(const int32_t (*)[256])cnv->sharedData->mbcs.swapLFNLStateTable;
+        copyASCII=FALSE;
+    } else {
+        stateTable=cnv->sharedData->mbcs.stateTable;
+        /* all of bytes 00..7f map to U+0000..U+007F in state 0 */
+        copyASCII=(UBool)(cnv->sharedData->mbcs.asciiRoundtrips==0xffffffff);
+    }
+    unicodeCodeUnits=cnv->sharedData->mbcs.unicodeCodeUnits;
+    useFallback=UCNV_TO_U_USE_FALLBACK(cnv);
+
+    /* same as in ucnv_MBCSToUnicodeWithOffsets() */
+    if((state=(uint8_t)(cnv->mode))==0) {
+        state=cnv->sharedData->mbcs.dbcsOnlyState;
+    }
+
+    /* conversion loop */
+    while(source<sourceLimit) {
+        if(target>=targetLimit) {
+            /* target is full */
+            *pErrorCode=U_BUFFER_OVERFLOW_ERROR;
+            break;
+        }
+
+        entry=stateTable[state][*source];
+        if(MBCS_ENTRY_FINAL_IS_VALID_DIRECT_16(entry) && (c=MBCS_ENTRY_FINAL_VALUE_16(entry))<=0x7f) {
+            /* ASCII, or at least a single byte mapped to U+0000..U+007F */
+            if(copyASCII && state==0 && c==*source) {
+                length=(int32_t)(sourceLimit-source);
+                if(length>(int32_t)(targetLimit-target)) {
+                    length=(int32_t)(targetLimit-target);
+                }
+                length=uprv_copyASCIIBytes(target, source, length);
+                source+=length;
+                target+=length;
+            } else {
+                ++source;
+                *target++=(uint8_t)c;
+                state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+            }
+            continue;
+        }
+
+        /* read the bytes of one character */
+        charStart=source++;
+        nextState=state;
+        offset=0;
+        while(MBCS_ENTRY_IS_TRANSITION(entry)) {
+            if(source>=sourceLimit) {
+                /* partial character at the end of the input: let the pivoting code store it */
+                break;
+            }
+            nextState=(uint8_t)MBCS_ENTRY_TRANSITION_STATE(entry);
+            offset+=MBCS_ENTRY_TRANSITION_OFFSET(entry);
+            entry=stateTable[nextState][*source++];
+        }
+
+        c=U_SENTINEL;
+        if(MBCS_ENTRY_IS_FINAL(entry)) {
+            action=(uint8_t)(MBCS_ENTRY_FINAL_ACTION(entry));
+            if( action==MBCS_STATE_VALID_DIRECT_16 ||
+                (action==MBCS_STATE_FALLBACK_DIRECT_16 && useFallback)
+            ) {
+                c=MBCS_ENTRY_FINAL_VALUE_16(entry);
+            } else if(action==MBCS_STATE_VALID_16) {
+                c=unicodeCodeUnits[offset+MBCS_ENTRY_FINAL_VALUE_16(entry)];
+                if(c>=0xfffe) {
+                    /* unassigned, fallback or illegal */
+                    c=U_SENTINEL;
+                }
+            } else if(action==MBCS_STATE_VALID_16_PAIR) {
+                offset+=MBCS_ENTRY_FINAL_VALUE_16(entry);
+                c=unicodeCodeUnits[offset++];
+                if(c<0xd800) {
+                    /* BMP code point below 0xd800 */
+                } else if(useFallback ? c<=0xdfff : c<=0xdbff) {
+                    /* roundtrip or fallback surrogate pair */
+                    c=U16_GET_SUPPLEMENTARY(c&0xdbff, unicodeCodeUnits[offset]);
+                } else if(useFallback ? (c&0xfffe)==0xe000 : c==0xe000) {
+                    /* roundtrip BMP code point above 0xd800 or fallback BMP code point */
+                    c=unicodeCodeUnits[offset];
+                } else {
+                    c=U_SENTINEL;
+                }
+            } else if( action==MBCS_STATE_VALID_DIRECT_20 ||
+                       (action==MBCS_STATE_FALLBACK_DIRECT_20 && useFallback)
+            ) {
+                c=MBCS_ENTRY_FINAL_VALUE(entry)+0x10000;
+            } else if(action==MBCS_STATE_CHANGE_ONLY && cnv->sharedData->mbcs.dbcsOnlyState==0) {
+                /* SI/SO state change without output */
+                state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry);
+                continue;
+            }
+        }
+
+        if(c<0 || U_IS_SURROGATE(c)) {
+            /* revert to pivoting for this character */
+            source=charStart;
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+
+        length=U8_LENGTH(c);
+        if(length>(int32_t)(targetLimit-target)) {
+            /*
+             * Not enough room for the whole character:
+             * Let the UTF-8 converter write what fits and keep the rest
+             * in its overflow buffer.
+             */
+            source=charStart;
+            *pErrorCode=U_USING_DEFAULT_WARNING;
+            break;
+        }
+        length=0;
+        U8_APPEND_UNSAFE(target, length, c);
+        target+=length;
+        state=(uint8_t)MBCS_ENTRY_FINAL_STATE(entry); /* typically 0 */
+    }
+
+    /* set the converter state back into UConverter */
+    cnv->mode=state;
+
+    /* write back the updated pointers */
+    pToUArgs->source=(const char *)source;
+    pFromUArgs->target=(char *)target;
+}
+
 /* miscellaneous ------------------------------------------------------------ */
 
 static void U_CALLCONV
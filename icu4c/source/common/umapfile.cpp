@@ -171,6 +171,10 @@ typedef HANDLE MemoryMap;
             return FALSE;
         }
 
+        /* determine the length of the file, for udata_getLength() */
+        DWORD fileSizeHigh = 0;
+        DWORD fileSize = GetFileSize(file, &fileSizeHigh);
+
         // Note: We use NULL/nullptr for lpAttributes parameter below.
         // This means our handle cannot be inherited and we will get the default security descriptor.
         /* create an unnamed Windows file-mapping object for the specified file */
@@ -193,6 +197,9 @@ typedef HANDLE MemoryMap;
             return FALSE;
         }
         pData->map = map;
+        if (fileSize != INVALID_FILE_SIZE && fileSizeHigh == 0 && fileSize <= INT32_MAX) {
+            pData->length = (int32_t)fileSize;
+        }
         return TRUE;
     }
 
@@ -249,6 +256,7 @@ typedef HANDLE MemoryMap;
         pData->map = (char *)data + length;
         pData->pHeader=(const DataHeader *)data;
         pData->mapAddr = data;
+        pData->length = length;
 #if U_PLATFORM == U_PF_IPHONE
         posix_madvise(data, length, POSIX_MADV_RANDOM);
 #endif
@@ -327,6 +335,7 @@ typedef HANDLE MemoryMap;
         pData->map=p;
         pData->pHeader=(const DataHeader *)p;
         pData->mapAddr=p;
+        pData->length=fileLength;
         return TRUE;
     }
 
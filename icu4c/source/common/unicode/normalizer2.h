@@ -37,6 +37,7 @@
 
 U_NAMESPACE_BEGIN
 
+class Appendable;
 class ByteSink;
 
 /**
@@ -770,6 +771,125 @@ class U_COMMON_API FilteredNormalizer2 : public Normalizer2 {
     const UnicodeSet &set;
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Normalizes text that arrives in chunks, for example an unbounded stream
+ * read piece by piece, without keeping all of the text in memory.
+ *
+ * Each append call writes the normalized form of the text up to the last
+ * normalization boundary seen so far, and keeps only the text after that
+ * boundary until more input arrives or finish() is called.
+ * Chunks may end anywhere, including in the middle of a UTF-8 sequence
+ * or between the two code units of a surrogate pair.
+ * The concatenated output is the same as normalizing the concatenation
+ * of all of the chunks with the Normalizer2.
+ *
+ * The text after the last boundary is usually short. A long run of characters
+ * without any boundary, such as thousands of combining marks, is buffered whole.
+ *
+ * An object processes either UTF-8 or UTF-16 text, not both
+ * between calls to finish(), finishUTF8() or reset().
+ * An object must not be used concurrently by multiple threads.
+ *
+ * @draft ICU 65
+ */
+class U_COMMON_API StreamingNormalizer U_FINAL : public UMemory {
+public:
+    /**
+     * Constructor.
+     * @param norm2 the Normalizer2 instance to use;
+     *              must not be deleted while this object is in use
+     * @draft ICU 65
+     */
+    explicit StreamingNormalizer(const Normalizer2 &norm2);
+
+    /**
+     * Destructor. Discards any text that has not been written yet.
+     * @draft ICU 65
+     */
+    ~StreamingNormalizer();
+
+    /**
+     * Normalizes the next chunk of UTF-8 text and writes as much of the result
+     * as is determined so far to the ByteSink.
+     * Ill-formed UTF-8 is treated as in Normalizer2::normalizeUTF8().
+     *
+     * @param chunk next part of the UTF-8 input
+     * @param sink normalized output bytes are written here
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  U_ILLEGAL_ARGUMENT_ERROR if UTF-16 text is pending.
+     * @draft ICU 65
+     */
+    void appendUTF8(StringPiece chunk, ByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Writes the normalized form of the remaining UTF-8 text to the ByteSink
+     * and prepares this object for the next stream.
+     *
+     * @param sink normalized output bytes are written here
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 65
+     */
+    void finishUTF8(ByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Normalizes the next chunk of UTF-16 text and appends as much of the result
+     * as is determined so far to the Appendable.
+     *
+     * @param chunk next part of the UTF-16 input
+     * @param dest normalized output is appended here
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     *                  U_ILLEGAL_ARGUMENT_ERROR if UTF-8 text is pending.
+     * @draft ICU 65
+     */
+    void append(const UnicodeString &chunk, Appendable &dest, UErrorCode &errorCode);
+
+    /**
+     * Appends the normalized form of the remaining UTF-16 text to the Appendable
+     * and prepares this object for the next stream.
+     *
+     * @param dest normalized output is appended here
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @draft ICU 65
+     */
+    void finish(Appendable &dest, UErrorCode &errorCode);
+
+    /**
+     * Discards any pending text and prepares this object for the next stream.
+     * @draft ICU 65
+     */
+    void reset();
+
+private:
+    StreamingNormalizer(const StreamingNormalizer &other) = delete;
+    StreamingNormalizer &operator=(const StreamingNormalizer &other) = delete;
+
+    UBool appendPendingUTF8(const char *s, int32_t length, UErrorCode &errorCode);
+    void normalizeToAppendable(const UnicodeString &src, Appendable &dest,
+                               UErrorCode &errorCode) const;
+
+    const Normalizer2 &norm2;
+    /** UTF-16 text after the last boundary. */
+    UnicodeString pending16;
+    /** UTF-8 text after the last boundary. */
+    char *pending8;
+    int32_t pending8Length;
+    int32_t pending8Capacity;
+};
+#endif  // U_HIDE_DRAFT_API
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_NORMALIZATION
@@ -40,6 +40,8 @@ struct RBBIDataHeader;
 class  RBBIDataWrapper;
 class  UnhandledEngine;
 class  UStack;
+class  UVector;
+class  UVector32;
 
 /**
  *
@@ -160,6 +162,8 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
     friend class RBBIRuleBuilder;
     /** @internal */
     friend class BreakIterator;
+    /** @internal */
+    friend class ChunkedSegmentation;
 
 public:
 
@@ -512,6 +516,41 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
     */
     virtual int32_t getRuleStatusVec(int32_t *fillInVec, int32_t capacity, UErrorCode &status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Advances the iterator over multiple boundaries at once, storing them
+     * into an array provided by the caller.
+     * This is equivalent to calling next() (and getRuleStatus()) repeatedly,
+     * but much faster because it runs the rules directly
+     * rather than going through the boundary cache for each boundary.
+     * <p>
+     * Boundaries are returned in ascending order, starting with the one
+     * following the current iteration position, and stopping before the first
+     * boundary that is greater than limit, at the end of the text,
+     * or when the array is full.
+     * The iterator is left at the last boundary that was returned,
+     * so that a subsequent call continues where this one stopped.
+     * When there are no more boundaries up to the limit, 0 is returned
+     * and the iteration position is unchanged.
+     *
+     * @param limit        The text position after which no boundaries are returned.
+     *                     Use INT32_MAX to return all of the remaining boundaries.
+     * @param boundaries   An array to be filled in with the boundary positions.
+     * @param ruleStatuses An array to be filled in with the getRuleStatus() values
+     *                     for each of the returned boundaries, or NULL if not needed.
+     *                     If not NULL, it must have the same capacity as boundaries.
+     * @param capacity     The capacity of the boundaries (and ruleStatuses) arrays.
+     * @param status       Receives error codes.
+     * @return The number of boundaries stored in the array.
+     * @see next
+     * @see getRuleStatus
+     * @draft ICU 65
+     */
+    int32_t nextBoundaries(int32_t limit,
+                           int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                           UErrorCode &status);
+#endif  /* U_HIDE_DRAFT_API */
+
     /**
      * Returns a unique class ID POLYMORPHICALLY.  Pure virtual override.
      * This method is to implement a simple version of RTTI, since not all
@@ -658,6 +697,33 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
      */
     int32_t handleNext();
 
+    /**
+     * The state machine loops of handleSafePrevious() and handleNext(),
+     * instantiated for UText access and for direct access to UTF-8 strings.
+     * @internal (private)
+     */
+    template<typename BreakText>
+    int32_t handleSafePrevious(int32_t fromPosition, BreakText &text);
+
+    /**
+     * @internal (private)
+     */
+    template<typename BreakText>
+    int32_t handleNext(BreakText &text);
+
+
+    /**
+     * Segment the text forward, running the rules from fromPosition until
+     * reaching the end of a rule based segment at or after limit.
+     * Each boundary is appended to boundaries, with its rule status index appended
+     * to statusIndexes. The end of each rule based segment, which is the position
+     * from which the rules run next, is appended to resumePositions.
+     * Dictionary segments are subdivided the same way as for next().
+     * @internal (private)
+     */
+    void segmentForward(int32_t fromPosition, int32_t limit,
+                        UVector32 &boundaries, UVector32 &statusIndexes,
+                        UVector32 &resumePositions, UErrorCode &status);
 
     /**
      * This function returns the appropriate LanguageBreakEngine for a
@@ -684,6 +750,106 @@ class U_COMMON_API RuleBasedBreakIterator /*U_FINAL*/ : public BreakIterator {
 #endif  /* U_HIDE_INTERNAL_API */
 };
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Segmentation of a long text in chunks that can be processed in parallel,
+ * by multiple threads, with the same result as iterating over the whole text
+ * with the RuleBasedBreakIterator.
+ * <p>
+ * The text is divided into chunks of about equal length.
+ * Each chunk is segmented with its own clone of the break iterator, running the rules
+ * from the chunk start until reaching the next chunk.
+ * The results are joined at the first position from which the rules run for both
+ * neighboring chunks; from there on, they yield the same boundaries.
+ * (If they do not fall into step within a chunk, that chunk is segmented again serially.)
+ * <p>
+ * Usage:
+ * <pre>
+ * \code
+ *     ChunkedSegmentation segmentation(*bi, numThreads, status);
+ *     // On any threads, concurrently, for each i from 0 to segmentation.getChunkCount()-1:
+ *     segmentation.segmentChunk(i, status);
+ *     // After all of the chunks have been segmented:
+ *     int32_t count = segmentation.getBoundaries(boundaries, statuses, capacity, status);
+ * \endcode
+ * </pre>
+ * <p>
+ * The text of the break iterator must not be modified or deleted
+ * while the ChunkedSegmentation is in use.
+ * The break iterator itself is not used after construction.
+ *
+ * @draft ICU 65
+ */
+class U_COMMON_API ChunkedSegmentation : public UMemory {
+public:
+    /**
+     * Divides the text of the break iterator into up to maxChunkCount chunks.
+     * Texts are not divided into very short chunks,
+     * so there may be fewer chunks, down to only one.
+     *
+     * @param bi            The break iterator, which also provides the text.
+     * @param maxChunkCount The maximum number of chunks, for example the number of threads.
+     * @param status        Receives error codes.
+     * @draft ICU 65
+     */
+    ChunkedSegmentation(const RuleBasedBreakIterator &bi, int32_t maxChunkCount, UErrorCode &status);
+
+    /**
+     * Destructor.
+     * @draft ICU 65
+     */
+    ~ChunkedSegmentation();
+
+    /**
+     * @return The number of chunks.
+     * @draft ICU 65
+     */
+    int32_t getChunkCount() const;
+
+    /**
+     * Segments one chunk of the text.
+     * Different chunks may be segmented concurrently on different threads.
+     *
+     * @param chunkIndex The chunk index, from 0 to getChunkCount()-1.
+     * @param status     Receives error codes.
+     * @draft ICU 65
+     */
+    void segmentChunk(int32_t chunkIndex, UErrorCode &status);
+
+    /**
+     * Returns all of the boundaries of the text, the same as first() followed by next()
+     * up to the end of the text, and optionally their rule status values.
+     * All of the chunks must have been segmented.
+     * This function is not thread-safe.
+     *
+     * @param boundaries   An array to be filled in with the boundary positions.
+     *                     Can be NULL if capacity is 0 (for preflighting).
+     * @param ruleStatuses An array to be filled in with the getRuleStatus() values
+     *                     for each of the boundaries, or NULL if not needed.
+     *                     If not NULL, it must have the same capacity as boundaries.
+     * @param capacity     The capacity of the boundaries (and ruleStatuses) arrays.
+     *                     The text length plus one is always sufficient.
+     * @param status       Receives error codes; U_BUFFER_OVERFLOW_ERROR if the
+     *                     capacity is not sufficient, U_INVALID_STATE_ERROR if not all
+     *                     of the chunks have been segmented.
+     * @return The number of boundaries in the text.
+     * @draft ICU 65
+     */
+    int32_t getBoundaries(int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                          UErrorCode &status);
+
+private:
+    ChunkedSegmentation(const ChunkedSegmentation &other) = delete;
+    ChunkedSegmentation &operator=(const ChunkedSegmentation &other) = delete;
+
+    void join(UErrorCode &status);
+
+    UVector *fChunks;
+    int32_t fTextLength;
+    UBool fJoined;
+};
+#endif  /* U_HIDE_DRAFT_API */
+
 //------------------------------------------------------------------------------
 //
 //   Inline Functions Definitions ...
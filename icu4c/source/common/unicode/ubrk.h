@@ -623,6 +623,37 @@ ubrk_getBinaryRules(UBreakIterator *bi,
                     uint8_t *       binaryRules, int32_t rulesCapacity,
                     UErrorCode *    status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Advance the iterator over multiple boundaries at once, storing them into
+ * an array provided by the caller.
+ * This is equivalent to calling ubrk_next() (and ubrk_getRuleStatus()) repeatedly,
+ * but much faster for rule based break iterators.
+ * Boundaries are returned in ascending order, starting with the one following
+ * the current iteration position, and stopping before the first boundary that
+ * is greater than limit, at the end of the text, or when the array is full.
+ * The iterator is left at the last boundary that was returned.
+ *
+ * @param bi           The break iterator to use.
+ * @param limit        The text position after which no boundaries are returned.
+ *                     Use INT32_MAX to return all of the remaining boundaries.
+ * @param boundaries   An array to be filled in with the boundary positions.
+ * @param ruleStatuses An array to be filled in with the rule status values
+ *                     for each of the returned boundaries, or NULL if not needed.
+ *                     If not NULL, it must have the same capacity as boundaries.
+ * @param capacity     The capacity of the boundaries (and ruleStatuses) arrays.
+ * @param status       Receives error codes.
+ * @return The number of boundaries stored in the array; 0 when there are
+ *         no more boundaries up to the limit.
+ * @see ubrk_next
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ubrk_nextBoundaries(UBreakIterator *bi, int32_t limit,
+                    int32_t *boundaries, int32_t *ruleStatuses, int32_t capacity,
+                    UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
 
 #endif
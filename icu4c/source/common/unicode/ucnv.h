@@ -569,6 +569,69 @@ ucnv_safeClone(const UConverter *cnv,
 U_STABLE void  U_EXPORT2
 ucnv_close(UConverter * converter);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Returns a converter for the given name from a process-wide pool of
+ * converters that were returned with ucnv_release(), or opens a new one
+ * like ucnv_open() if none is available.
+ * Converters are pooled by their canonical name and options,
+ * so different aliases of a charset share pooled converters.
+ * Taking a converter from the pool does not allocate memory.
+ *
+ * A pooled converter is in the same state as a newly opened one:
+ * It was reset, and it has the default callbacks, substitution character
+ * and fallback setting.
+ *
+ * Converters whose behavior depends on a locale
+ * (ISO-2022, LMBCS and SCSU converters) are never pooled.
+ *
+ * Release the converter with ucnv_release() for reuse, or close it with ucnv_close().
+ *
+ * @param converterName name of the coded character set table, see ucnv_open()
+ * @param err outgoing error status <TT>U_MEMORY_ALLOCATION_ERROR, U_FILE_ACCESS_ERROR</TT>
+ * @return the converter, or NULL if an error occurred
+ * @see ucnv_open
+ * @see ucnv_release
+ * @see ucnv_getPoolStatistics
+ * @draft ICU 65
+ */
+U_DRAFT UConverter * U_EXPORT2
+ucnv_acquire(const char *converterName, UErrorCode *err);
+
+/**
+ * Returns a converter to the pool used by ucnv_acquire().
+ * The converter is reset and its callbacks, substitution character and
+ * fallback setting are restored to the defaults.
+ * If the pool is full, or if the converter is not poolable
+ * (for example a ucnv_safeClone() into a caller-provided buffer),
+ * then it is closed with ucnv_close().
+ *
+ * The caller must not use the converter after this call.
+ * ucnv_flushCache() closes all pooled converters.
+ *
+ * @param converter the converter object, may have been opened with
+ *                  ucnv_acquire(), ucnv_open() or ucnv_safeClone();
+ *                  NULL is ignored
+ * @see ucnv_acquire
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucnv_release(UConverter *converter);
+
+/**
+ * Returns the number of ucnv_acquire() calls that were satisfied
+ * from the converter pool (hits), and of those that had to open a new
+ * converter (misses), since the process started or since u_cleanup().
+ *
+ * @param pHits receives the number of pool hits, if not NULL
+ * @param pMisses receives the number of pool misses, if not NULL
+ * @see ucnv_acquire
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucnv_getPoolStatistics(int32_t *pHits, int32_t *pMisses);
+#endif  /* U_HIDE_DRAFT_API */
+
 #if U_SHOW_CPLUSPLUS_API
 
 U_NAMESPACE_BEGIN
@@ -1674,6 +1737,137 @@ ucnv_fromAlgorithmic(UConverter *cnv,
                      const char *source, int32_t sourceLength,
                      UErrorCode *pErrorCode);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * One task of a parallel conversion, see UConverterTaskRunner.
+ *
+ * @param taskContext   The taskContext that was passed to the UConverterTaskRunner.
+ * @param index         The index of the task, 0..count-1.
+ * @draft ICU 65
+ */
+typedef void U_CALLCONV
+UConverterParallelTask(void *taskContext, int32_t index);
+
+/**
+ * Function type for running tasks concurrently, for example on a thread pool.
+ * It is supplied by the caller of ucnv_convertParallel() and ucnv_toUCharsParallel().
+ *
+ * The function must call task(taskContext, i) exactly once for each i
+ * from 0 to count-1, in any order and on any threads,
+ * and it must return only after all of these calls have returned.
+ * A trivial implementation calls the task for each index in a loop.
+ *
+ * @param runnerContext The runnerContext that was passed into the ICU function.
+ * @param task          The task function.
+ * @param taskContext   Opaque pointer to be passed to each task call.
+ * @param count         The number of tasks.
+ * @draft ICU 65
+ */
+typedef void U_CALLCONV
+UConverterTaskRunner(const void *runnerContext,
+                     UConverterParallelTask *task, void *taskContext,
+                     int32_t count);
+
+/**
+ * Convert from one external charset to another, like ucnv_convert(),
+ * but splitting a large input into chunks that are converted concurrently.
+ *
+ * The source text is split only at boundaries where the conversion
+ * state is known to be the initial state, so that the result is the same
+ * as with serial conversion.
+ * This is possible for UTF-8, UTF-16BE/LE, UTF-32BE/LE, US-ASCII, ISO-8859-1,
+ * and for table-based (MBCS) charsets without SI/SO state and without
+ * multi-character extension mappings, on either side of the conversion.
+ * For other charsets (e.g., ISO-2022, HZ, SCSU, UTF-7, UTF-16 with BOM),
+ * for small inputs, and if runner is NULL,
+ * the text is converted serially in the calling thread.
+ *
+ * Both converters are reset before the conversion.
+ * For concurrent conversion, each chunk is converted with clones
+ * (see ucnv_safeClone()) of the two converters, which share their
+ * callback functions and contexts. Callbacks may therefore be called
+ * concurrently on the runner's threads.
+ * If conversion fails in several chunks, then the error
+ * of the first of those chunks is returned.
+ *
+ * Preflighting and NUL-termination work as for ucnv_convert().
+ * When preflighting concurrently, each chunk's output is still
+ * buffered temporarily.
+ *
+ * @param targetCnv     Output converter, used to convert from the UTF-16 pivot
+ *                      to the target.
+ * @param sourceCnv     Input converter, used to convert from the source to
+ *                      the UTF-16 pivot.
+ * @param target        Pointer to the output buffer.
+ * @param targetCapacity Capacity of the target, in bytes.
+ * @param source        Pointer to the input buffer.
+ * @param sourceLength  Length of the input text, in bytes, or -1 for NUL-terminated input.
+ * @param chunkLength   Approximate number of source bytes per chunk,
+ *                      or 0 for a default of 1MB.
+ * @param runner        Function that runs the chunk conversion tasks,
+ *                      or NULL for serial conversion.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ * @return Length of the complete output text in bytes, even if it exceeds the targetCapacity
+ *         and a U_BUFFER_OVERFLOW_ERROR is set.
+ *
+ * @see ucnv_convert
+ * @see ucnv_convertEx
+ * @see ucnv_toUCharsParallel
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_convertParallel(UConverter *targetCnv, UConverter *sourceCnv,
+                     char *target, int32_t targetCapacity,
+                     const char *source, int32_t sourceLength,
+                     int32_t chunkLength,
+                     UConverterTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode);
+
+/**
+ * Convert a codepage string into Unicode, like ucnv_toUChars(),
+ * but splitting a large input into chunks that are converted concurrently.
+ * Optionally writes the source index of each output UChar,
+ * like ucnv_toUnicode().
+ *
+ * See ucnv_convertParallel() for the charsets that can be converted
+ * concurrently and for how the chunks are converted.
+ *
+ * @param cnv           The converter object to be used.
+ * @param dest          Destination string buffer.
+ * @param destCapacity  Number of UChars available at dest.
+ * @param offsets       If not NULL, then it must point to an array of
+ *                      destCapacity integers which will be set to the
+ *                      index of the source byte of the character that produced
+ *                      each output UChar, or to -1.
+ * @param src           The input codepage string.
+ * @param srcLength     The length of the input string, or -1 if NUL-terminated.
+ * @param chunkLength   Approximate number of source bytes per chunk,
+ *                      or 0 for a default of 1MB.
+ * @param runner        Function that runs the chunk conversion tasks,
+ *                      or NULL for serial conversion.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ * @return the length of the output string, not counting the terminating NUL;
+ *         if the length is greater than destCapacity, then the string will not fit
+ *         and a buffer of the indicated length would need to be passed in
+ * @see ucnv_toUChars
+ * @see ucnv_convertParallel
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucnv_toUCharsParallel(UConverter *cnv,
+                      UChar *dest, int32_t destCapacity, int32_t *offsets,
+                      const char *src, int32_t srcLength,
+                      int32_t chunkLength,
+                      UConverterTaskRunner *runner, const void *runnerContext,
+                      UErrorCode *pErrorCode);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Frees up memory occupied by unused, cached converter shared data.
  *
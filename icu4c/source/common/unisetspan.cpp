@@ -479,6 +479,24 @@ matches16CPB(const UChar *s, int32_t start, int32_t limit, const UChar *t, int32
            !(length<limit && U16_IS_LEAD(s[length-1]) && U16_IS_TRAIL(s[length]));
 }
 
+/*
+ * Returns the index of the first set string whose first code unit is at least c.
+ * UnicodeSet strings are sorted in code unit order and are never empty.
+ */
+static int32_t
+findFirstString16(const UVector &strings, UChar c) {
+    int32_t start=0, limit=strings.size();
+    while(start<limit) {
+        int32_t i=(start+limit)/2;
+        if(((const UnicodeString *)strings.elementAt(i))->charAt(0)<c) {
+            start=i+1;
+        } else {
+            limit=i;
+        }
+    }
+    return start;
+}
+
 // Does the set contain the next code point?
 // If so, return its length; otherwise return its negative length.
 static inline int32_t
@@ -1356,12 +1374,18 @@ int32_t UnicodeSetStringSpan::spanNot(const UChar *s, int32_t length) const {
         }
 
         // Try to match the strings at pos.
-        for(i=0; i<stringsLength; ++i) {
+        // Only the strings that start with s[pos] can match,
+        // and they are adjacent because the set strings are sorted.
+        UChar lead=s[pos];
+        for(i=findFirstString16(strings, lead); i<stringsLength; ++i) {
+            const UnicodeString &string=*(const UnicodeString *)strings.elementAt(i);
+            const UChar *s16=string.getBuffer();
+            if(s16[0]!=lead) {
+                break;
+            }
             if(spanLengths[i]==ALL_CP_CONTAINED) {
                 continue;  // Irrelevant string.
             }
-            const UnicodeString &string=*(const UnicodeString *)strings.elementAt(i);
-            const UChar *s16=string.getBuffer();
             int32_t length16=string.length();
             if(length16<=rest && matches16CPB(s, pos, length, s16, length16)) {
                 return pos;  // There is a set element at pos.
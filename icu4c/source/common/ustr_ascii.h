@@ -0,0 +1,342 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+******************************************************************************
+*
+* File ustr_ascii.h
+*
+*   Inline block-copy and scanning helpers for runs of ASCII (and Latin-1)
+*   and other low code units, shared by the UTF-8/UTF-16 string transformation
+*   functions, the conversion code and the normalization fast paths.
+*
+*   Each function copies or skips the longest prefix of its input that satisfies
+*   the function's condition, up to the given length, and returns the number
+*   of units copied or skipped. The caller continues with its regular
+*   per-character code at the first unit that does not satisfy the condition.
+*
+*   Blocks of 16 units are processed with SSE2 on x86 and with NEON on
+*   AArch64; both instruction sets are part of the baseline of those
+*   architectures, so no runtime CPU detection is necessary.
+*   Elsewhere, 8-byte words are tested at a time.
+*   A build can define UPRV_HAVE_SSE2 or UPRV_HAVE_NEON to 0
+*   to use only the portable code.
+*
+******************************************************************************
+*/
+
+#ifndef USTR_ASCII_H
+#define USTR_ASCII_H
+
+#include "unicode/utypes.h"
+#include "cmemory.h"
+
+#ifndef UPRV_HAVE_SSE2
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define UPRV_HAVE_SSE2 1
+#   else
+#       define UPRV_HAVE_SSE2 0
+#   endif
+#endif
+
+#ifndef UPRV_HAVE_NEON
+#   if !UPRV_HAVE_SSE2 && defined(__aarch64__) && defined(__ARM_NEON)
+#       define UPRV_HAVE_NEON 1
+#   else
+#       define UPRV_HAVE_NEON 0
+#   endif
+#endif
+
+#if UPRV_HAVE_SSE2
+#   include <emmintrin.h>
+#elif UPRV_HAVE_NEON
+#   include <arm_neon.h>
+#endif
+
+/**
+ * Copies leading ASCII bytes (0..0x7f) to UTF-16.
+ * @param dest destination, must have room for length UChars
+ * @param src source bytes
+ * @param length maximum number of bytes to read and UChars to write
+ * @return number of ASCII bytes copied, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_copyASCIIToUChars(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        if(_mm_movemask_epi8(v) != 0) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if(vmaxvq_u8(v) >= 0x80) {
+            break;
+        }
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_high_u8(v));
+    }
+#else
+    for(; (length - i) >= 8; i += 8) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if((w & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+        for(int32_t j = 0; j < 8; ++j) {
+            dest[i + j] = src[i + j];
+        }
+    }
+#endif
+    while(i < length && src[i] <= 0x7f) {
+        dest[i] = src[i];
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Copies leading ASCII bytes (0..0x7f) to another byte buffer.
+ * @param dest destination, must have room for length bytes
+ * @param src source bytes
+ * @param length maximum number of bytes to read and write
+ * @return number of ASCII bytes copied, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_copyASCIIBytes(uint8_t *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        if(_mm_movemask_epi8(v) != 0) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), v);
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        if(vmaxvq_u8(v) >= 0x80) {
+            break;
+        }
+        vst1q_u8(dest + i, v);
+    }
+#else
+    for(; (length - i) >= 8; i += 8) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if((w & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+        uprv_memcpy(dest + i, &w, 8);
+    }
+#endif
+    while(i < length && src[i] <= 0x7f) {
+        dest[i] = src[i];
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Widens Latin-1 bytes to UTF-16 code units.
+ * @param dest destination, must have room for length UChars
+ * @param src source bytes
+ * @param length number of bytes to read and UChars to write
+ * @internal
+ */
+static inline void
+uprv_copyLatin1ToUChars(UChar *dest, const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i *)(dest + i + 8), _mm_unpackhi_epi8(v, zero));
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        uint8x16_t v = vld1q_u8(src + i);
+        vst1q_u16((uint16_t *)(dest + i), vmovl_u8(vget_low_u8(v)));
+        vst1q_u16((uint16_t *)(dest + i + 8), vmovl_high_u8(v));
+    }
+#endif
+    for(; i < length; ++i) {
+        dest[i] = src[i];
+    }
+}
+
+/**
+ * Copies leading Latin-1 code points (U+0000..U+00FF) from UTF-16 to bytes.
+ * @param dest destination, must have room for length bytes
+ * @param src source UChars
+ * @param length maximum number of UChars to read and bytes to write
+ * @param max 0x7f to copy only ASCII, or 0xff to copy all Latin-1 code points
+ * @return number of UChars copied, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_copyUCharsBelow(uint8_t *dest, const UChar *src, int32_t length, UChar max) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    // Any bit outside of max, which is 2^n-1.
+    const __m128i outside = _mm_set1_epi16((short)(0xffff & ~max));
+    const __m128i zero = _mm_setzero_si128();
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v1 = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i v2 = _mm_loadu_si128((const __m128i *)(src + i + 8));
+        __m128i bad = _mm_and_si128(_mm_or_si128(v1, v2), outside);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(bad, zero)) != 0xffff) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)(dest + i), _mm_packus_epi16(v1, v2));
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        uint16x8_t v1 = vld1q_u16((const uint16_t *)(src + i));
+        uint16x8_t v2 = vld1q_u16((const uint16_t *)(src + i + 8));
+        if(vmaxvq_u16(vorrq_u16(v1, v2)) > max) {
+            break;
+        }
+        vst1q_u8(dest + i, vcombine_u8(vmovn_u16(v1), vmovn_u16(v2)));
+    }
+#else
+    const uint64_t outside = 0x0001000100010001ULL * (uint16_t)~max;
+    for(; (length - i) >= 4; i += 4) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if((w & outside) != 0) {
+            break;
+        }
+        for(int32_t j = 0; j < 4; ++j) {
+            dest[i + j] = (uint8_t)src[i + j];
+        }
+    }
+#endif
+    while(i < length && src[i] <= max) {
+        dest[i] = (uint8_t)src[i];
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Counts leading ASCII bytes (0..0x7f).
+ * @param src source bytes
+ * @param length maximum number of bytes to read
+ * @return number of leading ASCII bytes, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_countASCII(const uint8_t *src, int32_t length) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    for(; (length - i) >= 16; i += 16) {
+        if(_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(src + i))) != 0) {
+            break;
+        }
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        if(vmaxvq_u8(vld1q_u8(src + i)) >= 0x80) {
+            break;
+        }
+    }
+#else
+    for(; (length - i) >= 8; i += 8) {
+        uint64_t w;
+        uprv_memcpy(&w, src + i, 8);
+        if((w & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+#endif
+    while(i < length && src[i] <= 0x7f) {
+        ++i;
+    }
+    return i;
+}
+
+
+/**
+ * Counts leading UChars below a bound.
+ * @param src source UChars
+ * @param length maximum number of UChars to read
+ * @param bound the first code unit value that ends the run
+ * @return number of leading UChars less than bound, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_countUCharsBelow(const UChar *src, int32_t length, UChar bound) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    // SSE2 only has signed 16-bit comparisons; flip the sign bits.
+    const __m128i signBits = _mm_set1_epi16((short)0x8000);
+    const __m128i signedBound = _mm_set1_epi16((short)(bound ^ 0x8000));
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(src + i)), signBits);
+        __m128i v2 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(src + i + 8)), signBits);
+        __m128i below = _mm_and_si128(_mm_cmplt_epi16(v1, signedBound),
+                                      _mm_cmplt_epi16(v2, signedBound));
+        if(_mm_movemask_epi8(below) != 0xffff) {
+            break;
+        }
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        uint16x8_t v1 = vld1q_u16((const uint16_t *)(src + i));
+        uint16x8_t v2 = vld1q_u16((const uint16_t *)(src + i + 8));
+        if(vmaxvq_u16(vmaxq_u16(v1, v2)) >= bound) {
+            break;
+        }
+    }
+#endif
+    while(i < length && src[i] < bound) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * Counts leading bytes below a bound.
+ * @param src source bytes
+ * @param length maximum number of bytes to read
+ * @param bound the first byte value that ends the run
+ * @return number of leading bytes less than bound, 0..length
+ * @internal
+ */
+static inline int32_t
+uprv_countBytesBelow(const uint8_t *src, int32_t length, uint8_t bound) {
+    int32_t i = 0;
+#if UPRV_HAVE_SSE2
+    // SSE2 only has signed 8-bit comparisons; flip the sign bits.
+    const __m128i signBits = _mm_set1_epi8((char)0x80);
+    const __m128i signedBound = _mm_set1_epi8((char)(bound ^ 0x80));
+    for(; (length - i) >= 16; i += 16) {
+        __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(src + i)), signBits);
+        if(_mm_movemask_epi8(_mm_cmplt_epi8(v, signedBound)) != 0xffff) {
+            break;
+        }
+    }
+#elif UPRV_HAVE_NEON
+    for(; (length - i) >= 16; i += 16) {
+        if(vmaxvq_u8(vld1q_u8(src + i)) >= bound) {
+            break;
+        }
+    }
+#endif
+    while(i < length && src[i] < bound) {
+        ++i;
+    }
+    return i;
+}
+
+#endif
@@ -82,6 +82,18 @@ u_terminateUChar32s(UChar32 *dest, int32_t destCapacity, int32_t length, UErrorC
 U_CAPI int32_t U_EXPORT2
 u_terminateWChars(wchar_t *dest, int32_t destCapacity, int32_t length, UErrorCode *pErrorCode);
 
+struct UText;
+
+/**
+ * If the UText was opened with utext_openUTF8(), returns its UTF-8 string
+ * and sets *pLength to the string length.
+ * (Scans for the terminating NUL if the length is not yet known.)
+ * Otherwise returns NULL.
+ * For code that can work directly on the UTF-8 bytes.
+ */
+U_CAPI const char * U_EXPORT2
+utext_getUTF8Contents(struct UText *ut, int32_t *pLength);
+
 /**
  * Counts the bytes of any whole valid sequence for a UTF-8 lead byte.
  * Returns 1 for ASCII 0..0x7f.
@@ -34,6 +34,7 @@
 #include "cstring.h"
 #include "cmemory.h"
 #include "ustr_imp.h"
+#include "ustr_ascii.h"
 #include "uassert.h"
 
 U_CAPI UChar* U_EXPORT2 
@@ -403,6 +404,17 @@ u_strFromUTF8WithSub(UChar *dest,
                 c = (uint8_t)src[i++];
                 if(U8_IS_SINGLE(c)) {
                     *pDest++=(UChar)c;
+                    if(count > 16) {
+                        /*
+                         * Copy a following run of ASCII bytes in blocks.
+                         * Each ASCII byte counts as one iteration of this loop,
+                         * so the source and destination limits are still observed.
+                         */
+                        int32_t n = uprv_copyASCIIToUChars(pDest, (const uint8_t *)src + i, count - 1);
+                        i += n;
+                        pDest += n;
+                        count -= n;
+                    }
                 } else {
                     uint8_t __t1, __t2;
                     if( /* handle U+0800..U+FFFF inline */
@@ -491,7 +503,10 @@ u_strFromUTF8WithSub(UChar *dest,
             // modified copy of U8_NEXT()
             c = (uint8_t)src[i++];
             if(U8_IS_SINGLE(c)) {
-                ++reqLength;
+                /* count this byte and a following run of ASCII bytes */
+                int32_t n = uprv_countASCII((const uint8_t *)src + i, srcLength - i);
+                i += n;
+                reqLength += n + 1;
             } else {
                 uint8_t __t1, __t2;
                 if( /* handle U+0800..U+FFFF inline */
@@ -690,6 +705,10 @@ u_strFromUTF8Lenient(UChar *dest,
                      * resynchronization after illegal sequences.
                      */
                     *pDest++=(UChar)ch;
+                    /* copy a following run of ASCII bytes in blocks */
+                    int32_t n = uprv_copyASCIIToUChars(pDest, pSrc, (int32_t)(pSrcLimit - pSrc));
+                    pSrc += n;
+                    pDest += n;
                 } else if(ch < 0xe0) { /* U+0080..U+07FF */
                     /* 0x3080 = (0xc0 << 6) + 0x80 */
                     *pDest++ = (UChar)((ch << 6) + *pSrc++ - 0x3080);
@@ -921,6 +940,17 @@ u_strToUTF8WithSub(char *dest,
                 ch=*pSrc++;
                 if(ch <= 0x7f) {
                     *pDest++ = (uint8_t)ch;
+                    if(count > 16) {
+                        /*
+                         * Copy a following run of ASCII characters in blocks.
+                         * Each of them counts as one iteration of this loop,
+                         * so the source and destination limits are still observed.
+                         */
+                        int32_t n = uprv_copyUCharsBelow(pDest, pSrc, count - 1, 0x7f);
+                        pSrc += n;
+                        pDest += n;
+                        count -= n;
+                    }
                 } else if(ch <= 0x7ff) {
                     *pDest++=(uint8_t)((ch>>6)|0xc0);
                     *pDest++=(uint8_t)((ch&0x3f)|0x80);
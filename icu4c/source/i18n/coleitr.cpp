@@ -137,6 +137,51 @@ int32_t CollationElementIterator::next(UErrorCode& status)
     return firstHalf;
 }
 
+int32_t CollationElementIterator::nextCEs(int32_t limitOffset,
+                                          int64_t *ces, int32_t *offsets, int32_t capacity,
+                                          UErrorCode& status)
+{
+    if (U_FAILURE(status)) { return 0; }
+    if (capacity < 0 || (ces == NULL && capacity > 0)) {
+        status = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    if (dir_ < 0) {
+        // illegal change of direction
+        status = U_INVALID_STATE_ERROR;
+        return 0;
+    }
+    dir_ = 2;
+    otherHalf_ = 0;
+    if (limitOffset < 0 || limitOffset > string_.length()) {
+        limitOffset = string_.length();
+    }
+    // Call the virtual getOffset() once per text segment, not once per CE:
+    // Buffered expansion CEs share the limit offset of their segment,
+    // and the limit of one segment is the start of the next one.
+    int32_t offset = iter_->getOffset();
+    int32_t length = 0;
+    while (length < capacity) {
+        iter_->clearCEsIfNoneRemaining();
+        int64_t ce;
+        if (iter_->getCEsLength() == 0) {
+            if (offset >= limitOffset) { break; }
+            ce = iter_->nextCE(status);
+            if (ce == Collation::NO_CE) { break; }
+            offset = iter_->getOffset();
+        } else {
+            ce = iter_->nextCE(status);
+        }
+        ces[length] = ce;
+        if (offsets != NULL) {
+            offsets[length] = offset;
+        }
+        ++length;
+    }
+    if (U_FAILURE(status)) { return 0; }
+    return length;
+}
+
 UBool CollationElementIterator::operator!=(
                                   const CollationElementIterator& other) const
 {
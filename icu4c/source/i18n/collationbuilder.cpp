@@ -40,6 +40,7 @@
 #include "collationroot.h"
 #include "collationrootelements.h"
 #include "collationruleparser.h"
+#include "collationrulescache.h"
 #include "collationsettings.h"
 #include "collationtailoring.h"
 #include "collationweights.h"
@@ -161,24 +162,37 @@ RuleBasedCollator::internalBuildTailoring(const UnicodeString &rules,
                                           UColAttributeValue decompositionMode,
                                           UParseError *outParseError, UnicodeString *outReason,
                                           UErrorCode &errorCode) {
-    const CollationTailoring *base = CollationRoot::getRoot(errorCode);
     if(U_FAILURE(errorCode)) { return; }
     if(outReason != NULL) { outReason->remove(); }
-    CollationBuilder builder(base, errorCode);
-    UVersionInfo noVersion = { 0, 0, 0, 0 };
-    BundleImporter importer;
-    LocalPointer<CollationTailoring> t(builder.parseAndBuild(rules, noVersion,
-                                                             &importer,
-                                                             outParseError, errorCode));
-    if(U_FAILURE(errorCode)) {
-        const char *reason = builder.getErrorReason();
-        if(reason != NULL && outReason != NULL) {
-            *outReason = UnicodeString(reason, -1, US_INV);
+    // Share the tailoring with other collators built from the same rules.
+    // If that fails, then build the rules again for the parse error details.
+    UErrorCode cacheErrorCode = U_ZERO_ERROR;
+    const CollationCacheEntry *entry = CollationRulesCache::getCacheEntry(rules, cacheErrorCode);
+    if(entry != NULL) {
+        if(outParseError != NULL) {
+            // Same as after parsing without errors.
+            outParseError->line = 0;
+            outParseError->offset = -1;
+            outParseError->preContext[0] = 0;
+            outParseError->postContext[0] = 0;
         }
-        return;
+        U_ASSERT(settings == NULL && data == NULL && tailoring == NULL && cacheEntry == NULL);
+        tailoring = entry->tailoring;
+        data = tailoring->data;
+        settings = tailoring->settings;
+        settings->addRef();
+        cacheEntry = entry;  // The cache added a reference for us.
+        validLocale = entry->validLocale;
+        actualLocaleIsSameAsValid = FALSE;
+    } else {
+        const CollationTailoring *base = CollationRoot::getRoot(errorCode);
+        if(U_FAILURE(errorCode)) { return; }
+        LocalPointer<CollationTailoring> t(CollationBuilder::buildTailoring(
+                base, rules, outParseError, outReason, errorCode));
+        if(U_FAILURE(errorCode)) { return; }
+        t->actualLocale.setToBogus();
+        adoptTailoring(t.orphan(), errorCode);
     }
-    t->actualLocale.setToBogus();
-    adoptTailoring(t.orphan(), errorCode);
     // Set attributes after building the collator,
     // to keep the default settings consistent with the rule string.
     if(strength != UCOL_DEFAULT) {
@@ -229,6 +243,29 @@ CollationBuilder::~CollationBuilder() {
     delete dataBuilder;
 }
 
+CollationTailoring *
+CollationBuilder::buildTailoring(const CollationTailoring *base,
+                                 const UnicodeString &ruleString,
+                                 UParseError *outParseError,
+                                 UnicodeString *outReason,
+                                 UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+    CollationBuilder builder(base, errorCode);
+    UVersionInfo noVersion = { 0, 0, 0, 0 };
+    BundleImporter importer;
+    CollationTailoring *t = builder.parseAndBuild(ruleString, noVersion,
+                                                  &importer,
+                                                  outParseError, errorCode);
+    if(U_FAILURE(errorCode)) {
+        const char *reason = builder.getErrorReason();
+        if(reason != NULL && outReason != NULL) {
+            *outReason = UnicodeString(reason, -1, US_INV);
+        }
+        return NULL;
+    }
+    return t;
+}
+
 CollationTailoring *
 CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
                                 const UVersionInfo rulesVersion,
@@ -284,6 +321,9 @@ CollationBuilder::parseAndBuild(const UnicodeString &ruleString,
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
         tailoring->data, ownedSettings,
         ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::getScriptOptions(
+        tailoring->data, ownedSettings,
+        ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
     tailoring->rules = ruleString;
     tailoring->rules.getTerminatedBuffer();  // ensure NUL-termination
     tailoring->setVersion(base->version, rulesVersion);
@@ -52,6 +52,17 @@ class U_I18N_API CollationBuilder : public CollationRuleParser::Sink {
 
     const char *getErrorReason() const { return errorReason; }
 
+    /**
+     * Builds a tailoring from a rule string,
+     * importing other tailorings from the resource bundles.
+     * Sets *outReason (if not NULL) when the rules fail to build.
+     */
+    static CollationTailoring *buildTailoring(const CollationTailoring *base,
+                                              const UnicodeString &ruleString,
+                                              UParseError *outParseError,
+                                              UnicodeString *outReason,
+                                              UErrorCode &errorCode);
+
 private:
     friend class CEFinalizer;
 
@@ -63,7 +63,9 @@ struct U_I18N_API CollationData : public UMemory {
               unsafeBackwardSet(NULL),
               fastLatinTable(NULL), fastLatinTableLength(0),
               numScripts(0), scriptsIndex(NULL), scriptStarts(NULL), scriptStartsLength(0),
-              rootElements(NULL), rootElementsLength(0) {}
+              rootElements(NULL), rootElementsLength(0) {
+        fastScriptTables[0] = fastScriptTables[1] = NULL;
+    }
 
     uint32_t getCE32(UChar32 c) const {
         return UTRIE2_GET32(trie, c);
@@ -213,6 +215,12 @@ struct U_I18N_API CollationData : public UMemory {
      */
     const uint16_t *fastLatinTable;
     int32_t fastLatinTableLength;
+    /**
+     * Fast tables for Greek and Cyrillic text, in the fast Latin format,
+     * indexed by CollationFastLatin::SCRIPT_TABLE_GREEK etc.
+     * Built at load time; NULL if not available.
+     */
+    const uint16_t *fastScriptTables[2];
 
     /**
      * Data for scripts and reordering groups.
@@ -283,7 +283,7 @@ CollationDataBuilder::CollationDataBuilder(UErrorCode &errorCode)
           trie(NULL),
           ce32s(errorCode), ce64s(errorCode), conditionalCE32s(errorCode),
           modified(FALSE),
-          fastLatinEnabled(FALSE), fastLatinBuilder(NULL),
+          fastLatinEnabled(FALSE), fastLatinBuilder(NULL), fastScriptTablesMemory(NULL),
           collIter(NULL) {
     // Reserve the first CE32 for U+0000.
     ce32s.addElement(0, errorCode);
@@ -293,6 +293,7 @@ CollationDataBuilder::CollationDataBuilder(UErrorCode &errorCode)
 CollationDataBuilder::~CollationDataBuilder() {
     utrie2_close(trie);
     delete fastLatinBuilder;
+    uprv_free(fastScriptTablesMemory);
     delete collIter;
 }
 
@@ -1500,7 +1501,11 @@ CollationDataBuilder::buildFastLatinTable(CollationData &data, UErrorCode &error
     } else {
         delete fastLatinBuilder;
         fastLatinBuilder = NULL;
+        return;
     }
+
+    uprv_free(fastScriptTablesMemory);
+    fastScriptTablesMemory = CollationFastLatinBuilder::buildScriptTables(data, errorCode);
 }
 
 int32_t
@@ -249,6 +249,7 @@ class U_I18N_API CollationDataBuilder : public UObject {
 
     UBool fastLatinEnabled;
     CollationFastLatinBuilder *fastLatinBuilder;
+    uint16_t *fastScriptTablesMemory;
 
     DataBuilderCollationIterator *collIter;
 };
@@ -16,6 +16,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/ucol.h"
+#include "unicode/utf8.h"
 #include "collationdata.h"
 #include "collationfastlatin.h"
 #include "collationsettings.h"
@@ -31,21 +32,76 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
     U_ASSERT(capacity == LATIN_LIMIT);
     if(capacity != LATIN_LIMIT) { return -1; }
 
-    uint32_t miniVarTop;
+    int32_t miniVarTop = getMiniVarTop(table, settings);
+    if(miniVarTop < 0) { return -1; }
+
+    UBool digitsAreReordered = FALSE;
+    if(!checkReordering(data, settings, USCRIPT_LATIN, digitsAreReordered)) {
+        return -1;
+    }
+
+    table += (table[0] & 0xff);  // skip the header
+    for(UChar32 c = 0; c < LATIN_LIMIT; ++c) {
+        uint32_t p = table[c];
+        if(p >= MIN_SHORT) {
+            p &= SHORT_PRIMARY_MASK;
+        } else if(p > (uint32_t)miniVarTop) {
+            p &= LONG_PRIMARY_MASK;
+        } else {
+            p = 0;
+        }
+        primaries[c] = (uint16_t)p;
+    }
+    if(digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
+        // Bail out for digits.
+        for(UChar32 c = 0x30; c <= 0x39; ++c) { primaries[c] = 0; }
+    }
+
+    // Shift the miniVarTop above other options.
+    return (miniVarTop << 16) | settings.options;
+}
+
+void
+CollationFastLatin::getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                     int32_t *options, int32_t capacity) {
+    U_ASSERT(capacity == NUM_SCRIPT_TABLES);
+    for(int32_t i = 0; i < capacity; ++i) {
+        options[i] = -1;
+        const uint16_t *table = i < NUM_SCRIPT_TABLES ? data->fastScriptTables[i] : NULL;
+        if(table == NULL) { continue; }
+        int32_t miniVarTop = getMiniVarTop(table, settings);
+        if(miniVarTop < 0) { continue; }
+        // Script tables do not precompute primary weights,
+        // so they cannot override the mini CEs of reordered digits,
+        // and the primary-level loop does not check for numeric collation.
+        UBool digitsAreReordered = FALSE;
+        if(!checkReordering(data, settings, getScriptCode(i), digitsAreReordered) ||
+                digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
+            continue;
+        }
+        options[i] = (miniVarTop << 16) | settings.options;
+    }
+}
+
+int32_t
+CollationFastLatin::getMiniVarTop(const uint16_t *table, const CollationSettings &settings) {
     if((settings.options & CollationSettings::ALTERNATE_MASK) == 0) {
         // No mini primaries are variable, set a variableTop just below the
         // lowest long mini primary.
-        miniVarTop = MIN_LONG - 1;
+        return MIN_LONG - 1;
     } else {
         int32_t headerLength = *table & 0xff;
         int32_t i = 1 + settings.getMaxVariable();
         if(i >= headerLength) {
             return -1;  // variableTop >= digits, should not occur
         }
-        miniVarTop = table[i];
+        return table[i];
     }
+}
 
-    UBool digitsAreReordered = FALSE;
+UBool
+CollationFastLatin::checkReordering(const CollationData *data, const CollationSettings &settings,
+                                    int32_t script, UBool &digitsAreReordered) {
     if(settings.hasReordering()) {
         uint32_t prevStart = 0;
         uint32_t beforeDigitStart = 0;
@@ -61,8 +117,8 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 digitStart = start;
             } else if(start != 0) {
                 if(start < prevStart) {
-                    // The permutation affects the groups up to Latin.
-                    return -1;
+                    // The permutation affects the groups up to the script.
+                    return FALSE;
                 }
                 // In the future, there might be a special group between digits & Latin.
                 if(digitStart != 0 && afterDigitStart == 0 && prevStart == beforeDigitStart) {
@@ -71,38 +127,19 @@ CollationFastLatin::getOptions(const CollationData *data, const CollationSetting
                 prevStart = start;
             }
         }
-        uint32_t latinStart = data->getFirstPrimaryForGroup(USCRIPT_LATIN);
-        latinStart = settings.reorder(latinStart);
-        if(latinStart < prevStart) {
-            return -1;
+        uint32_t scriptStart = data->getFirstPrimaryForGroup(script);
+        scriptStart = settings.reorder(scriptStart);
+        if(scriptStart < prevStart) {
+            return FALSE;
         }
         if(afterDigitStart == 0) {
-            afterDigitStart = latinStart;
+            afterDigitStart = scriptStart;
         }
         if(!(beforeDigitStart < digitStart && digitStart < afterDigitStart)) {
             digitsAreReordered = TRUE;
         }
     }
-
-    table += (table[0] & 0xff);  // skip the header
-    for(UChar32 c = 0; c < LATIN_LIMIT; ++c) {
-        uint32_t p = table[c];
-        if(p >= MIN_SHORT) {
-            p &= SHORT_PRIMARY_MASK;
-        } else if(p > miniVarTop) {
-            p &= LONG_PRIMARY_MASK;
-        } else {
-            p = 0;
-        }
-        primaries[c] = (uint16_t)p;
-    }
-    if(digitsAreReordered || (settings.options & CollationSettings::NUMERIC) != 0) {
-        // Bail out for digits.
-        for(UChar32 c = 0x30; c <= 0x39; ++c) { primaries[c] = 0; }
-    }
-
-    // Shift the miniVarTop above other options.
-    return ((int32_t)miniVarTop << 16) | settings.options;
+    return TRUE;
 }
 
 int32_t
@@ -795,6 +832,283 @@ CollationFastLatin::compareUTF8(const uint16_t *table, const uint16_t *primaries
     return UCOL_EQUAL;
 }
 
+namespace {
+
+/** The script fastpath does not precompute primary weights. */
+const uint16_t noPrimaries[CollationFastLatin::LATIN_LIMIT] = { 0 };
+
+/**
+ * Capacity of each of the stack buffers for comparing below the primary level.
+ * Longer strings use the regular comparison.
+ */
+const int32_t SCRIPT_BUFFER_CAPACITY = 256;
+
+// Special values returned by the ScriptText classes.
+const int32_t UNSUPPORTED_CHAR = -1;
+const int32_t END_OF_TEXT = -2;
+
+inline UBool isPunct(UChar32 c) {
+    return CollationFastLatin::PUNCT_START <= c && c < CollationFastLatin::PUNCT_LIMIT;
+}
+
+/**
+ * Maps c into the char layout of the fast script table with the blockStart.
+ * Returns UNSUPPORTED_CHAR if c is not supported.
+ * ASCII and punctuation are looked up by their code points,
+ * as are U+FFFE and U+FFFF which the compare functions handle specially.
+ */
+inline int32_t
+toScriptChar(UChar blockStart, UChar32 c) {
+    if((0 <= c && c < 0x80) || isPunct(c) || c == 0xfffe || c == 0xffff) {
+        return c;
+    } else if(blockStart <= c && c < (blockStart + CollationFastLatin::SCRIPT_BLOCK_LENGTH)) {
+        return c - (blockStart - 0x80);
+    } else {
+        return UNSUPPORTED_CHAR;
+    }
+}
+
+/**
+ * Iterates over UTF-16 text and maps it into the char layout of a fast script table.
+ */
+class ScriptText16 {
+public:
+    ScriptText16(UChar blockStart, const UChar *s, int32_t length)
+            : index(0), blockStart(blockStart), s(s), length(length) {}
+
+    /**
+     * Returns the next character in the script table layout,
+     * END_OF_TEXT or UNSUPPORTED_CHAR.
+     */
+    inline int32_t next() {
+        if(index == length) { return END_OF_TEXT; }
+        UChar c = s[index];
+        if(c == 0 && length < 0) { return END_OF_TEXT; }
+        ++index;
+        return toScriptChar(blockStart, c);
+    }
+
+    /**
+     * Writes the whole text in the script table layout into dest.
+     * Returns its length, or -1 if the text does not fit or contains unsupported characters.
+     */
+    int32_t toScriptChars(UChar *dest, int32_t capacity) {
+        index = 0;
+        int32_t destLength = 0;
+        int32_t c;
+        while((c = next()) >= 0) {
+            if(destLength == capacity) { return -1; }
+            dest[destLength++] = (UChar)c;
+        }
+        return c == END_OF_TEXT ? destLength : -1;
+    }
+
+    int32_t index;
+
+private:
+    UChar blockStart;
+    const UChar *s;
+    int32_t length;
+};
+
+/**
+ * Iterates over UTF-8 text and maps it into the char layout of a fast script table.
+ * Ill-formed sequences are unsupported.
+ */
+class ScriptText8 {
+public:
+    ScriptText8(UChar blockStart, const uint8_t *s, int32_t length)
+            : index(0), blockStart(blockStart), s(s), length(length) {}
+
+    inline int32_t next() {
+        if(index == length) { return END_OF_TEXT; }
+        UChar32 c = s[index];
+        if(c < 0x80) {
+            if(c == 0 && length < 0) { return END_OF_TEXT; }
+            ++index;
+            return c;
+        }
+        U8_NEXT(s, index, length, c);
+        return toScriptChar(blockStart, c);
+    }
+
+    int32_t toScriptChars(UChar *dest, int32_t capacity) {
+        index = 0;
+        int32_t destLength = 0;
+        int32_t c;
+        while((c = next()) >= 0) {
+            if(destLength == capacity) { return -1; }
+            dest[destLength++] = (UChar)c;
+        }
+        return c == END_OF_TEXT ? destLength : -1;
+    }
+
+    int32_t index;
+
+private:
+    UChar blockStart;
+    const uint8_t *s;
+    int32_t length;
+};
+
+/**
+ * Returns the fast script table for the first character
+ * that is neither ASCII nor U+2000..U+203F punctuation,
+ * or -1 if there is no such character or it is not in one of the script blocks.
+ */
+int32_t
+findScriptTable(const UChar *s, int32_t length) {
+    for(int32_t i = 0; i != length; ++i) {
+        UChar c = s[i];
+        if(c >= 0x80 && !isPunct(c)) {
+            return CollationFastLatin::getScriptTable(c);
+        } else if(c == 0 && length < 0) {
+            break;
+        }
+    }
+    return -1;
+}
+
+int32_t
+findScriptTable(const uint8_t *s, int32_t length) {
+    for(int32_t i = 0; i != length;) {
+        UChar32 c;
+        U8_NEXT(s, i, length, c);
+        if(c < 0 || (c == 0 && length < 0)) {
+            break;
+        } else if(c >= 0x80 && !isPunct(c)) {
+            return CollationFastLatin::getScriptTable(c);
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+template<typename Text>
+uint32_t
+CollationFastLatin::nextScriptPair(const uint16_t *table, uint32_t variableTop, Text &text) {
+    int32_t c = text.next();
+    if(c < 0) { return c == END_OF_TEXT ? EOS : BAIL_OUT; }
+    uint32_t ce = c <= LATIN_MAX ? table[c] : lookup(table, c);
+    if(ce >= MIN_SHORT) {
+        return ce & SHORT_PRIMARY_MASK;
+    } else if(ce > variableTop) {
+        return ce & LONG_PRIMARY_MASK;
+    } else if(ce >= MIN_LONG) {
+        return 0;  // variable
+    } else if(ce >= CONTRACTION) {
+        // nextPair() looks at the one following character of a contraction.
+        UChar next16 = 0;
+        int32_t nextIndex = 0, nextLength = 0;
+        int32_t textIndex = text.index;
+        if(ce < EXPANSION) {
+            int32_t c2 = text.next();
+            if(c2 == UNSUPPORTED_CHAR) { return BAIL_OUT; }
+            if(c2 >= 0) {
+                next16 = (UChar)c2;
+                nextLength = 1;
+            }
+        }
+        uint32_t pair = nextPair(table, c, ce, &next16, NULL, nextIndex, nextLength);
+        if(pair == BAIL_OUT) { return BAIL_OUT; }
+        if(nextIndex == 0) { text.index = textIndex; }  // The next character was not consumed.
+        return getPrimaries(variableTop, pair);
+    }
+    return ce;  // completely ignorable, or special mini CE
+}
+
+template<typename Text>
+int32_t
+CollationFastLatin::compareScriptPrimaries(const uint16_t *table, uint32_t variableTop,
+                                           Text &left, Text &right) {
+    // Like the primary-level loop in compareUTF16(),
+    // but with lazy mapping of the text into the script table layout.
+    uint32_t leftPair = 0, rightPair = 0;
+    for(;;) {
+        while(leftPair == 0) {
+            leftPair = nextScriptPair(table, variableTop, left);
+        }
+        if(leftPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
+        while(rightPair == 0) {
+            rightPair = nextScriptPair(table, variableTop, right);
+        }
+        if(rightPair == BAIL_OUT) { return BAIL_OUT_RESULT; }
+
+        if(leftPair == rightPair) {
+            if(leftPair == EOS) { return UCOL_EQUAL; }
+            leftPair = rightPair = 0;
+            continue;
+        }
+        uint32_t leftPrimary = leftPair & 0xffff;
+        uint32_t rightPrimary = rightPair & 0xffff;
+        if(leftPrimary != rightPrimary) {
+            // Return the primary difference.
+            return (leftPrimary < rightPrimary) ? UCOL_LESS : UCOL_GREATER;
+        }
+        if(leftPair == EOS) { return UCOL_EQUAL; }
+        leftPair >>= 16;
+        rightPair >>= 16;
+    }
+}
+
+int32_t
+CollationFastLatin::compareScriptsUTF16(const uint16_t *const tables[], const int32_t options[],
+                                        const UChar *left, int32_t leftLength,
+                                        const UChar *right, int32_t rightLength) {
+    int32_t scriptTable = findScriptTable(left, leftLength);
+    if(scriptTable < 0) {
+        scriptTable = findScriptTable(right, rightLength);
+        if(scriptTable < 0) { return BAIL_OUT_RESULT; }
+    }
+    int32_t scriptOptions = options[scriptTable];
+    if(scriptOptions < 0) { return BAIL_OUT_RESULT; }
+    const uint16_t *table = tables[scriptTable];
+    UChar blockStart = getScriptBlockStart(scriptTable);
+    ScriptText16 leftText(blockStart, left, leftLength);
+    ScriptText16 rightText(blockStart, right, rightLength);
+    // Most strings differ in their primary weights. Compare those without copying the text.
+    int32_t result = compareScriptPrimaries(table + (table[0] & 0xff),
+                                            (uint32_t)scriptOptions >> 16, leftText, rightText);
+    if(result != UCOL_EQUAL) { return result; }
+    UChar left16[SCRIPT_BUFFER_CAPACITY];
+    UChar right16[SCRIPT_BUFFER_CAPACITY];
+    leftLength = leftText.toScriptChars(left16, SCRIPT_BUFFER_CAPACITY);
+    if(leftLength < 0) { return BAIL_OUT_RESULT; }
+    rightLength = rightText.toScriptChars(right16, SCRIPT_BUFFER_CAPACITY);
+    if(rightLength < 0) { return BAIL_OUT_RESULT; }
+    return compareUTF16(table, noPrimaries, scriptOptions,
+                        left16, leftLength, right16, rightLength);
+}
+
+int32_t
+CollationFastLatin::compareScriptsUTF8(const uint16_t *const tables[], const int32_t options[],
+                                       const uint8_t *left, int32_t leftLength,
+                                       const uint8_t *right, int32_t rightLength) {
+    int32_t scriptTable = findScriptTable(left, leftLength);
+    if(scriptTable < 0) {
+        scriptTable = findScriptTable(right, rightLength);
+        if(scriptTable < 0) { return BAIL_OUT_RESULT; }
+    }
+    int32_t scriptOptions = options[scriptTable];
+    if(scriptOptions < 0) { return BAIL_OUT_RESULT; }
+    const uint16_t *table = tables[scriptTable];
+    UChar blockStart = getScriptBlockStart(scriptTable);
+    ScriptText8 leftText(blockStart, left, leftLength);
+    ScriptText8 rightText(blockStart, right, rightLength);
+    int32_t result = compareScriptPrimaries(table + (table[0] & 0xff),
+                                            (uint32_t)scriptOptions >> 16, leftText, rightText);
+    if(result != UCOL_EQUAL) { return result; }
+    UChar left16[SCRIPT_BUFFER_CAPACITY];
+    UChar right16[SCRIPT_BUFFER_CAPACITY];
+    leftLength = leftText.toScriptChars(left16, SCRIPT_BUFFER_CAPACITY);
+    if(leftLength < 0) { return BAIL_OUT_RESULT; }
+    rightLength = rightText.toScriptChars(right16, SCRIPT_BUFFER_CAPACITY);
+    if(rightLength < 0) { return BAIL_OUT_RESULT; }
+    return compareUTF16(table, noPrimaries, scriptOptions,
+                        left16, leftLength, right16, rightLength);
+}
+
 uint32_t
 CollationFastLatin::lookup(const uint16_t *table, UChar32 c) {
     U_ASSERT(c > LATIN_MAX);
@@ -18,6 +18,8 @@
 
 #if !UCONFIG_NO_COLLATION
 
+#include "unicode/uscript.h"
+
 U_NAMESPACE_BEGIN
 
 struct CollationData;
@@ -201,6 +203,84 @@ class U_I18N_API CollationFastLatin /* all static */ {
         }
     }
 
+    /**
+     * Fast script tables use the fast Latin data format for one non-Latin script.
+     * Their mini CEs for char indexes 0080..017F are for the 256 characters
+     * starting at the script's block start, rather than for U+0080..U+017F.
+     * Char indexes 0000..007F and 0180..01BF are the same as in the fast Latin table.
+     * Characters with primaries outside the special groups, digits and the script
+     * (for example, ASCII letters) map to BAIL_OUT.
+     *
+     * These tables are not stored in the data file.
+     * They are built from the collation data when it is loaded or built.
+     */
+    static const int32_t SCRIPT_TABLE_GREEK = 0;
+    static const int32_t SCRIPT_TABLE_CYRILLIC = 1;
+    static const int32_t NUM_SCRIPT_TABLES = 2;
+
+    static const int32_t SCRIPT_BLOCK_LENGTH = LATIN_LIMIT - 0x80;
+
+    static inline UChar getScriptBlockStart(int32_t scriptTable) {
+        return scriptTable == SCRIPT_TABLE_GREEK ? 0x370 : 0x400;
+    }
+
+    static inline int32_t getScriptCode(int32_t scriptTable) {
+        return scriptTable == SCRIPT_TABLE_GREEK ? USCRIPT_GREEK : USCRIPT_CYRILLIC;
+    }
+
+    /**
+     * Returns the fast script table index for c,
+     * or -1 if c is not in the block of one of the fast script tables.
+     */
+    static inline int32_t getScriptTable(UChar32 c) {
+        if(c < 0x370 || 0x500 <= c) {
+            return -1;
+        } else if(c < 0x400) {
+            return SCRIPT_TABLE_GREEK;
+        } else {
+            return SCRIPT_TABLE_CYRILLIC;
+        }
+    }
+
+    /**
+     * Maps c to its char index in a fast script table,
+     * or returns -1 if c is not supported by that table.
+     */
+    static inline int32_t getScriptCharIndex(UChar blockStart, UChar32 c) {
+        if(c < 0x80) {
+            return c;
+        } else if(blockStart <= c && c < (blockStart + SCRIPT_BLOCK_LENGTH)) {
+            return c - (blockStart - 0x80);
+        } else if(PUNCT_START <= c && c < PUNCT_LIMIT) {
+            return c - (PUNCT_START - LATIN_LIMIT);
+        } else {
+            return -1;
+        }
+    }
+
+    /**
+     * Computes the options values for compareScriptsUTF16() and compareScriptsUTF8(),
+     * one per fast script table.
+     * An options value is -1 if the script fastpath is not supported
+     * for that table and the settings.
+     * The capacity must be NUM_SCRIPT_TABLES.
+     */
+    static void getScriptOptions(const CollationData *data, const CollationSettings &settings,
+                                 int32_t *options, int32_t capacity);
+
+    /**
+     * Compares two strings of one non-Latin script via its fast script table.
+     * Intended for after compareUTF16() returned BAIL_OUT_RESULT.
+     * Returns BAIL_OUT_RESULT if the regular comparison must be used.
+     */
+    static int32_t compareScriptsUTF16(const uint16_t *const tables[], const int32_t options[],
+                                       const UChar *left, int32_t leftLength,
+                                       const UChar *right, int32_t rightLength);
+
+    static int32_t compareScriptsUTF8(const uint16_t *const tables[], const int32_t options[],
+                                      const uint8_t *left, int32_t leftLength,
+                                      const uint8_t *right, int32_t rightLength);
+
     /**
      * Computes the options value for the compare functions
      * and writes the precomputed primary weights.
@@ -219,6 +299,10 @@ class U_I18N_API CollationFastLatin /* all static */ {
                                const uint8_t *right, int32_t rightLength);
 
 private:
+    static int32_t getMiniVarTop(const uint16_t *table, const CollationSettings &settings);
+    static UBool checkReordering(const CollationData *data, const CollationSettings &settings,
+                                 int32_t script, UBool &digitsAreReordered);
+
     static uint32_t lookup(const uint16_t *table, UChar32 c);
     static uint32_t lookupUTF8(const uint16_t *table, UChar32 c,
                                const uint8_t *s8, int32_t &sIndex, int32_t sLength);
@@ -228,6 +312,12 @@ class U_I18N_API CollationFastLatin /* all static */ {
     static uint32_t nextPair(const uint16_t *table, UChar32 c, uint32_t ce,
                              const UChar *s16, const uint8_t *s8, int32_t &sIndex, int32_t &sLength);
 
+    template<typename Text>
+    static uint32_t nextScriptPair(const uint16_t *table, uint32_t variableTop, Text &text);
+    template<typename Text>
+    static int32_t compareScriptPrimaries(const uint16_t *table, uint32_t variableTop,
+                                          Text &left, Text &right);
+
     static inline uint32_t getPrimaries(uint32_t variableTop, uint32_t pair) {
         uint32_t ce = pair & 0xffff;
         if(ce >= MIN_SHORT) { return pair & TWO_SHORT_PRIMARIES_MASK; }
@@ -302,6 +392,11 @@ class U_I18N_API CollationFastLatin /* all static */ {
  *   Each list starts with such an entry which also contains the default result
  *   for when there is no contraction match.
  *
+ * Fast script tables (see SCRIPT_TABLE_GREEK etc.) have the same format,
+ * except that miniCEs[0x80..0x17f] are for the characters
+ * from the script's block start (e.g., U+0400) instead of for U+0080..U+017F,
+ * and contraction characters are char indexes in that layout.
+ *
  * -----------------
  * Changes for version 2 (ICU 55)
  *
@@ -92,6 +92,8 @@ CollationFastLatinBuilder::CollationFastLatinBuilder(UErrorCode &errorCode)
           miniCEs(NULL),
           firstDigitPrimary(0), firstLatinPrimary(0), lastLatinPrimary(0),
           firstShortPrimary(0), shortPrimaryOverflow(FALSE),
+          scriptTable(-1), blockStart(0), firstScriptPrimary(0), lastScriptPrimary(0),
+          scriptPrimaries(errorCode), scriptPrimariesSelected(FALSE),
           headerLength(0) {
 }
 
@@ -135,6 +137,70 @@ CollationFastLatinBuilder::forData(const CollationData &data, UErrorCode &errorC
     return ok;
 }
 
+UBool
+CollationFastLatinBuilder::forScript(const CollationData &data, int32_t st,
+                                     UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return FALSE; }
+    if(!result.isEmpty() || st < 0 || CollationFastLatin::NUM_SCRIPT_TABLES <= st) {
+        errorCode = U_INVALID_STATE_ERROR;
+        return FALSE;
+    }
+    if(!loadGroups(data, errorCode)) { return FALSE; }
+    scriptTable = st;
+    blockStart = CollationFastLatin::getScriptBlockStart(st);
+    int32_t script = CollationFastLatin::getScriptCode(st);
+    firstScriptPrimary = data.getFirstPrimaryForGroup(script);
+    lastScriptPrimary = data.getLastPrimaryForGroup(script);
+    if(firstScriptPrimary <= firstLatinPrimary) {
+        // missing data, or the script sorts before Latin
+        return FALSE;
+    }
+
+    // Digits get long mini primaries,
+    // so that all of the short primaries are available for the script's letters.
+    firstShortPrimary = firstScriptPrimary;
+    selectScriptPrimaries(data, errorCode);
+    getCEs(data, errorCode);
+    if(!encodeUniqueCEs(errorCode)) { return FALSE; }
+
+    UBool ok = !shortPrimaryOverflow &&
+            encodeCharCEs(errorCode) && encodeContractions(errorCode);
+    contractionCEs.removeAllElements();  // might reduce heap memory usage
+    uniqueCEs.removeAllElements();
+    return ok;
+}
+
+uint16_t *
+CollationFastLatinBuilder::buildScriptTables(CollationData &data, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+    UnicodeString tables;
+    int32_t starts[CollationFastLatin::NUM_SCRIPT_TABLES];
+    for(int32_t st = 0; st < CollationFastLatin::NUM_SCRIPT_TABLES; ++st) {
+        starts[st] = -1;
+        CollationFastLatinBuilder builder(errorCode);
+        if(builder.forScript(data, st, errorCode)) {
+            starts[st] = tables.length();
+            tables.append(builder.result);
+        }
+    }
+    if(U_FAILURE(errorCode)) { return NULL; }
+    if(tables.isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    if(tables.isEmpty()) { return NULL; }
+    uint16_t *memory = (uint16_t *)uprv_malloc(tables.length() * 2);
+    if(memory == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    uprv_memcpy(memory, tables.getBuffer(), tables.length() * 2);
+    for(int32_t st = 0; st < CollationFastLatin::NUM_SCRIPT_TABLES; ++st) {
+        data.fastScriptTables[st] = starts[st] >= 0 ? memory + starts[st] : NULL;
+    }
+    return memory;
+}
+
 UBool
 CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return FALSE; }
@@ -159,6 +225,8 @@ CollationFastLatinBuilder::loadGroups(const CollationData &data, UErrorCode &err
         // missing data
         return FALSE;
     }
+    firstScriptPrimary = firstLatinPrimary;
+    lastScriptPrimary = lastLatinPrimary;
     return TRUE;
 }
 
@@ -193,6 +261,85 @@ CollationFastLatinBuilder::inSameGroup(uint32_t p, uint32_t q) const {
     }
 }
 
+UBool
+CollationFastLatinBuilder::isSupportedPrimary(uint32_t p) const {
+    // We only support primaries up to the Latin script,
+    // or in a fast script table only those below Latin and of the one script.
+    if(p > lastScriptPrimary) { return FALSE; }
+    if(p < firstLatinPrimary || scriptTable < 0) { return TRUE; }
+    if(p < firstScriptPrimary) { return FALSE; }
+    return !scriptPrimariesSelected ||
+            binarySearch(scriptPrimaries.getBuffer(), scriptPrimaries.size(), p) >= 0;
+}
+
+void
+CollationFastLatinBuilder::selectScriptPrimaries(const CollationData &data,
+                                                 UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    // One short mini primary is reserved for U+FFFF.
+    const int32_t maxShortPrimaries =
+            (CollationFastLatin::MAX_SHORT - CollationFastLatin::MIN_SHORT) /
+            CollationFastLatin::SHORT_INC;
+    // Prefer the characters at the start of the block, which tend to be the most common ones.
+    // The script has more primaries than there are short mini primaries
+    // (for example, Cyrillic has about 100 in U+0400..U+04FF).
+    for(int32_t i = 0; i < CollationFastLatin::SCRIPT_BLOCK_LENGTH; ++i) {
+        UChar c = (UChar)(blockStart + i);
+        const CollationData *d;
+        uint32_t ce32 = data.getCE32(c);
+        if(ce32 == Collation::FALLBACK_CE32) {
+            d = data.base;
+            ce32 = d->getCE32(c);
+        } else {
+            d = &data;
+        }
+        ce32 = d->getFinalCE32(ce32);
+        if(Collation::isContractionCE32(ce32)) {
+            // Select by the mapping for the character alone.
+            ce32 = CollationData::readCE32(d->contexts + Collation::indexFromCE32(ce32));
+        }
+        if(!getCEsFromCE32(*d, c, ce32, errorCode)) { continue; }
+        uint32_t p0 = (uint32_t)(ce0 >> 32);
+        uint32_t p1 = (uint32_t)(ce1 >> 32);
+        UBool new0 = p0 >= firstScriptPrimary &&
+                binarySearch(scriptPrimaries.getBuffer(), scriptPrimaries.size(), p0) < 0;
+        UBool new1 = p1 >= firstScriptPrimary && p1 != p0 &&
+                binarySearch(scriptPrimaries.getBuffer(), scriptPrimaries.size(), p1) < 0;
+        if((scriptPrimaries.size() + new0 + new1) > maxShortPrimaries) { continue; }
+        if(new0) {
+            scriptPrimaries.insertElementAt(
+                p0, ~binarySearch(scriptPrimaries.getBuffer(), scriptPrimaries.size(), p0),
+                errorCode);
+        }
+        if(new1) {
+            scriptPrimaries.insertElementAt(
+                p1, ~binarySearch(scriptPrimaries.getBuffer(), scriptPrimaries.size(), p1),
+                errorCode);
+        }
+    }
+    scriptPrimariesSelected = TRUE;
+}
+
+UChar
+CollationFastLatinBuilder::getCharFromIndex(int32_t i) const {
+    if(i >= CollationFastLatin::LATIN_LIMIT) {
+        return (UChar)(CollationFastLatin::PUNCT_START + i - CollationFastLatin::LATIN_LIMIT);
+    } else if(i < 0x80 || scriptTable < 0) {
+        return (UChar)i;
+    } else {
+        return (UChar)(blockStart + i - 0x80);
+    }
+}
+
+int32_t
+CollationFastLatinBuilder::getCharIndex(UChar c) const {
+    if(scriptTable < 0) {
+        return CollationFastLatin::getCharIndex(c);
+    } else {
+        return CollationFastLatin::getScriptCharIndex(blockStart, c);
+    }
+}
+
 void
 CollationFastLatinBuilder::resetCEs() {
     contractionCEs.removeAllElements();
@@ -204,13 +351,8 @@ CollationFastLatinBuilder::resetCEs() {
 void
 CollationFastLatinBuilder::getCEs(const CollationData &data, UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
-    int32_t i = 0;
-    for(UChar c = 0;; ++i, ++c) {
-        if(c == CollationFastLatin::LATIN_LIMIT) {
-            c = CollationFastLatin::PUNCT_START;
-        } else if(c == CollationFastLatin::PUNCT_LIMIT) {
-            break;
-        }
+    for(int32_t i = 0; i < CollationFastLatin::NUM_FAST_CHARS; ++i) {
+        UChar c = getCharFromIndex(i);
         const CollationData *d;
         uint32_t ce32 = data.getCE32(c);
         if(ce32 == Collation::FALLBACK_CE32) {
@@ -303,8 +445,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
     // We do not support an ignorable ce0 unless it is completely ignorable.
     uint32_t p0 = (uint32_t)(ce0 >> 32);
     if(p0 == 0) { return FALSE; }
-    // We only support primaries up to the Latin script.
-    if(p0 > lastLatinPrimary) { return FALSE; }
+    if(!isSupportedPrimary(p0)) { return FALSE; }
     // We support non-common secondary and case weights only together with short primaries.
     uint32_t lower32_0 = (uint32_t)ce0;
     if(p0 < firstShortPrimary) {
@@ -321,6 +462,7 @@ CollationFastLatinBuilder::getCEsFromCE32(const CollationData &data, UChar32 c,
         // and determine for both whether they are variable.
         uint32_t p1 = (uint32_t)(ce1 >> 32);
         if(p1 == 0 ? p0 < firstShortPrimary : !inSameGroup(p0, p1)) { return FALSE; }
+        if(p1 != 0 && scriptTable >= 0 && !isSupportedPrimary(p1)) { return FALSE; }
         uint32_t lower32_1 = (uint32_t)ce1;
         // No tertiary CEs.
         if((lower32_1 >> 16) == 0) { return FALSE; }
@@ -361,7 +503,7 @@ CollationFastLatinBuilder::getCEsFromContractionCE32(const CollationData &data,
     UCharsTrie::Iterator suffixes(p + 2, 0, errorCode);
     while(suffixes.next(errorCode)) {
         const UnicodeString &suffix = suffixes.getString();
-        int32_t x = CollationFastLatin::getCharIndex(suffix.charAt(0));
+        int32_t x = getCharIndex(suffix.charAt(0));
         if(x < 0) { continue; }  // ignore anything but fast Latin text
         if(x == prevX) {
             if(addContraction) {
@@ -36,6 +36,21 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
 
     UBool forData(const CollationData &data, UErrorCode &errorCode);
 
+    /**
+     * Builds a fast script table (see CollationFastLatin::SCRIPT_TABLE_GREEK etc.).
+     * Characters in the script's block are included in code point order
+     * as long as their primary weights fit into the short mini primaries.
+     */
+    UBool forScript(const CollationData &data, int32_t scriptTable, UErrorCode &errorCode);
+
+    /**
+     * Builds all of the fast script tables for the data into one memory block,
+     * and sets data.fastScriptTables[] to the tables that could be built.
+     * @return the memory block, to be released with uprv_free(),
+     *         or NULL if no table was built
+     */
+    static uint16_t *buildScriptTables(CollationData &data, UErrorCode &errorCode);
+
     const uint16_t *getTable() const {
         return reinterpret_cast<const uint16_t *>(result.getBuffer());
     }
@@ -47,6 +62,10 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
 
     UBool loadGroups(const CollationData &data, UErrorCode &errorCode);
     UBool inSameGroup(uint32_t p, uint32_t q) const;
+    UBool isSupportedPrimary(uint32_t p) const;
+    void selectScriptPrimaries(const CollationData &data, UErrorCode &errorCode);
+    UChar getCharFromIndex(int32_t i) const;
+    int32_t getCharIndex(UChar c) const;
 
     void resetCEs();
     void getCEs(const CollationData &data, UErrorCode &errorCode);
@@ -90,6 +109,16 @@ class U_I18N_API CollationFastLatinBuilder : public UObject {
 
     UBool shortPrimaryOverflow;
 
+    // For a fast script table: The table index, or -1 for the fast Latin table,
+    // the script's block start, and its primary weight range.
+    int32_t scriptTable;
+    UChar blockStart;
+    uint32_t firstScriptPrimary;
+    uint32_t lastScriptPrimary;
+    // The script primaries that get short mini primaries, in ascending order.
+    UVector64 scriptPrimaries;
+    UBool scriptPrimariesSelected;
+
     UnicodeString result;
     int32_t headerLength;
 };
@@ -16,7 +16,10 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/bytestream.h"
+#include "unicode/utf16.h"
+#include "unicode/utf8.h"
 #include "collation.h"
+#include "collationdata.h"
 #include "collationiterator.h"
 #include "collationkeys.h"
 #include "collationsettings.h"
@@ -83,10 +86,49 @@ SortKeyByteSink::GetAppendBuffer(int32_t min_capacity,
     }
 }
 
-namespace {
+GrowingSortKeyByteSink::~GrowingSortKeyByteSink() {
+    uprv_free(buffer_);
+}
+
+void
+GrowingSortKeyByteSink::AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length) {
+    // buffer_ != NULL && bytes != NULL && n > 0 && appended_ > capacity_
+    if (Resize(n, length)) {
+        uprv_memcpy(buffer_ + length, bytes, n);
+    }
+}
+
+UBool
+GrowingSortKeyByteSink::Resize(int32_t appendCapacity, int32_t length) {
+    if (buffer_ == NULL) {
+        return FALSE;  // allocation failed before already
+    }
+    if (appendCapacity > (INT32_MAX - length) / 2) {
+        uprv_free(buffer_);
+        buffer_ = NULL;
+        capacity_ = 0;
+        return FALSE;
+    }
+    int32_t newCapacity = capacity_ <= INT32_MAX / 2 ? 2 * capacity_ : INT32_MAX;
+    int32_t altCapacity = length + 2 * appendCapacity;
+    if (newCapacity < altCapacity) {
+        newCapacity = altCapacity;
+    }
+    char *newBuffer = static_cast<char *>(uprv_realloc(buffer_, newCapacity));
+    if (newBuffer == NULL) {
+        uprv_free(buffer_);
+        buffer_ = NULL;
+        capacity_ = 0;
+        return FALSE;
+    }
+    buffer_ = newBuffer;
+    capacity_ = newCapacity;
+    return TRUE;
+}
 
 /**
  * uint8_t byte buffer, similar to CharString but simpler.
+ * Not in an anonymous namespace, so that IncrementalSortKeyWriter can save and restore levels.
  */
 class SortKeyLevel : public UMemory {
 public:
@@ -103,6 +145,7 @@ class SortKeyLevel : public UMemory {
     uint8_t *data() { return buffer.getAlias(); }
 
     void appendByte(uint32_t b);
+    void appendBytes(const char *bytes, int32_t n);
     void appendWeight16(uint32_t w);
     void appendWeight32(uint32_t w);
     void appendReverseWeight16(uint32_t w);
@@ -130,6 +173,14 @@ void SortKeyLevel::appendByte(uint32_t b) {
     }
 }
 
+void
+SortKeyLevel::appendBytes(const char *bytes, int32_t n) {
+    if(n > 0 && ((len + n) <= buffer.getCapacity() || ensureCapacity(n))) {
+        uprv_memcpy(buffer.getAlias() + len, bytes, n);
+        len += n;
+    }
+}
+
 void
 SortKeyLevel::appendWeight16(uint32_t w) {
     U_ASSERT((w & 0xffff) != 0);
@@ -198,8 +249,6 @@ UBool SortKeyLevel::ensureCapacity(int32_t appendCapacity) {
     return TRUE;
 }
 
-}  // namespace
-
 CollationKeys::LevelCallback::~LevelCallback() {}
 
 UBool
@@ -229,6 +278,18 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
                                           SortKeyByteSink &sink,
                                           Collation::Level minLevel, LevelCallback &callback,
                                           UBool preflight, UErrorCode &errorCode) {
+    writeSortKeyUpToQuaternary(iter, compressibleBytes, settings, sink, minLevel, callback,
+                               preflight, NULL, errorCode);
+}
+
+void
+CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
+                                          const UBool *compressibleBytes,
+                                          const CollationSettings &settings,
+                                          SortKeyByteSink &sink,
+                                          Collation::Level minLevel, LevelCallback &callback,
+                                          UBool preflight, IncrementalSortKeyWriter *writer,
+                                          UErrorCode &errorCode) {
     if(U_FAILURE(errorCode)) { return; }
 
     int32_t options = settings.options;
@@ -265,11 +326,45 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
     uint32_t prevSecondary = 0;
     int32_t secSegmentStart = 0;
 
+    // The incremental writer collects the primary weights, so that it can reuse them.
+    SortKeyByteSink &primarySink = writer != NULL ? writer->primaries : sink;
+    // Set when resuming right after a variable CE.
+    UBool skipPrimaryIgnorables = FALSE;
+    const IncrementalSortKeyWriter::Checkpoint *resume =
+        writer != NULL ? writer->getResumePoint() : NULL;
+    if(resume != NULL) {
+        prevReorderedPrimary = resume->prevReorderedPrimary;
+        commonCases = resume->commonCases;
+        commonSecondaries = resume->commonSecondaries;
+        commonTertiaries = resume->commonTertiaries;
+        commonQuaternaries = resume->commonQuaternaries;
+        prevSecondary = resume->prevSecondary;
+        secSegmentStart = resume->secSegmentStart;
+        skipPrimaryIgnorables = resume->afterVariable;
+        writer->restoreLevels(cases, secondaries, tertiaries, quaternaries);
+    }
+
     for(;;) {
         // No need to keep all CEs in the buffer when we write a sort key.
         iter.clearCEsIfNoneRemaining();
         int64_t ce = iter.nextCE(errorCode);
+        if(ce == Collation::NO_CE && writer != NULL && writer->splitOffset >= 0) {
+            // End of the text that the next string shares.
+            IncrementalSortKeyWriter::Checkpoint state = {
+                0, 0, 0, 0, 0, 0,
+                prevReorderedPrimary,
+                commonCases, commonSecondaries, commonTertiaries, commonQuaternaries,
+                prevSecondary, secSegmentStart,
+                skipPrimaryIgnorables
+            };
+            writer->saveCheckpoint(state, cases, secondaries, tertiaries, quaternaries, errorCode);
+            ce = iter.nextCE(errorCode);
+        }
         uint32_t p = (uint32_t)(ce >> 32);
+        if(skipPrimaryIgnorables) {
+            if(p == 0) { continue; }
+            skipPrimaryIgnorables = FALSE;
+        }
         if(p < variableTop && p > Collation::MERGE_SEPARATOR_PRIMARY) {
             // Variable CE, shift it to quaternary level.
             // Ignore all following primary ignorables, and shift further variable CEs.
@@ -297,6 +392,19 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
                 }
                 do {
                     ce = iter.nextCE(errorCode);
+                    if(ce == Collation::NO_CE && writer != NULL && writer->splitOffset >= 0) {
+                        // End of the shared text, right after a variable CE.
+                        IncrementalSortKeyWriter::Checkpoint state = {
+                            0, 0, 0, 0, 0, 0,
+                            prevReorderedPrimary,
+                            commonCases, commonSecondaries, commonTertiaries, commonQuaternaries,
+                            prevSecondary, secSegmentStart,
+                            TRUE
+                        };
+                        writer->saveCheckpoint(state, cases, secondaries, tertiaries, quaternaries,
+                                               errorCode);
+                        ce = iter.nextCE(errorCode);
+                    }
                     p = (uint32_t)(ce >> 32);
                 } while(p == 0);
             } while(p < variableTop && p > Collation::MERGE_SEPARATOR_PRIMARY);
@@ -318,13 +426,13 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
                         // No primary compression terminator
                         // at the end of the level or merged segment.
                         if(p1 > Collation::MERGE_SEPARATOR_BYTE) {
-                            sink.Append(Collation::PRIMARY_COMPRESSION_LOW_BYTE);
+                            primarySink.Append(Collation::PRIMARY_COMPRESSION_LOW_BYTE);
                         }
                     } else {
-                        sink.Append(Collation::PRIMARY_COMPRESSION_HIGH_BYTE);
+                        primarySink.Append(Collation::PRIMARY_COMPRESSION_HIGH_BYTE);
                     }
                 }
-                sink.Append(p1);
+                primarySink.Append(p1);
                 if(isCompressible) {
                     prevReorderedPrimary = p;
                 } else {
@@ -334,13 +442,13 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
             char p2 = (char)(p >> 16);
             if(p2 != 0) {
                 char buffer[3] = { p2, (char)(p >> 8), (char)p };
-                sink.Append(buffer, (buffer[1] == 0) ? 1 : (buffer[2] == 0) ? 2 : 3);
+                primarySink.Append(buffer, (buffer[1] == 0) ? 1 : (buffer[2] == 0) ? 2 : 3);
             }
             // Optimization for internalNextSortKeyPart():
             // When the primary level overflows we can stop because we need not
             // calculate (preflight) the whole sort key length.
-            if(!preflight && sink.Overflowed()) {
-                if(U_SUCCESS(errorCode) && !sink.IsOk()) {
+            if(!preflight && primarySink.Overflowed()) {
+                if(U_SUCCESS(errorCode) && !primarySink.IsOk()) {
                     errorCode = U_MEMORY_ALLOCATION_ERROR;
                 }
                 return;
@@ -618,8 +726,13 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
 
     if(U_FAILURE(errorCode)) { return; }
 
-    // Append the beyond-primary levels.
     UBool ok = TRUE;
+    if(writer != NULL) {
+        ok &= primarySink.IsOk();
+        sink.Append(writer->primaries.GetBytes(), primarySink.NumberOfBytesAppended());
+    }
+
+    // Append the beyond-primary levels.
     if((levels & Collation::SECONDARY_LEVEL_FLAG) != 0) {
         if(!callback.needToWrite(Collation::SECONDARY_LEVEL)) { return; }
         ok &= secondaries.isOk();
@@ -668,6 +781,232 @@ CollationKeys::writeSortKeyUpToQuaternary(CollationIterator &iter,
     }
 }
 
+IncrementalSortKeyWriter::IncrementalSortKeyWriter(const CollationData *d,
+                                                   const CollationSettings &sett)
+        : data(d), settings(sett),
+          numeric(sett.isNumeric()), checkFCD(!sett.dontCheckFCD()),
+          iter16(d, numeric, NULL, NULL, NULL),
+          fcdIter16(d, numeric, NULL, NULL, NULL),
+          iter8(d, numeric, NULL, 0, 0),
+          fcdIter8(d, numeric, NULL, 0, 0),
+          iter(NULL),
+          s16(NULL), s8(NULL), textLength(0), splitOffset(-1),
+          checkpointsLength(0), resumeIndex(-1), sharedWithPrevious(0),
+          primaries(200) {}
+
+IncrementalSortKeyWriter::~IncrementalSortKeyWriter() {}
+
+int32_t
+IncrementalSortKeyWriter::getSharedPrefixLength(const UChar *s, int32_t length,
+                                                const UChar *next, int32_t nextLength) const {
+    // Same as in RuleBasedCollator::doCompare().
+    int32_t i = 0;
+    int32_t minLength = length < nextLength ? length : nextLength;
+    while(i < minLength && s[i] == next[i]) { ++i; }
+    if(i > 0 &&
+            ((i != length && data->isUnsafeBackward(s[i], numeric)) ||
+            (i != nextLength && data->isUnsafeBackward(next[i], numeric)))) {
+        // Back up to the start of a contraction or reordering sequence.
+        while(--i > 0 && data->isUnsafeBackward(s[i], numeric)) {}
+    }
+    return i;
+}
+
+int32_t
+IncrementalSortKeyWriter::getSharedPrefixLength(const uint8_t *s, int32_t length,
+                                                const uint8_t *next, int32_t nextLength) const {
+    // Same as in RuleBasedCollator::doCompare().
+    int32_t i = 0;
+    int32_t minLength = length < nextLength ? length : nextLength;
+    while(i < minLength && s[i] == next[i]) { ++i; }
+    // Back up to the start of a partially-equal code point.
+    if(i > 0 &&
+            ((i != length && U8_IS_TRAIL(s[i])) ||
+            (i != nextLength && U8_IS_TRAIL(next[i])))) {
+        while(--i > 0 && U8_IS_TRAIL(s[i])) {}
+    }
+    if(i > 0) {
+        UBool unsafe = FALSE;
+        UChar32 c;
+        if(i != length) {
+            int32_t j = i;
+            U8_NEXT_OR_FFFD(s, j, length, c);
+            unsafe = data->isUnsafeBackward(c, numeric);
+        }
+        if(!unsafe && i != nextLength) {
+            int32_t j = i;
+            U8_NEXT_OR_FFFD(next, j, nextLength, c);
+            unsafe = data->isUnsafeBackward(c, numeric);
+        }
+        if(unsafe) {
+            // Back up to the start of a contraction or reordering sequence.
+            do {
+                U8_PREV_OR_FFFD(s, 0, i, c);
+            } while(i > 0 && data->isUnsafeBackward(c, numeric));
+        }
+    }
+    return i;
+}
+
+void
+IncrementalSortKeyWriter::writeSortKey(const UChar *s, int32_t length,
+                                       const UChar *next, int32_t nextLength,
+                                       SortKeyByteSink &sink, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    s16 = s;
+    s8 = NULL;
+    textLength = length;
+    if(checkFCD) {
+        iter = &fcdIter16;
+    } else {
+        iter = &iter16;
+    }
+    int32_t shared = next != NULL ? getSharedPrefixLength(s, length, next, nextLength) : -1;
+    write(length, shared, sink, errorCode);
+}
+
+void
+IncrementalSortKeyWriter::writeSortKey(const uint8_t *s, int32_t length,
+                                       const uint8_t *next, int32_t nextLength,
+                                       SortKeyByteSink &sink, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+    s16 = NULL;
+    s8 = s;
+    textLength = length;
+    if(checkFCD) {
+        iter = &fcdIter8;
+    } else {
+        iter = &iter8;
+    }
+    int32_t shared = next != NULL ? getSharedPrefixLength(s, length, next, nextLength) : -1;
+    write(length, shared, sink, errorCode);
+}
+
+void
+IncrementalSortKeyWriter::write(int32_t length, int32_t shared,
+                                SortKeyByteSink &sink, UErrorCode &errorCode) {
+    // Keep the states within the prefix shared with the previous string,
+    // and resume from the last of them.
+    while(checkpointsLength > 0 &&
+            checkpoints[checkpointsLength - 1].offset > sharedWithPrevious) {
+        --checkpointsLength;
+    }
+    resumeIndex = checkpointsLength - 1;
+    int32_t start;
+    const Checkpoint *resume = getResumePoint();
+    if(resume != NULL) {
+        start = resume->offset;
+        primaries.Truncate(resume->primaryLength);
+    } else {
+        start = 0;
+        primaries.Truncate(0);
+    }
+    if(shared > start) {
+        // Stop at the end of the shared prefix to save the state there.
+        splitOffset = shared;
+        setText(shared, start);
+    } else {
+        splitOffset = -1;
+        setText(length, start);
+    }
+    CollationKeys::LevelCallback callback;
+    CollationKeys::writeSortKeyUpToQuaternary(
+            *iter, data->compressibleBytes, settings, sink, Collation::PRIMARY_LEVEL,
+            callback, TRUE, this, errorCode);
+    resumeIndex = -1;
+    sharedWithPrevious = shared > 0 ? shared : 0;
+}
+
+void
+IncrementalSortKeyWriter::setText(int32_t limit, int32_t offset) {
+    if(s16 != NULL) {
+        if(checkFCD) {
+            fcdIter16.setText(s16, s16 + limit);
+        } else {
+            iter16.setText(s16, s16 + limit);
+        }
+    } else {
+        if(checkFCD) {
+            fcdIter8.setText(s8, limit);
+        } else {
+            iter8.setText(s8, limit);
+        }
+    }
+    if(offset != 0) {
+        // Start in the middle of the text so that prefix matches still see the text before.
+        iter->resetToOffset(offset);
+    }
+}
+
+void
+IncrementalSortKeyWriter::restoreLevels(SortKeyLevel &cases, SortKeyLevel &secondaries,
+                                        SortKeyLevel &tertiaries,
+                                        SortKeyLevel &quaternaries) const {
+    const Checkpoint *resume = getResumePoint();
+    secondaries.appendBytes(secondaryBytes.data(), resume->secondaryLength);
+    cases.appendBytes(caseBytes.data(), resume->caseLength);
+    tertiaries.appendBytes(tertiaryBytes.data(), resume->tertiaryLength);
+    quaternaries.appendBytes(quaternaryBytes.data(), resume->quaternaryLength);
+}
+
+namespace {
+
+void saveLevel(CharString &saved, int32_t savedLength, const SortKeyLevel &level,
+               UErrorCode &errorCode) {
+    saved.truncate(savedLength);
+    saved.append(reinterpret_cast<const char *>(level.data()) + savedLength,
+                 level.length() - savedLength, errorCode);
+}
+
+}  // namespace
+
+void
+IncrementalSortKeyWriter::saveCheckpoint(Checkpoint &state,
+                                         const SortKeyLevel &cases,
+                                         const SortKeyLevel &secondaries,
+                                         const SortKeyLevel &tertiaries,
+                                         const SortKeyLevel &quaternaries,
+                                         UErrorCode &errorCode) {
+    int32_t offset = splitOffset;
+    // Continue with the rest of the text.
+    splitOffset = -1;
+    setText(textLength, offset);
+    if(U_FAILURE(errorCode)) { return; }
+
+    // The saved level bytes are shared by all states.
+    // They are only appended to, except that backward secondaries are reversed
+    // in place at merge separators.
+    if(checkpointsLength > 0 && (settings.options & CollationSettings::BACKWARD_SECONDARY) != 0 &&
+            checkpoints[checkpointsLength - 1].secSegmentStart != state.secSegmentStart) {
+        checkpointsLength = 0;
+    }
+    if(checkpointsLength == checkpoints.getCapacity() &&
+            checkpoints.resize(2 * checkpointsLength, checkpointsLength) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    state.offset = offset;
+    state.primaryLength = primaries.NumberOfBytesAppended();
+    state.secondaryLength = secondaries.length();
+    state.caseLength = cases.length();
+    state.tertiaryLength = tertiaries.length();
+    state.quaternaryLength = quaternaries.length();
+    if(checkpointsLength > 0) {
+        const Checkpoint &prev = checkpoints[checkpointsLength - 1];
+        saveLevel(secondaryBytes, prev.secondaryLength, secondaries, errorCode);
+        saveLevel(caseBytes, prev.caseLength, cases, errorCode);
+        saveLevel(tertiaryBytes, prev.tertiaryLength, tertiaries, errorCode);
+        saveLevel(quaternaryBytes, prev.quaternaryLength, quaternaries, errorCode);
+    } else {
+        saveLevel(secondaryBytes, 0, secondaries, errorCode);
+        saveLevel(caseBytes, 0, cases, errorCode);
+        saveLevel(tertiaryBytes, 0, tertiaries, errorCode);
+        saveLevel(quaternaryBytes, 0, quaternaries, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return; }
+    checkpoints[checkpointsLength++] = state;
+}
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
@@ -21,13 +21,19 @@
 #include "unicode/bytestream.h"
 #include "unicode/ucol.h"
 #include "charstr.h"
+#include "cmemory.h"
 #include "collation.h"
+#include "utf16collationiterator.h"
+#include "utf8collationiterator.h"
 
 U_NAMESPACE_BEGIN
 
 class CollationIterator;
+struct CollationData;
 struct CollationDataReader;
 struct CollationSettings;
+class IncrementalSortKeyWriter;
+class SortKeyLevel;
 
 class SortKeyByteSink : public ByteSink {
 public:
@@ -87,6 +93,39 @@ class SortKeyByteSink : public ByteSink {
     SortKeyByteSink &operator=(const SortKeyByteSink &); // assignment operator not implemented
 };
 
+/**
+ * Sort key sink with its own heap buffer.
+ */
+class GrowingSortKeyByteSink : public SortKeyByteSink {
+public:
+    GrowingSortKeyByteSink(int32_t initialCapacity)
+            : SortKeyByteSink(static_cast<char *>(uprv_malloc(initialCapacity)),
+                              initialCapacity) {
+        if (buffer_ == NULL) { capacity_ = 0; }
+    }
+    virtual ~GrowingSortKeyByteSink();
+
+    /** @return the bytes appended so far (NULL if memory allocation failed) */
+    const char *GetBytes() const { return buffer_; }
+
+    /** Shortens the contents to length bytes. */
+    void Truncate(int32_t length) {
+        if (length < appended_) { appended_ = length; }
+    }
+
+    /** Returns the buffer and passes ownership to the caller. */
+    char *orphanBuffer() {
+        char *p = buffer_;
+        buffer_ = NULL;
+        capacity_ = 0;
+        return p;
+    }
+
+private:
+    virtual void AppendBeyondCapacity(const char *bytes, int32_t n, int32_t length);
+    virtual UBool Resize(int32_t appendCapacity, int32_t length);
+};
+
 class U_I18N_API CollationKeys /* not : public UObject because all methods are static */ {
 public:
     class LevelCallback : public UMemory {
@@ -115,9 +154,22 @@ class U_I18N_API CollationKeys /* not : public UObject because all methods are s
                                            UBool preflight, UErrorCode &errorCode);
 private:
     friend struct CollationDataReader;
+    friend class IncrementalSortKeyWriter;
 
     CollationKeys();  // no instantiation
 
+    /**
+     * Same as the public function, but if writer!=NULL then
+     * resumes from and saves to the writer's checkpoints.
+     */
+    static void writeSortKeyUpToQuaternary(CollationIterator &iter,
+                                           const UBool *compressibleBytes,
+                                           const CollationSettings &settings,
+                                           SortKeyByteSink &sink,
+                                           Collation::Level minLevel, LevelCallback &callback,
+                                           UBool preflight, IncrementalSortKeyWriter *writer,
+                                           UErrorCode &errorCode);
+
     // Secondary level: Compress up to 33 common weights as 05..25 or 25..45.
     static const uint32_t SEC_COMMON_LOW = Collation::COMMON_BYTE;
     static const uint32_t SEC_COMMON_MIDDLE = SEC_COMMON_LOW + 0x20;
@@ -163,6 +215,133 @@ class U_I18N_API CollationKeys /* not : public UObject because all methods are s
     static const uint32_t QUAT_SHIFTED_LIMIT_BYTE = QUAT_COMMON_LOW - 1;  // 0x1b
 };
 
+/**
+ * Writes the sort keys for a series of strings up to the quaternary level,
+ * reusing the work for the text that a string shares with the previous one.
+ * Meant for sorted or clustered input like file paths, URLs and product codes.
+ *
+ * While it writes the sort key for one string, the writer saves its state
+ * at the end of the prefix that the string shares with the next one,
+ * backed up to where collation can safely restart (see CollationData::isUnsafeBackward()).
+ * The next string then resumes from there rather than fetching and encoding
+ * the CEs for the shared text again.
+ * The saved states nest, so a string can also resume from an earlier, shorter shared prefix.
+ *
+ * Writes the same bytes as CollationKeys::writeSortKeyUpToQuaternary()
+ * with Collation::PRIMARY_LEVEL and preflighting.
+ */
+class U_I18N_API IncrementalSortKeyWriter : public UMemory {
+public:
+    IncrementalSortKeyWriter(const CollationData *data, const CollationSettings &settings);
+    ~IncrementalSortKeyWriter();
+
+    /**
+     * Writes the sort key for s up to the quaternary level, without the terminator byte.
+     * If this is not the first string, then it must be the one that was passed in
+     * as the next string in the previous call.
+     *
+     * @param s the string
+     * @param length its length, must not be negative
+     * @param next the following string, or NULL if s is the last one
+     * @param nextLength its length, must not be negative
+     */
+    void writeSortKey(const UChar *s, int32_t length,
+                      const UChar *next, int32_t nextLength,
+                      SortKeyByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Same as the UTF-16 version but for UTF-8 strings.
+     * Use only one of the two functions for a series of strings.
+     */
+    void writeSortKey(const uint8_t *s, int32_t length,
+                      const uint8_t *next, int32_t nextLength,
+                      SortKeyByteSink &sink, UErrorCode &errorCode);
+
+private:
+    friend class CollationKeys;
+
+    /** Writer state at a text boundary. */
+    struct Checkpoint {
+        int32_t offset;
+        int32_t primaryLength;
+        int32_t secondaryLength;
+        int32_t caseLength;
+        int32_t tertiaryLength;
+        int32_t quaternaryLength;
+        uint32_t prevReorderedPrimary;
+        int32_t commonCases;
+        int32_t commonSecondaries;
+        int32_t commonTertiaries;
+        int32_t commonQuaternaries;
+        uint32_t prevSecondary;
+        int32_t secSegmentStart;
+        /** TRUE if the last CE was variable and primary ignorables are to be skipped. */
+        UBool afterVariable;
+    };
+
+    int32_t getSharedPrefixLength(const UChar *s, int32_t length,
+                                  const UChar *next, int32_t nextLength) const;
+    int32_t getSharedPrefixLength(const uint8_t *s, int32_t length,
+                                  const uint8_t *next, int32_t nextLength) const;
+
+    void write(int32_t length, int32_t shared, SortKeyByteSink &sink, UErrorCode &errorCode);
+
+    /**
+     * Sets the iterator to [0..limit[ of the current string, starting at offset.
+     */
+    void setText(int32_t limit, int32_t offset);
+
+    /** @return the checkpoint to resume from, or NULL */
+    const Checkpoint *getResumePoint() const {
+        return resumeIndex >= 0 ? checkpoints.getAlias() + resumeIndex : NULL;
+    }
+
+    /** Copies the saved level bytes up to the resume point into the levels. */
+    void restoreLevels(SortKeyLevel &cases, SortKeyLevel &secondaries,
+                       SortKeyLevel &tertiaries, SortKeyLevel &quaternaries) const;
+
+    /**
+     * Called at the end of the prefix shared with the next string:
+     * Saves the state and the levels, and continues with the rest of the text.
+     */
+    void saveCheckpoint(Checkpoint &state,
+                        const SortKeyLevel &cases, const SortKeyLevel &secondaries,
+                        const SortKeyLevel &tertiaries, const SortKeyLevel &quaternaries,
+                        UErrorCode &errorCode);
+
+    const CollationData *data;
+    const CollationSettings &settings;
+    UBool numeric;
+    UBool checkFCD;
+
+    UTF16CollationIterator iter16;
+    FCDUTF16CollationIterator fcdIter16;
+    UTF8CollationIterator iter8;
+    FCDUTF8CollationIterator fcdIter8;
+    CollationIterator *iter;
+
+    // The current string.
+    const UChar *s16;
+    const uint8_t *s8;
+    int32_t textLength;
+    /** Offset where the state is to be saved, or -1. */
+    int32_t splitOffset;
+
+    /** Saved states with ascending offsets, all within the current string's text. */
+    MaybeStackArray<Checkpoint, 8> checkpoints;
+    int32_t checkpointsLength;
+    int32_t resumeIndex;
+    /** Length of the prefix that the current string shares with the previous one. */
+    int32_t sharedWithPrevious;
+
+    /** Primary weights written so far; the sort key's other levels are kept as saved bytes. */
+    GrowingSortKeyByteSink primaries;
+    CharString secondaryBytes;
+    CharString caseBytes;
+    CharString tertiaryBytes;
+    CharString quaternaryBytes;
+};
+
 U_NAMESPACE_END
 
 #endif  // !UCONFIG_NO_COLLATION
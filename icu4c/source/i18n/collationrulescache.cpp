@@ -0,0 +1,347 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+* collationrulescache.cpp
+*
+* Cache of tailorings built from rule strings,
+* with optional snapshot files that survive process restarts.
+*
+* A snapshot file contains the tailoring as written by
+* CollationDataWriter::writeTailoring() (with a UDataInfo header),
+* followed by the int32_t length of the rule string and its UChars.
+* The rule string guards against hash collisions in the file name
+* and restores the rules which are not part of the binary format.
+* Files are written to a temporary name and then renamed,
+* so that concurrent readers never see a partial file.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#if !UCONFIG_NO_FILE_IO
+#include <stdio.h>
+#endif
+#include "unicode/udata.h"
+#include "unicode/ucol.h"
+#include "unicode/unistr.h"
+#include "charstr.h"
+#include "cmemory.h"
+#include "collationbuilder.h"
+#include "collationdatareader.h"
+#include "collationdatawriter.h"
+#include "collationroot.h"
+#include "collationrulescache.h"
+#include "collationsettings.h"
+#include "collationtailoring.h"
+#include "cstring.h"
+#include "mutex.h"
+#include "putilimp.h"
+#include "ucln_in.h"
+#include "ucmndata.h"
+#include "udatamem.h"
+#include "unifiedcache.h"
+
+U_NAMESPACE_BEGIN
+
+namespace {
+
+static UMutex gSnapshotMutex;
+static char *gSnapshotDirectory = NULL;
+
+static const char SNAPSHOT_TYPE[] = "col";
+
+class CollationRulesCacheKey : public CacheKey<CollationCacheEntry> {
+public:
+    CollationRulesCacheKey(const UnicodeString &r) : rules(r) {}
+    CollationRulesCacheKey(const CollationRulesCacheKey &other)
+            : CacheKey<CollationCacheEntry>(other), rules(other.rules) {}
+    virtual ~CollationRulesCacheKey();
+
+    virtual int32_t hashCode() const {
+        return (int32_t)(37u * (uint32_t)CacheKey<CollationCacheEntry>::hashCode() +
+                         (uint32_t)rules.hashCode());
+    }
+    virtual UBool operator==(const CacheKeyBase &other) const {
+        if(this == &other) { return TRUE; }
+        if(!CacheKey<CollationCacheEntry>::operator==(other)) { return FALSE; }
+        // Same class because CacheKey::operator==() compares the types.
+        return rules == static_cast<const CollationRulesCacheKey &>(other).rules;
+    }
+    virtual CacheKeyBase *clone() const {
+        return new CollationRulesCacheKey(*this);
+    }
+    virtual const CollationCacheEntry *createObject(const void *creationContext,
+                                                    UErrorCode &errorCode) const {
+        return CollationRulesCache::createCacheEntry(
+            static_cast<const CollationTailoring *>(creationContext), rules, errorCode);
+    }
+
+private:
+    // Copying a read-only alias makes a real copy,
+    // so the key does not alias the caller's rule string.
+    UnicodeString rules;
+};
+
+CollationRulesCacheKey::~CollationRulesCacheKey() {}
+
+/**
+ * Returns the length of the tailoring data, starting with the indexes.
+ * Tailorings omit trailing indexes for empty data items,
+ * so IX_TOTAL_SIZE is usually not present.
+ * Instead, the last index is the limit offset of the last data item,
+ * unless there are only the options.
+ */
+int32_t getDataLength(const int32_t *inIndexes) {
+    int32_t indexesLength = inIndexes[CollationDataReader::IX_INDEXES_LENGTH];
+    if(indexesLength <= CollationDataReader::IX_REORDER_CODES_OFFSET) {
+        return indexesLength * 4;
+    } else {
+        return inIndexes[indexesLength - 1];
+    }
+}
+
+void appendHex(CharString &s, uint32_t value, int32_t minDigits, UErrorCode &errorCode) {
+    static const char digits[] = "0123456789abcdef";
+    char buffer[8];
+    int32_t length = 0;
+    do {
+        buffer[length++] = digits[value & 0xf];
+        value >>= 4;
+    } while(value != 0 || length < minDigits);
+    while(length > 0) {
+        s.append(buffer[--length], errorCode);
+    }
+}
+
+}  // namespace
+
+#if !UCONFIG_NO_FILE_IO
+
+U_CDECL_BEGIN
+
+static UBool U_CALLCONV uprv_collation_rules_cache_cleanup() {
+    uprv_free(gSnapshotDirectory);
+    gSnapshotDirectory = NULL;
+    return TRUE;
+}
+
+U_CDECL_END
+
+#endif  // !UCONFIG_NO_FILE_IO
+
+const CollationCacheEntry *
+CollationRulesCache::getCacheEntry(const UnicodeString &rules, UErrorCode &errorCode) {
+    const CollationTailoring *base = CollationRoot::getRoot(errorCode);
+    const UnifiedCache *cache = UnifiedCache::getInstance(errorCode);
+    if(U_FAILURE(errorCode)) { return NULL; }
+    const CollationCacheEntry *entry = NULL;
+    cache->get(CollationRulesCacheKey(rules), base, entry, errorCode);
+    return entry;
+}
+
+void
+CollationRulesCache::setSnapshotDirectory(const char *path, UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return; }
+#if UCONFIG_NO_FILE_IO
+    // Snapshots cannot be read or written; keep them disabled.
+    (void)path;
+#else
+    char *newDirectory = NULL;
+    if(path != NULL && *path != 0) {
+        // udata_openChoice() treats a relative path with only one separator
+        // as a package tree name, not as a directory.
+        CharString dir;
+        if(!uprv_pathIsAbsolute(path)) {
+            dir.append("." U_FILE_SEP_STRING, errorCode);
+        }
+        dir.append(path, errorCode).ensureEndsWithFileSeparator(errorCode);
+        if(U_FAILURE(errorCode)) { return; }
+        newDirectory = (char *)uprv_malloc(dir.length() + 1);
+        if(newDirectory == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        uprv_memcpy(newDirectory, dir.data(), dir.length() + 1);
+    }
+    Mutex lock(&gSnapshotMutex);
+    uprv_free(gSnapshotDirectory);
+    gSnapshotDirectory = newDirectory;
+    ucln_i18n_registerCleanup(UCLN_I18N_COLLATION_RULES_CACHE,
+                              uprv_collation_rules_cache_cleanup);
+#endif  // !UCONFIG_NO_FILE_IO
+}
+
+const CollationCacheEntry *
+CollationRulesCache::createCacheEntry(const CollationTailoring *base,
+                                      const UnicodeString &rules,
+                                      UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+    CharString dir;
+    {
+        Mutex lock(&gSnapshotMutex);
+        if(gSnapshotDirectory != NULL) {
+            dir.append(gSnapshotDirectory, errorCode);
+        }
+    }
+    CharString name;
+    if(!dir.isEmpty()) {
+        getSnapshotName(base, rules, name, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return NULL; }
+
+    LocalPointer<CollationTailoring> t;
+    if(!name.isEmpty()) {
+        t.adoptInstead(loadSnapshot(base, rules, dir.data(), name.data(), errorCode));
+        if(U_FAILURE(errorCode)) { return NULL; }
+    }
+    if(t.isNull()) {
+        t.adoptInstead(CollationBuilder::buildTailoring(base, rules, NULL, NULL, errorCode));
+        if(U_FAILURE(errorCode)) { return NULL; }
+        if(!name.isEmpty()) {
+            writeSnapshot(*t, dir.data(), name.data());
+        }
+    }
+    t->actualLocale.setToBogus();
+    CollationCacheEntry *entry = new CollationCacheEntry(t->actualLocale, t.getAlias());
+    if(entry == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    t.orphan();  // The entry took ownership of the tailoring.
+    // Have to add that reference that we promise.
+    entry->addRef();
+    return entry;
+}
+
+void
+CollationRulesCache::getSnapshotName(const CollationTailoring *base,
+                                     const UnicodeString &rules,
+                                     CharString &name, UErrorCode &errorCode) {
+    // The name distinguishes ICU versions (the builder may change)
+    // and root collation data versions.
+    // Hash collisions are detected via the rule string in the file.
+    name.append("rules" U_ICU_VERSION_SHORT "_", errorCode);
+    appendHex(name,
+              ((uint32_t)base->version[0] << 24) | ((uint32_t)base->version[1] << 16) |
+                  ((uint32_t)base->version[2] << 8) | base->version[3],
+              8, errorCode);
+    name.append('_', errorCode);
+    appendHex(name, (uint32_t)rules.hashCode(), 8, errorCode);
+    name.append('_', errorCode);
+    appendHex(name, (uint32_t)rules.length(), 1, errorCode);
+}
+
+CollationTailoring *
+CollationRulesCache::loadSnapshot(const CollationTailoring *base,
+                                  const UnicodeString &rules,
+                                  const char *dir, const char *name,
+                                  UErrorCode &errorCode) {
+    if(U_FAILURE(errorCode)) { return NULL; }
+    LocalPointer<CollationTailoring> t(new CollationTailoring(base->settings));
+    if(t.isNull() || t->isBogus()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return NULL;
+    }
+    // A missing, unreadable or stale snapshot is not an error:
+    // The caller builds the rules instead.
+    UErrorCode loadErrorCode = U_ZERO_ERROR;
+    t->memory = udata_openChoice(dir, SNAPSHOT_TYPE, name,
+                                 CollationDataReader::isAcceptable, t->version,
+                                 &loadErrorCode);
+    if(U_FAILURE(loadErrorCode)) { return NULL; }
+    // The file may be truncated or otherwise corrupt.
+    // Check every offset against the file length before reading there.
+    // If the length is not known, then the file cannot be checked and is not used.
+    const uint8_t *inBytes = static_cast<const uint8_t *>(udata_getRawMemory(t->memory));
+    int32_t headerLength = reinterpret_cast<const DataHeader *>(inBytes)->dataHeader.headerSize;
+    int32_t length = udata_getLength(t->memory);  // without the header
+    if(length < 4) { return NULL; }
+    const int32_t *inIndexes = reinterpret_cast<const int32_t *>(inBytes + headerLength);
+    int32_t indexesLength = inIndexes[CollationDataReader::IX_INDEXES_LENGTH];
+    if(indexesLength < 2 || indexesLength > length / 4) { return NULL; }
+    int32_t dataLength = getDataLength(inIndexes);
+    if(dataLength < indexesLength * 4 || dataLength > length) { return NULL; }
+    length += headerLength;
+    int32_t rulesOffset = (headerLength + dataLength + 3) & ~3;
+    if(rulesOffset > length - 4) { return NULL; }
+    const int32_t *rulesLength = reinterpret_cast<const int32_t *>(inBytes + rulesOffset);
+    if(*rulesLength < 0 || *rulesLength > (length - rulesOffset - 4) / U_SIZEOF_UCHAR) {
+        return NULL;
+    }
+    if(*rulesLength != rules.length() ||
+            rules.compare(reinterpret_cast<const UChar *>(rulesLength + 1), *rulesLength) != 0) {
+        return NULL;
+    }
+    CollationDataReader::read(base, inBytes, rulesOffset, *t, loadErrorCode);
+    if(U_FAILURE(loadErrorCode)) { return NULL; }
+    t->rules = rules;
+    t->rules.getTerminatedBuffer();  // ensure NUL-termination
+    return t.orphan();
+}
+
+void
+CollationRulesCache::writeSnapshot(const CollationTailoring &t,
+                                   const char *dir, const char *name) {
+#if UCONFIG_NO_FILE_IO
+    (void)t;
+    (void)dir;
+    (void)name;
+#else
+    UErrorCode errorCode = U_ZERO_ERROR;
+    int32_t indexes[CollationDataReader::IX_TOTAL_SIZE + 1];
+    int32_t length = CollationDataWriter::writeTailoring(
+            t, *t.settings, indexes, NULL, 0, errorCode);
+    if(errorCode != U_BUFFER_OVERFLOW_ERROR) { return; }
+    errorCode = U_ZERO_ERROR;
+    int32_t rulesOffset = (length + 3) & ~3;
+    int32_t rulesLength = t.rules.length();
+    int32_t fileLength = rulesOffset + 4 + rulesLength * U_SIZEOF_UCHAR;
+    MaybeStackArray<uint8_t, 4096> buffer;
+    if(buffer.resize(fileLength) == NULL) { return; }
+    uint8_t *bytes = buffer.getAlias();
+    length = CollationDataWriter::writeTailoring(
+            t, *t.settings, indexes, bytes, fileLength, errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    const DataHeader *header = reinterpret_cast<const DataHeader *>(bytes);
+    int32_t headerLength = header->dataHeader.headerSize;
+    int32_t dataLength = getDataLength(reinterpret_cast<const int32_t *>(bytes + headerLength));
+    if(((headerLength + dataLength + 3) & ~3) != rulesOffset) {
+        return;  // The reader would not find the rules.
+    }
+    uprv_memset(bytes + length, 0, rulesOffset - length);
+    uprv_memcpy(bytes + rulesOffset, &rulesLength, 4);
+    uprv_memcpy(bytes + rulesOffset + 4, t.rules.getBuffer(), rulesLength * U_SIZEOF_UCHAR);
+
+    CharString path, tempPath;
+    path.append(dir, errorCode).append(name, errorCode).
+        append('.', errorCode).append(SNAPSHOT_TYPE, errorCode);
+    // Make the temporary name unique enough for concurrent writers,
+    // in this and in other processes.
+    tempPath.append(path, errorCode).append('.', errorCode);
+    appendHex(tempPath, (uint32_t)(int64_t)uprv_getUTCtime(), 8, errorCode);
+    appendHex(tempPath, (uint32_t)(uintptr_t)&t, 8, errorCode);
+    tempPath.append(".tmp", errorCode);
+    if(U_FAILURE(errorCode)) { return; }
+    FILE *f = fopen(tempPath.data(), "wb");
+    if(f == NULL) { return; }
+    UBool ok = fwrite(bytes, 1, fileLength, f) == (size_t)fileLength;
+    ok &= fclose(f) == 0;
+    if(!ok || rename(tempPath.data(), path.data()) != 0) {
+        remove(tempPath.data());
+    }
+#endif  // !UCONFIG_NO_FILE_IO
+}
+
+U_NAMESPACE_END
+
+U_NAMESPACE_USE
+
+U_CAPI void U_EXPORT2
+ucol_setRulesSnapshotDirectory(const char *path, UErrorCode *pErrorCode) {
+    if(U_FAILURE(*pErrorCode)) { return; }
+    CollationRulesCache::setSnapshotDirectory(path, *pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_COLLATION
@@ -0,0 +1,87 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+* collationrulescache.h
+*
+* Cache of tailorings built from rule strings.
+*/
+
+#ifndef __COLLATIONRULESCACHE_H__
+#define __COLLATIONRULESCACHE_H__
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/unistr.h"
+
+U_NAMESPACE_BEGIN
+
+class CharString;
+struct CollationCacheEntry;
+struct CollationTailoring;
+
+/**
+ * Cache of tailorings built from rule strings, keyed by the rule string.
+ *
+ * Tailorings are shared via the UnifiedCache.
+ * On a cache miss, if a snapshot directory has been set,
+ * the tailoring is first loaded (memory-mapped) from a snapshot file
+ * which was written with the CollationDataWriter by an earlier build
+ * of the same rules, possibly in an earlier process.
+ * Otherwise the rules are built, and a snapshot file is written.
+ *
+ * Attributes that are set via API after building
+ * (e.g., ucol_openRules() strength & normalization mode)
+ * are not part of the tailoring and not part of the key.
+ */
+class U_I18N_API CollationRulesCache {  // purely static
+public:
+    /**
+     * Returns the cache entry for the tailoring built from the rules.
+     * Adds a reference to the returned entry.
+     * Does not provide parse error details; on failure,
+     * the caller should build the rules directly to get those.
+     */
+    static const CollationCacheEntry *getCacheEntry(const UnicodeString &rules,
+                                                    UErrorCode &errorCode);
+
+    /**
+     * Sets the directory for tailoring snapshot files.
+     * NULL or an empty path disables reading and writing snapshots.
+     * Does nothing if UCONFIG_NO_FILE_IO is set.
+     */
+    static void setSnapshotDirectory(const char *path, UErrorCode &errorCode);
+
+    /**
+     * Appends the snapshot file name (without directory and ".col" suffix)
+     * for the tailoring built from the rules.
+     */
+    static void getSnapshotName(const CollationTailoring *base,
+                                const UnicodeString &rules,
+                                CharString &name, UErrorCode &errorCode);
+
+    /** Called by the cache key on a cache miss. */
+    static const CollationCacheEntry *createCacheEntry(const CollationTailoring *base,
+                                                       const UnicodeString &rules,
+                                                       UErrorCode &errorCode);
+
+private:
+    /**
+     * Loads the tailoring from its snapshot file.
+     * Returns NULL without setting an error if there is no matching snapshot.
+     */
+    static CollationTailoring *loadSnapshot(const CollationTailoring *base,
+                                            const UnicodeString &rules,
+                                            const char *dir, const char *name,
+                                            UErrorCode &errorCode);
+    /** Writes the snapshot file. Failures are ignored. */
+    static void writeSnapshot(const CollationTailoring &t,
+                              const char *dir, const char *name);
+};
+
+U_NAMESPACE_END
+
+#endif  // !UCONFIG_NO_COLLATION
+#endif  // __COLLATIONRULESCACHE_H__
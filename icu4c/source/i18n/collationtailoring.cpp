@@ -37,7 +37,7 @@ CollationTailoring::CollationTailoring(const CollationSettings *baseSettings)
           actualLocale(""),
           ownedData(NULL),
           builder(NULL), memory(NULL), bundle(NULL),
-          trie(NULL), unsafeBackwardSet(NULL),
+          trie(NULL), unsafeBackwardSet(NULL), fastScriptTablesMemory(NULL),
           maxExpansions(NULL) {
     if(baseSettings != NULL) {
         U_ASSERT(baseSettings->reorderCodesLength == 0);
@@ -62,6 +62,7 @@ CollationTailoring::~CollationTailoring() {
     ures_close(bundle);
     utrie2_close(trie);
     delete unsafeBackwardSet;
+    uprv_free(fastScriptTablesMemory);
     uhash_close(maxExpansions);
     maxExpansionsInitOnce.reset();
 }
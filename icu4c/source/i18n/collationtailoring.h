@@ -81,6 +81,7 @@ struct U_I18N_API CollationTailoring : public SharedObject {
     UResourceBundle *bundle;
     UTrie2 *trie;
     UnicodeSet *unsafeBackwardSet;
+    uint16_t *fastScriptTablesMemory;
     mutable UHashtable *maxExpansions;
     mutable UInitOnce maxExpansionsInitOnce;
 
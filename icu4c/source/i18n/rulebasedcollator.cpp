@@ -87,6 +87,35 @@ FixedSortKeyByteSink::Resize(int32_t /*appendCapacity*/, int32_t /*length*/) {
     return FALSE;
 }
 
+/** Stops CollationKeys::writeSortKeyUpToQuaternary() after the primary level. */
+class PrimaryLevelCallback : public CollationKeys::LevelCallback {
+public:
+    virtual ~PrimaryLevelCallback();
+    virtual UBool needToWrite(Collation::Level /*level*/) { return FALSE; }
+};
+
+PrimaryLevelCallback::~PrimaryLevelCallback() {}
+
+/** Flag byte at the end of a primary prefix key whose primary weights were truncated. */
+const uint8_t PRIMARY_PREFIX_TRUNCATED_BYTE = 0xff;
+
+/** Number of strings per task in a parallel sort key batch. */
+const int32_t SORT_KEYS_PER_TASK = 1024;
+
+/** Shared by the tasks of a parallel sort key batch. */
+struct SortKeysTaskContext {
+    const RuleBasedCollator *coll;
+    const void *const *strings;
+    UBool isUTF8;
+    const int32_t *lengths;
+    int32_t count;
+    int32_t *offsets;
+    // Per task:
+    char **keys;
+    int32_t *keysLengths;
+    UErrorCode *errorCodes;
+};
+
 }  // namespace
 
 // Not in an anonymous namespace, so that it can be a friend of CollationKey.
@@ -694,6 +723,9 @@ RuleBasedCollator::setFastLatinOptions(CollationSettings &ownedSettings) const {
     ownedSettings.fastLatinOptions = CollationFastLatin::getOptions(
             data, ownedSettings,
             ownedSettings.fastLatinPrimaries, UPRV_LENGTHOF(ownedSettings.fastLatinPrimaries));
+    CollationFastLatin::getScriptOptions(
+            data, ownedSettings,
+            ownedSettings.fastScriptOptions, UPRV_LENGTHOF(ownedSettings.fastScriptOptions));
 }
 
 UCollationResult
@@ -1044,6 +1076,22 @@ RuleBasedCollator::doCompare(const UChar *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Greek or Cyrillic text (with ASCII digits, spaces & punctuation) has its own fast tables.
+        if(leftLength >= 0) {
+            result = CollationFastLatin::compareScriptsUTF16(data->fastScriptTables,
+                                                             settings->fastScriptOptions,
+                                                             left + equalPrefixLength,
+                                                             leftLength - equalPrefixLength,
+                                                             right + equalPrefixLength,
+                                                             rightLength - equalPrefixLength);
+        } else {
+            result = CollationFastLatin::compareScriptsUTF16(data->fastScriptTables,
+                                                             settings->fastScriptOptions,
+                                                             left + equalPrefixLength, -1,
+                                                             right + equalPrefixLength, -1);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1173,6 +1221,22 @@ RuleBasedCollator::doCompare(const uint8_t *left, int32_t leftLength,
     } else {
         result = CollationFastLatin::BAIL_OUT_RESULT;
     }
+    if(result == CollationFastLatin::BAIL_OUT_RESULT) {
+        // Greek or Cyrillic text (with ASCII digits, spaces & punctuation) has its own fast tables.
+        if(leftLength >= 0) {
+            result = CollationFastLatin::compareScriptsUTF8(data->fastScriptTables,
+                                                            settings->fastScriptOptions,
+                                                            left + equalPrefixLength,
+                                                            leftLength - equalPrefixLength,
+                                                            right + equalPrefixLength,
+                                                            rightLength - equalPrefixLength);
+        } else {
+            result = CollationFastLatin::compareScriptsUTF8(data->fastScriptTables,
+                                                            settings->fastScriptOptions,
+                                                            left + equalPrefixLength, -1,
+                                                            right + equalPrefixLength, -1);
+        }
+    }
 
     if(result == CollationFastLatin::BAIL_OUT_RESULT) {
         if(settings->dontCheckFCD()) {
@@ -1328,6 +1392,58 @@ RuleBasedCollator::getSortKey(const UChar *s, int32_t length,
     return U_SUCCESS(errorCode) ? sink.NumberOfBytesAppended() : 0;
 }
 
+int32_t
+RuleBasedCollator::getPrimaryPrefixKey(const UChar *s, int32_t length, int32_t maxPrimaryLength,
+                                       uint8_t *dest, int32_t destCapacity,
+                                       UErrorCode &errorCode) const {
+    if(U_FAILURE(errorCode)) { return 0; }
+    if((s == NULL && length != 0) || maxPrimaryLength < 0 ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    MaybeStackArray<char, 64> primaries;
+    if(maxPrimaryLength > primaries.getCapacity() &&
+            primaries.resize(maxPrimaryLength) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return 0;
+    }
+    // Not preflighting: Stop as soon as the primary weights do not fit.
+    FixedSortKeyByteSink sink(primaries.getAlias(), maxPrimaryLength);
+    const UChar *limit = (length >= 0) ? s + length : NULL;
+    UBool numeric = settings->isNumeric();
+    PrimaryLevelCallback callback;
+    if(settings->dontCheckFCD()) {
+        UTF16CollationIterator iter(data, numeric, s, s, limit);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    } else {
+        FCDUTF16CollationIterator iter(data, numeric, s, s, limit);
+        CollationKeys::writeSortKeyUpToQuaternary(iter, data->compressibleBytes, *settings,
+                                                  sink, Collation::PRIMARY_LEVEL,
+                                                  callback, FALSE, errorCode);
+    }
+    if(U_FAILURE(errorCode)) { return 0; }
+    int32_t primaryLength = sink.NumberOfBytesAppended();
+    uint8_t flag;
+    if(primaryLength <= maxPrimaryLength) {
+        flag = Collation::LEVEL_SEPARATOR_BYTE;
+    } else {
+        primaryLength = maxPrimaryLength;
+        flag = PRIMARY_PREFIX_TRUNCATED_BYTE;
+    }
+    int32_t keyLength = primaryLength + 2;
+    if(keyLength > destCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+        return keyLength;
+    }
+    uprv_memcpy(dest, primaries.getAlias(), primaryLength);
+    dest[primaryLength] = flag;
+    dest[primaryLength + 1] = 0;  // TERMINATOR_BYTE
+    return keyLength;
+}
+
 void
 RuleBasedCollator::writeSortKey(const UChar *s, int32_t length,
                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
@@ -1379,6 +1495,194 @@ RuleBasedCollator::writeIdenticalLevel(const UChar *s, const UChar *limit,
     u_writeIdenticalLevelRun(prev, nfd.getBuffer(), nfd.length(), sink);
 }
 
+void
+RuleBasedCollator::writeSortKeys(const UChar *const *strings, const int32_t *lengths,
+                                 int32_t start, int32_t limit, int32_t *offsets,
+                                 SortKeyByteSink &sink, UErrorCode &errorCode) const {
+    // Adjacent strings often share prefixes (sorted or clustered input),
+    // and the writer resumes from the state after the shared text.
+    IncrementalSortKeyWriter writer(data, *settings);
+    static const char terminator = 0;  // TERMINATOR_BYTE
+    for (int32_t i = start; i < limit && U_SUCCESS(errorCode); ++i) {
+        offsets[i] = sink.NumberOfBytesAppended();
+        const UChar *s = strings[i];
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (s == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if (length < 0) {
+            length = u_strlen(s);
+        }
+        const UChar *next = NULL;
+        int32_t nextLength = 0;
+        if ((i + 1) < limit && (next = strings[i + 1]) != NULL) {
+            nextLength = lengths != NULL ? lengths[i + 1] : -1;
+            if (nextLength < 0) {
+                nextLength = u_strlen(next);
+            }
+        }
+        writer.writeSortKey(s, length, next, nextLength, sink, errorCode);
+        if (settings->getStrength() == UCOL_IDENTICAL) {
+            writeIdenticalLevel(s, s + length, sink, errorCode);
+        }
+        sink.Append(&terminator, 1);
+    }
+}
+
+void
+RuleBasedCollator::writeSortKeysUTF8(const char *const *strings, const int32_t *lengths,
+                                     int32_t start, int32_t limit, int32_t *offsets,
+                                     SortKeyByteSink &sink, UErrorCode &errorCode) const {
+    // See writeSortKeys().
+    IncrementalSortKeyWriter writer(data, *settings);
+    UnicodeString s16;  // for the identical level
+    static const char terminator = 0;  // TERMINATOR_BYTE
+    for (int32_t i = start; i < limit && U_SUCCESS(errorCode); ++i) {
+        offsets[i] = sink.NumberOfBytesAppended();
+        const char *s = strings[i];
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (s == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if (length < 0) {
+            length = static_cast<int32_t>(uprv_strlen(s));
+        }
+        const char *next = NULL;
+        int32_t nextLength = 0;
+        if ((i + 1) < limit && (next = strings[i + 1]) != NULL) {
+            nextLength = lengths != NULL ? lengths[i + 1] : -1;
+            if (nextLength < 0) {
+                nextLength = static_cast<int32_t>(uprv_strlen(next));
+            }
+        }
+        writer.writeSortKey(reinterpret_cast<const uint8_t *>(s), length,
+                            reinterpret_cast<const uint8_t *>(next), nextLength,
+                            sink, errorCode);
+        if (settings->getStrength() == UCOL_IDENTICAL) {
+            s16 = UnicodeString::fromUTF8(StringPiece(s, length));
+            writeIdenticalLevel(s16.getBuffer(), s16.getBuffer() + s16.length(), sink, errorCode);
+        }
+        sink.Append(&terminator, 1);
+    }
+}
+
+void U_CALLCONV
+RuleBasedCollator::sortKeysTask(void *context, int32_t index) {
+    SortKeysTaskContext &c = *static_cast<SortKeysTaskContext *>(context);
+    int32_t start = index * SORT_KEYS_PER_TASK;
+    int32_t limit = c.count - start > SORT_KEYS_PER_TASK ? start + SORT_KEYS_PER_TASK : c.count;
+    UErrorCode &errorCode = c.errorCodes[index];
+    GrowingSortKeyByteSink sink(SORT_KEYS_PER_TASK * 16);
+    if (c.isUTF8) {
+        c.coll->writeSortKeysUTF8(reinterpret_cast<const char *const *>(c.strings), c.lengths,
+                                  start, limit, c.offsets, sink, errorCode);
+    } else {
+        c.coll->writeSortKeys(reinterpret_cast<const UChar *const *>(c.strings), c.lengths,
+                              start, limit, c.offsets, sink, errorCode);
+    }
+    if (U_SUCCESS(errorCode) && !sink.IsOk()) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+    }
+    c.keysLengths[index] = sink.NumberOfBytesAppended();
+    c.keys[index] = sink.orphanBuffer();
+}
+
+int32_t
+RuleBasedCollator::getSortKeysInBatches(const void *const *strings, UBool isUTF8,
+                                        const int32_t *lengths, int32_t count,
+                                        uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                                        UCollationTaskRunner *runner, const void *runnerContext,
+                                        UErrorCode &errorCode) const {
+    if (U_FAILURE(errorCode)) { return 0; }
+    if (count < 0 || (strings == NULL && count > 0) || offsets == NULL ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t total = 0;
+    int32_t numTasks = (count + SORT_KEYS_PER_TASK - 1) / SORT_KEYS_PER_TASK;
+    if (runner == NULL || numTasks < 2) {
+        // Serial: Write all keys directly into dest, counting beyond its capacity.
+        uint8_t noDest[1] = { 0 };
+        FixedSortKeyByteSink sink(reinterpret_cast<char *>(dest != NULL ? dest : noDest),
+                                  destCapacity);
+        if (isUTF8) {
+            writeSortKeysUTF8(reinterpret_cast<const char *const *>(strings), lengths,
+                              0, count, offsets, sink, errorCode);
+        } else {
+            writeSortKeys(reinterpret_cast<const UChar *const *>(strings), lengths,
+                          0, count, offsets, sink, errorCode);
+        }
+        total = sink.NumberOfBytesAppended();
+    } else {
+        // Parallel: Each task writes the keys for a group of strings into its own buffer,
+        // with offsets relative to that buffer. Then concatenate the groups.
+        LocalMemory<char *> keys;
+        LocalMemory<int32_t> keysLengths;
+        LocalMemory<UErrorCode> errorCodes;
+        if (keys.allocateInsteadAndReset(numTasks) == NULL ||
+                keysLengths.allocateInsteadAndReset(numTasks) == NULL ||
+                errorCodes.allocateInsteadAndReset(numTasks) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+        SortKeysTaskContext context = {
+            this, strings, isUTF8, lengths, count, offsets,
+            keys.getAlias(), keysLengths.getAlias(), errorCodes.getAlias()
+        };
+        runner(runnerContext, sortKeysTask, &context, numTasks);
+        for (int32_t t = 0; t < numTasks; ++t) {
+            if (U_FAILURE(errorCodes[t])) {
+                if (U_SUCCESS(errorCode)) { errorCode = errorCodes[t]; }
+            } else if (U_SUCCESS(errorCode)) {
+                if (keysLengths[t] > INT32_MAX - total) {
+                    errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+                } else {
+                    int32_t start = t * SORT_KEYS_PER_TASK;
+                    int32_t limit = count - start > SORT_KEYS_PER_TASK ?
+                        start + SORT_KEYS_PER_TASK : count;
+                    for (int32_t i = start; i < limit; ++i) {
+                        offsets[i] += total;
+                    }
+                    if (keysLengths[t] <= destCapacity - total) {
+                        uprv_memcpy(dest + total, keys[t], keysLengths[t]);
+                    }
+                    total += keysLengths[t];
+                }
+            }
+            uprv_free(keys[t]);
+        }
+    }
+    if (U_FAILURE(errorCode)) { return 0; }
+    offsets[count] = total;
+    if (total > destCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return total;
+}
+
+int32_t
+RuleBasedCollator::getSortKeys(const UChar *const *strings, const int32_t *lengths, int32_t count,
+                               uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                               UCollationTaskRunner *runner, const void *runnerContext,
+                               UErrorCode &errorCode) const {
+    return getSortKeysInBatches(reinterpret_cast<const void *const *>(strings), FALSE,
+                                lengths, count, dest, destCapacity, offsets,
+                                runner, runnerContext, errorCode);
+}
+
+int32_t
+RuleBasedCollator::getSortKeysUTF8(const char *const *strings, const int32_t *lengths, int32_t count,
+                                   uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                                   UCollationTaskRunner *runner, const void *runnerContext,
+                                   UErrorCode &errorCode) const {
+    return getSortKeysInBatches(reinterpret_cast<const void *const *>(strings), TRUE,
+                                lengths, count, dest, destCapacity, offsets,
+                                runner, runnerContext, errorCode);
+}
+
 namespace {
 
 /**
@@ -36,7 +36,6 @@
 #include "unicode/sortkey.h"
 #include "cmemory.h"
 #include "uelement.h"
-#include "ustr_imp.h"
 
 U_NAMESPACE_BEGIN
 
@@ -177,6 +176,47 @@ CollationKey::compareTo(const CollationKey& target) const
     return static_cast<Collator::EComparisonResult>(compareTo(target, errorCode));
 }
 
+namespace {
+
+// Reads 8 key bytes as a big-endian word, so that comparing words
+// is equivalent to comparing the bytes.
+// Compilers turn this into a single load (plus a byte swap where necessary).
+inline uint64_t readWord(const uint8_t *p) {
+    return ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+           ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+           ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+           ((uint64_t)p[6] << 8) | p[7];
+}
+
+/**
+ * Compares the first length bytes of the two keys, eight at a time.
+ * Sort keys are usually short and differ early,
+ * where this is faster than calling memcmp().
+ */
+inline int32_t compareKeyBytes(const uint8_t *src, const uint8_t *tgt, int32_t length) {
+    while (length >= 8) {
+        uint64_t s = readWord(src);
+        uint64_t t = readWord(tgt);
+        if (s != t) {
+            return s < t ? -1 : 1;
+        }
+        src += 8;
+        tgt += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        if (*src != *tgt) {
+            return *src < *tgt ? -1 : 1;
+        }
+        ++src;
+        ++tgt;
+        --length;
+    }
+    return 0;
+}
+
+}  // namespace
+
 // Bitwise comparison for the collation keys.
 UCollationResult
 CollationKey::compareTo(const CollationKey& target, UErrorCode &status) const
@@ -204,7 +244,7 @@ CollationKey::compareTo(const CollationKey& target, UErrorCode &status) const
     }
 
     if (minLength > 0) {
-        int diff = uprv_memcmp(src, tgt, minLength);
+        int32_t diff = compareKeyBytes(src, tgt, minLength);
         if (diff > 0) {
             return UCOL_GREATER;
         }
@@ -243,14 +283,32 @@ CollationKey::toByteArray(int32_t& count) const
 }
 #endif
 
+// Hashes all of the key bytes, eight at a time.
+// (Keys with long common prefixes are common,
+// so unlike ustr_hashCharsN() this does not skip any bytes.)
 static int32_t
 computeHashCode(const uint8_t *key, int32_t  length) {
-    const char *s = reinterpret_cast<const char *>(key);
     int32_t hash;
-    if (s == NULL || length == 0) {
+    if (key == NULL || length == 0) {
         hash = kEmptyHashCode;
     } else {
-        hash = ustr_hashCharsN(s, length);
+        static const uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+        uint64_t h = (uint64_t)length * kMultiplier;
+        const uint8_t *limit = key + length;
+        while ((limit - key) >= 8) {
+            h = (h ^ readWord(key)) * kMultiplier;
+            h ^= h >> 32;
+            key += 8;
+        }
+        if (key < limit) {
+            uint64_t w = 0;
+            do {
+                w = (w << 8) | *key++;
+            } while (key < limit);
+            h = (h ^ w) * kMultiplier;
+            h ^= h >> 32;
+        }
+        hash = (int32_t)(uint32_t)((h * kMultiplier) >> 32);
         if (hash == kInvalidHashCode || hash == kBogusHashCode) {
             hash = kEmptyHashCode;
         }
@@ -284,4 +342,15 @@ ucol_keyHashCode(const uint8_t *key,
     return icu::computeHashCode(key, length);
 }
 
+U_CAPI void U_EXPORT2
+ucol_keyHashCodes(const uint8_t *const *keys,
+                  const int32_t        *lengths,
+                        int32_t         count,
+                        int32_t        *hashCodes)
+{
+    for (int32_t i = 0; i < count; ++i) {
+        hashCodes[i] = icu::computeHashCode(keys[i], lengths[i]);
+    }
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -56,6 +56,7 @@ typedef enum ECleanupI18NType {
     UCLN_I18N_UCOL_RES,
     UCLN_I18N_CSDET,
     UCLN_I18N_COLLATION_ROOT,
+    UCLN_I18N_COLLATION_RULES_CACHE,
     UCLN_I18N_GENDERINFO,
     UCLN_I18N_CDFINFO,
     UCLN_I18N_REGION,
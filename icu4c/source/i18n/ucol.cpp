@@ -209,6 +209,267 @@ ucol_getSortKey(const    UCollator    *coll,
     return keySize;
 }
 
+namespace {
+
+/**
+ * Batch sort keys for Collator subclasses other than RuleBasedCollator:
+ * One getSortKey() call per string.
+ */
+int32_t
+getSortKeysOneByOne(const Collator &coll,
+                    const void *const *strings, UBool isUTF8,
+                    const int32_t *lengths, int32_t count,
+                    uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                    UErrorCode &errorCode) {
+    if (count < 0 || (strings == NULL && count > 0) || offsets == NULL ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t total = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        offsets[i] = total;
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (strings[i] == NULL && length != 0) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        UnicodeString s;
+        if (isUTF8) {
+            const char *s8 = static_cast<const char *>(strings[i]);
+            if (length < 0) {
+                length = static_cast<int32_t>(uprv_strlen(s8));
+            }
+            s = UnicodeString::fromUTF8(StringPiece(s8, length));
+        } else {
+            s.setTo(length < 0, ConstChar16Ptr(static_cast<const UChar *>(strings[i])), length);
+        }
+        int32_t available = total < destCapacity ? destCapacity - total : 0;
+        int32_t keyLength = coll.getSortKey(s, available > 0 ? dest + total : NULL, available);
+        if (keyLength == 0) {
+            errorCode = U_INTERNAL_PROGRAM_ERROR;
+            return 0;
+        }
+        if (keyLength > INT32_MAX - total) {
+            errorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        total += keyLength;
+    }
+    offsets[count] = total;
+    if (total > destCapacity) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return total;
+}
+
+}  // namespace
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *strings, const int32_t *lengths, int32_t count,
+                 uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                 UCollationTaskRunner *runner, const void *runnerContext,
+                 UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc != NULL) {
+        return rbc->getSortKeys(strings, lengths, count, dest, destCapacity, offsets,
+                                runner, runnerContext, *pErrorCode);
+    }
+    return getSortKeysOneByOne(*Collator::fromUCollator(coll),
+                               reinterpret_cast<const void *const *>(strings), FALSE,
+                               lengths, count, dest, destCapacity, offsets, *pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const *strings, const int32_t *lengths, int32_t count,
+                     uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                     UCollationTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc != NULL) {
+        return rbc->getSortKeysUTF8(strings, lengths, count, dest, destCapacity, offsets,
+                                    runner, runnerContext, *pErrorCode);
+    }
+    return getSortKeysOneByOne(*Collator::fromUCollator(coll),
+                               reinterpret_cast<const void *const *>(strings), TRUE,
+                               lengths, count, dest, destCapacity, offsets, *pErrorCode);
+}
+
+namespace {
+
+/**
+ * Primary prefix key for Collator subclasses other than RuleBasedCollator:
+ * Copies the primary level from the full sort key.
+ */
+int32_t
+getPrimaryPrefixKeyFromSortKey(const Collator &coll,
+                               const UChar *source, int32_t sourceLength,
+                               int32_t maxPrimaryLength,
+                               uint8_t *result, int32_t resultLength,
+                               UErrorCode &errorCode) {
+    if ((source == NULL && sourceLength != 0) || maxPrimaryLength < 0 ||
+            resultLength < 0 || (result == NULL && resultLength > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    UnicodeString s(sourceLength < 0, ConstChar16Ptr(source), sourceLength);
+    MaybeStackArray<uint8_t, 200> key;
+    int32_t keyLength = coll.getSortKey(s, key.getAlias(), key.getCapacity());
+    if (keyLength > key.getCapacity()) {
+        if (key.resize(keyLength) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return 0;
+        }
+        keyLength = coll.getSortKey(s, key.getAlias(), keyLength);
+    }
+    if (keyLength == 0) {
+        errorCode = U_INTERNAL_PROGRAM_ERROR;
+        return 0;
+    }
+    // The primary level ends with a 01 level separator or the 00 terminator.
+    int32_t primaryLength = 0;
+    while (key[primaryLength] > 1) { ++primaryLength; }
+    uint8_t flag = 1;
+    if (primaryLength > maxPrimaryLength) {
+        primaryLength = maxPrimaryLength;
+        flag = 0xff;
+    }
+    int32_t prefixKeyLength = primaryLength + 2;
+    if (prefixKeyLength > resultLength) {
+        errorCode = U_BUFFER_OVERFLOW_ERROR;
+        return prefixKeyLength;
+    }
+    uprv_memcpy(result, key.getAlias(), primaryLength);
+    result[primaryLength] = flag;
+    result[primaryLength + 1] = 0;
+    return prefixKeyLength;
+}
+
+}  // namespace
+
+U_CAPI int32_t U_EXPORT2
+ucol_getPrimaryPrefixKey(const UCollator *coll,
+                         const UChar *source, int32_t sourceLength,
+                         int32_t maxPrimaryLength,
+                         uint8_t *result, int32_t resultLength,
+                         UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    const RuleBasedCollator *rbc = RuleBasedCollator::rbcFromUCollator(coll);
+    if (rbc != NULL) {
+        return rbc->getPrimaryPrefixKey(source, sourceLength, maxPrimaryLength,
+                                        result, resultLength, *pErrorCode);
+    }
+    return getPrimaryPrefixKeyFromSortKey(*Collator::fromUCollator(coll),
+                                          source, sourceLength, maxPrimaryLength,
+                                          result, resultLength, *pErrorCode);
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_frontCodeSortKeys(const uint8_t *keys, const int32_t *offsets, int32_t count,
+                       uint8_t *dest, int32_t destCapacity,
+                       UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if (count < 0 || (count > 0 && (keys == NULL || offsets == NULL)) ||
+            destCapacity < 0 || (dest == NULL && destCapacity > 0)) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    const uint8_t *prev = NULL;
+    int32_t prevLength = 0;
+    int32_t length = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        const uint8_t *key = keys + offsets[i];
+        int32_t keyLength = offsets[i + 1] - offsets[i];
+        if (keyLength <= 0 || key[keyLength - 1] != 0) {
+            *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return 0;
+        }
+        // Always write at least the zero byte that ends the key.
+        int32_t sharedLimit = prevLength < keyLength ? prevLength : keyLength - 1;
+        int32_t shared = 0;
+        while (shared < sharedLimit && prev[shared] == key[shared]) { ++shared; }
+        if (shared > 0x7fff) { shared = 0x7fff; }
+        int32_t suffixLength = keyLength - shared;
+        int32_t codedLength = (shared < 0x80 ? 1 : 2) + suffixLength;
+        if (codedLength > INT32_MAX - length) {
+            *pErrorCode = U_INDEX_OUTOFBOUNDS_ERROR;
+            return 0;
+        }
+        if (codedLength <= destCapacity - length) {
+            uint8_t *p = dest + length;
+            if (shared < 0x80) {
+                *p++ = (uint8_t)shared;
+            } else {
+                *p++ = (uint8_t)(0x80 | (shared >> 8));
+                *p++ = (uint8_t)shared;
+            }
+            uprv_memcpy(p, key + shared, suffixLength);
+        }
+        length += codedLength;
+        prev = key;
+        prevLength = keyLength;
+    }
+    if (length > destCapacity) {
+        *pErrorCode = U_BUFFER_OVERFLOW_ERROR;
+    }
+    return length;
+}
+
+U_CAPI int32_t U_EXPORT2
+ucol_nextFrontCodedSortKey(const uint8_t *src, int32_t srcLength, int32_t *pIndex,
+                           uint8_t *key, int32_t keyCapacity, int32_t prevKeyLength,
+                           UErrorCode *pErrorCode) {
+    if (U_FAILURE(*pErrorCode)) {
+        return 0;
+    }
+    if ((src == NULL && srcLength != 0) || srcLength < 0 || pIndex == NULL ||
+            *pIndex < 0 || *pIndex > srcLength || keyCapacity < 0 ||
+            (key == NULL && keyCapacity > 0) || prevKeyLength < 0 || prevKeyLength > keyCapacity) {
+        *pErrorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return 0;
+    }
+    int32_t i = *pIndex;
+    if (i == srcLength) {
+        return 0;
+    }
+    int32_t shared = src[i++];
+    if (shared >= 0x80) {
+        if (i == srcLength) {
+            *pErrorCode = U_INVALID_FORMAT_ERROR;
+            return 0;
+        }
+        shared = ((shared & 0x7f) << 8) | src[i++];
+    }
+    const uint8_t *suffix = src + i;
+    const uint8_t *terminator =
+        static_cast<const uint8_t *>(uprv_memchr(suffix, 0, srcLength - i));
+    if (shared > prevKeyLength || terminator == NULL) {
+        *pErrorCode = U_INVALID_FORMAT_ERROR;
+        return 0;
+    }
+    int32_t suffixLength = (int32_t)(terminator - suffix) + 1;
+    int32_t keyLength = shared + suffixLength;
+    if (keyLength > keyCapacity) {
+        *pErrorCode = U_BUFFER_OVERFLOW_ERROR;
+        return keyLength;
+    }
+    uprv_memcpy(key + shared, suffix, suffixLength);
+    *pIndex = i + suffixLength;
+    return keyLength;
+}
+
 U_CAPI int32_t U_EXPORT2
 ucol_nextSortKeyPart(const UCollator *coll,
                      UCharIterator *iter,
@@ -0,0 +1,428 @@
+// © 2019 and later: Unicode, Inc. and others.
+// License & terms of use: http://www.unicode.org/copyright.html
+/*
+*******************************************************************************
+*   file name:  ucol_sort.cpp
+*   encoding:   UTF-8
+*   tab size:   8 (not used)
+*   indentation:4
+*
+*   Sorting arrays of strings with a collator (ucol_sortStrings() etc.).
+*
+*   Small arrays are merge-sorted with string comparisons.
+*   For larger arrays, the sort keys of all strings are written into one
+*   buffer, and an array of (key prefix, string index) items is merge-sorted.
+*   The first four sort key bytes are cached in each item so that
+*   most comparisons need not touch the keys themselves.
+*   With a task runner, the keys are computed concurrently (by ucol_getSortKeys()),
+*   runs of items are sorted concurrently, and each merge pass merges
+*   pairs of runs concurrently.
+*/
+
+#include "unicode/utypes.h"
+
+#if !UCONFIG_NO_COLLATION
+
+#include "unicode/coll.h"
+#include "unicode/stringpiece.h"
+#include "unicode/ucol.h"
+#include "unicode/ustring.h"
+#include "cmemory.h"
+#include "cstring.h"
+
+U_NAMESPACE_USE
+
+namespace {
+
+/**
+ * Arrays with fewer strings are sorted by comparing the strings.
+ * A sort key costs about as much as a few full string comparisons,
+ * and a merge sort of n strings makes up to n*log2(n) comparisons.
+ */
+const int32_t MIN_SORT_KEY_SORT_COUNT = 48;
+
+/** Runs of up to this many items are sorted with insertion sort. */
+const int32_t INSERTION_SORT_LENGTH = 12;
+
+/**
+ * Number of items sorted by one task before the merge passes.
+ * Arrays with fewer than two such runs are sorted serially.
+ */
+const int32_t SORT_ITEMS_PER_TASK = 4096;
+
+struct SortItem {
+    /** The first four bytes of the sort key, big-endian; zero-padded after the terminator. */
+    uint32_t prefix;
+    /** Index of the string in the input array. */
+    int32_t index;
+};
+
+/**
+ * Compares items by their sort keys.
+ * Ties are broken by the string index, which makes every sort stable.
+ */
+class SortKeyComparator {
+public:
+    SortKeyComparator(const uint8_t *k, const int32_t *o) : keys(k), offsets(o) {}
+
+    bool lessOrEqual(const SortItem &left, const SortItem &right) const {
+        if (left.prefix != right.prefix) {
+            return left.prefix < right.prefix;
+        }
+        // Sort keys contain no zero bytes except for the terminator.
+        // If the terminator is among the first four bytes, then the keys are equal.
+        if ((left.prefix & 0xff) != 0) {
+            int32_t cmp = uprv_strcmp(
+                reinterpret_cast<const char *>(keys + offsets[left.index] + 4),
+                reinterpret_cast<const char *>(keys + offsets[right.index] + 4));
+            if (cmp != 0) {
+                return cmp < 0;
+            }
+        }
+        return left.index <= right.index;
+    }
+
+private:
+    const uint8_t *keys;
+    const int32_t *offsets;
+};
+
+inline UCollationResult
+compareStrings(const Collator &coll, const UChar *left, int32_t leftLength,
+               const UChar *right, int32_t rightLength, UErrorCode &errorCode) {
+    return coll.compare(left, leftLength, right, rightLength, errorCode);
+}
+
+inline UCollationResult
+compareStrings(const Collator &coll, const char *left, int32_t leftLength,
+               const char *right, int32_t rightLength, UErrorCode &errorCode) {
+    return coll.compareUTF8(
+        leftLength >= 0 ? StringPiece(left, leftLength) : StringPiece(left),
+        rightLength >= 0 ? StringPiece(right, rightLength) : StringPiece(right),
+        errorCode);
+}
+
+/**
+ * Compares string indexes by comparing the strings with the collator.
+ * Ties are broken by the string index.
+ */
+template<typename CharType>
+class StringComparator {
+public:
+    StringComparator(const Collator &c, const CharType *const *s, const int32_t *l,
+                     UErrorCode &ec)
+            : coll(c), strings(s), lengths(l), errorCode(ec) {}
+
+    bool lessOrEqual(int32_t left, int32_t right) const {
+        UCollationResult result = compareStrings(
+            coll,
+            strings[left], lengths != NULL ? lengths[left] : -1,
+            strings[right], lengths != NULL ? lengths[right] : -1,
+            errorCode);
+        return result < 0 || (result == 0 && left <= right);
+    }
+
+private:
+    const Collator &coll;
+    const CharType *const *strings;
+    const int32_t *lengths;
+    UErrorCode &errorCode;
+};
+
+template<typename Item, typename Comparator>
+void
+insertionSort(Item *items, int32_t length, const Comparator &cmp) {
+    for (int32_t i = 1; i < length; ++i) {
+        Item item = items[i];
+        int32_t j = i;
+        while (j > 0 && !cmp.lessOrEqual(items[j - 1], item)) {
+            items[j] = items[j - 1];
+            --j;
+        }
+        items[j] = item;
+    }
+}
+
+/** Merges the sorted src[start..middle[ and src[middle..limit[ into dest[start..limit[. */
+template<typename Item, typename Comparator>
+void
+mergeRuns(const Item *src, int32_t start, int32_t middle, int32_t limit,
+          Item *dest, const Comparator &cmp) {
+    int32_t i = start, j = middle, k = start;
+    while (i < middle && j < limit) {
+        if (cmp.lessOrEqual(src[i], src[j])) {
+            dest[k++] = src[i++];
+        } else {
+            dest[k++] = src[j++];
+        }
+    }
+    if (i < middle) {
+        uprv_memcpy(dest + k, src + i, (middle - i) * sizeof(Item));
+    } else if (j < limit) {
+        uprv_memcpy(dest + k, src + j, (limit - j) * sizeof(Item));
+    }
+}
+
+/** Sorts items[0..length[, using temp[0..length[ as scratch space. */
+template<typename Item, typename Comparator>
+void
+mergeSort(Item *items, Item *temp, int32_t length, const Comparator &cmp) {
+    if (length <= INSERTION_SORT_LENGTH) {
+        insertionSort(items, length, cmp);
+        return;
+    }
+    int32_t middle = length / 2;
+    mergeSort(items, temp, middle, cmp);
+    mergeSort(items + middle, temp + middle, length - middle, cmp);
+    if (cmp.lessOrEqual(items[middle - 1], items[middle])) {
+        return;  // already in order
+    }
+    uprv_memcpy(temp, items, length * sizeof(Item));
+    mergeRuns(temp, 0, middle, length, items, cmp);
+}
+
+struct SortTaskContext {
+    SortTaskContext(SortItem *i, SortItem *t, int32_t c, const SortKeyComparator &kc)
+            : items(i), temp(t), count(c), cmp(kc), src(NULL), dest(NULL), runLength(0) {}
+
+    SortItem *items;
+    SortItem *temp;
+    int32_t count;
+    const SortKeyComparator &cmp;
+    // Merge pass state.
+    const SortItem *src;
+    SortItem *dest;
+    int32_t runLength;
+};
+
+/** Task i sorts the i-th run of SORT_ITEMS_PER_TASK items. */
+void U_CALLCONV
+sortRunTask(void *context, int32_t index) {
+    SortTaskContext &c = *static_cast<SortTaskContext *>(context);
+    int32_t start = index * SORT_ITEMS_PER_TASK;
+    int32_t length = c.count - start > SORT_ITEMS_PER_TASK ? SORT_ITEMS_PER_TASK : c.count - start;
+    mergeSort(c.items + start, c.temp + start, length, c.cmp);
+}
+
+/** Task i merges the i-th pair of runs from c.src into c.dest. */
+void U_CALLCONV
+mergeRunsTask(void *context, int32_t index) {
+    SortTaskContext &c = *static_cast<SortTaskContext *>(context);
+    int32_t start = index * 2 * c.runLength;
+    int32_t middle = c.count - start > c.runLength ? start + c.runLength : c.count;
+    int32_t limit = c.count - middle > c.runLength ? middle + c.runLength : c.count;
+    mergeRuns(c.src, start, middle, limit, c.dest, c.cmp);
+}
+
+/**
+ * Sorts the items; with a runner, in concurrent runs followed by merge passes.
+ * The result is in items[].
+ */
+void
+sortItems(SortItem *items, SortItem *temp, int32_t count, const SortKeyComparator &cmp,
+          UCollationTaskRunner *runner, const void *runnerContext) {
+    if (runner == NULL || count < 2 * SORT_ITEMS_PER_TASK) {
+        mergeSort(items, temp, count, cmp);
+        return;
+    }
+    SortTaskContext context(items, temp, count, cmp);
+    runner(runnerContext, sortRunTask, &context,
+           (count + SORT_ITEMS_PER_TASK - 1) / SORT_ITEMS_PER_TASK);
+    context.src = items;
+    context.dest = temp;
+    for (int32_t runLength = SORT_ITEMS_PER_TASK;; runLength *= 2) {
+        context.runLength = runLength;
+        // A trailing single run is copied by its "merge" with an empty run.
+        runner(runnerContext, mergeRunsTask, &context, (count - 1) / (2 * runLength) + 1);
+        const SortItem *src = context.src;
+        context.src = context.dest;
+        context.dest = const_cast<SortItem *>(src);
+        if (runLength >= count - runLength) {
+            break;  // one run of 2*runLength>=count items
+        }
+    }
+    if (context.src != items) {
+        uprv_memcpy(items, context.src, count * sizeof(SortItem));
+    }
+}
+
+inline int32_t getLength(const UChar *s) { return u_strlen(s); }
+inline int32_t getLength(const char *s) { return static_cast<int32_t>(uprv_strlen(s)); }
+
+inline int32_t
+getSortKeys(const UCollator *coll,
+            const UChar *const *strings, const int32_t *lengths, int32_t count,
+            uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+            UCollationTaskRunner *runner, const void *runnerContext,
+            UErrorCode &errorCode) {
+    return ucol_getSortKeys(coll, strings, lengths, count, dest, destCapacity, offsets,
+                            runner, runnerContext, &errorCode);
+}
+
+inline int32_t
+getSortKeys(const UCollator *coll,
+            const char *const *strings, const int32_t *lengths, int32_t count,
+            uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+            UCollationTaskRunner *runner, const void *runnerContext,
+            UErrorCode &errorCode) {
+    return ucol_getSortKeysUTF8(coll, strings, lengths, count, dest, destCapacity, offsets,
+                                runner, runnerContext, &errorCode);
+}
+
+/**
+ * Sets order[i] to the index of the string that sorts into position i.
+ */
+template<typename CharType>
+void
+sortIndexes(const UCollator *coll,
+            const CharType *const *strings, const int32_t *lengths, int32_t count,
+            UCollationTaskRunner *runner, const void *runnerContext,
+            int32_t *order, UErrorCode &errorCode) {
+    if (count < MIN_SORT_KEY_SORT_COUNT) {
+        int32_t temp[MIN_SORT_KEY_SORT_COUNT];
+        for (int32_t i = 0; i < count; ++i) {
+            order[i] = i;
+        }
+        StringComparator<CharType> cmp(*Collator::fromUCollator(coll), strings, lengths, errorCode);
+        mergeSort(order, temp, count, cmp);
+        return;
+    }
+
+    // Write all sort keys into one buffer.
+    // Start with an estimate and retry once with the exact total length.
+    LocalMemory<int32_t> offsets;
+    if (offsets.allocateInsteadAndReset(count + 1) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    int64_t estimate = 0;
+    for (int32_t i = 0; i < count; ++i) {
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (length < 0) {
+            length = getLength(strings[i]);
+        }
+        estimate += 4 * (int64_t)length + 8;
+    }
+    int32_t capacity = estimate < INT32_MAX ? (int32_t)estimate : INT32_MAX;
+    LocalMemory<uint8_t> keys;
+    for (;;) {
+        if (keys.allocateInsteadAndReset(capacity) == NULL) {
+            errorCode = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        int32_t total = getSortKeys(coll, strings, lengths, count,
+                                    keys.getAlias(), capacity, offsets.getAlias(),
+                                    runner, runnerContext, errorCode);
+        if (errorCode != U_BUFFER_OVERFLOW_ERROR || total <= capacity) {
+            break;
+        }
+        errorCode = U_ZERO_ERROR;
+        capacity = total;
+    }
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+
+    LocalMemory<SortItem> items;
+    LocalMemory<SortItem> temp;
+    if (items.allocateInsteadAndReset(count) == NULL ||
+            temp.allocateInsteadAndReset(count) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < count; ++i) {
+        const uint8_t *key = keys.getAlias() + offsets[i];
+        uint32_t prefix = (uint32_t)key[0] << 24;
+        if (key[0] != 0) {
+            prefix |= (uint32_t)key[1] << 16;
+            if (key[1] != 0) {
+                prefix |= (uint32_t)key[2] << 8;
+                if (key[2] != 0) {
+                    prefix |= key[3];
+                }
+            }
+        }
+        items[i].prefix = prefix;
+        items[i].index = i;
+    }
+    sortItems(items.getAlias(), temp.getAlias(), count,
+              SortKeyComparator(keys.getAlias(), offsets.getAlias()),
+              runner, runnerContext);
+    for (int32_t i = 0; i < count; ++i) {
+        order[i] = items[i].index;
+    }
+}
+
+template<typename CharType>
+void
+sortStrings(const UCollator *coll,
+            const CharType **strings, int32_t *lengths, int32_t count,
+            UCollationTaskRunner *runner, const void *runnerContext,
+            UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+    if (coll == NULL || count < 0 || (strings == NULL && count > 0)) {
+        errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    // A NULL string is an empty string with length 0.
+    for (int32_t i = 0; i < count; ++i) {
+        if (strings[i] == NULL && (lengths == NULL || lengths[i] != 0)) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            return;
+        }
+    }
+    if (count <= 1) {
+        return;
+    }
+    LocalMemory<int32_t> order;
+    if (order.allocateInsteadAndReset(count) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    sortIndexes(coll, strings, lengths, count, runner, runnerContext,
+                order.getAlias(), errorCode);
+    if (U_FAILURE(errorCode)) {
+        return;
+    }
+
+    // Apply the permutation.
+    LocalMemory<const CharType *> oldStrings;
+    LocalMemory<int32_t> oldLengths;
+    if (oldStrings.allocateInsteadAndReset(count) == NULL ||
+            (lengths != NULL && oldLengths.allocateInsteadAndReset(count) == NULL)) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    uprv_memcpy(oldStrings.getAlias(), strings, count * sizeof(const CharType *));
+    for (int32_t i = 0; i < count; ++i) {
+        strings[i] = oldStrings[order[i]];
+    }
+    if (lengths != NULL) {
+        uprv_memcpy(oldLengths.getAlias(), lengths, count * sizeof(int32_t));
+        for (int32_t i = 0; i < count; ++i) {
+            lengths[i] = oldLengths[order[i]];
+        }
+    }
+}
+
+}  // namespace
+
+U_CAPI void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar **strings, int32_t *lengths, int32_t count,
+                 UCollationTaskRunner *runner, const void *runnerContext,
+                 UErrorCode *pErrorCode) {
+    sortStrings(coll, strings, lengths, count, runner, runnerContext, *pErrorCode);
+}
+
+U_CAPI void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char **strings, int32_t *lengths, int32_t count,
+                     UCollationTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode) {
+    sortStrings(coll, strings, lengths, count, runner, runnerContext, *pErrorCode);
+}
+
+#endif  // !UCONFIG_NO_COLLATION
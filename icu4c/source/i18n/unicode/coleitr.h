@@ -274,6 +274,38 @@ class U_I18N_API CollationElementIterator U_FINAL : public UObject {
     */
     void setOffset(int32_t newOffset, UErrorCode& status);
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+    * Fetches the following collation elements in bulk, as 64-bit CEs,
+    * continuing forward iteration from the current position.
+    *
+    * Each 64-bit CE has the primary weight in bits 63..32,
+    * the secondary weight in bits 31..16,
+    * and the case bits and tertiary weight in bits 15..0.
+    * next() returns each such CE as one or two 32-bit collation orders.
+    * Attributes like the strength do not modify the CEs.
+    *
+    * Fetching stops at the end of the text, when capacity CEs have been fetched,
+    * or before the CEs for text that starts at or after limitOffset.
+    * Subsequent calls continue where the previous one stopped.
+    * It is an error to call this function during backward iteration.
+    * If next() returned only the first half of a CE, then the rest of that CE is skipped.
+    *
+    * @param limitOffset stop before the CEs for text at or after this offset;
+    *                    -1 for the end of the text
+    * @param ces         receives the CEs
+    * @param offsets     if not NULL, receives for each CE the offset that
+    *                    getOffset() would return after next() returned that CE:
+    *                    the limit of the text that the CE was generated from
+    * @param capacity    number of CEs (and offsets) that fit into the arrays
+    * @param status      the error code status
+    * @return the number of CEs written; 0 if there are no more CEs before limitOffset
+    * @draft ICU 65
+    */
+    int32_t nextCEs(int32_t limitOffset, int64_t *ces, int32_t *offsets, int32_t capacity,
+                    UErrorCode& status);
+#endif  // U_HIDE_DRAFT_API
+
     /**
     * ICU "poor man's RTTI", returns a UClassID for the actual class.
     *
@@ -651,6 +651,82 @@ class U_I18N_API RuleBasedCollator : public Collator {
     virtual int32_t getSortKey(const char16_t *source, int32_t sourceLength,
                                uint8_t *result, int32_t resultLength) const;
 
+#ifndef U_HIDE_DRAFT_API
+    /**
+     * Writes the sort keys for an array of strings into one buffer,
+     * reusing the collation iterators and buffers for the whole batch.
+     * See ucol_getSortKeys() for details.
+     *
+     * @param strings array of count pointers to the strings
+     * @param lengths array of count string lengths (negative for NUL-terminated strings),
+     *        or NULL if all of the strings are NUL-terminated
+     * @param count number of strings
+     * @param dest buffer for the sort keys
+     * @param destCapacity number of bytes available at dest
+     * @param offsets array of count+1 integers which receives the start offset
+     *        of each key, and the total length of all keys at offsets[count]
+     * @param runner function that runs the tasks concurrently, or NULL for serial processing
+     * @param runnerContext opaque pointer passed into the runner
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return total length of all sort keys
+     * @draft ICU 65
+     */
+    int32_t getSortKeys(const char16_t *const *strings, const int32_t *lengths, int32_t count,
+                        uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                        UCollationTaskRunner *runner, const void *runnerContext,
+                        UErrorCode &errorCode) const;
+
+    /**
+     * Writes the sort keys for an array of UTF-8 strings into one buffer,
+     * reusing the collation iterators and buffers for the whole batch.
+     * See ucol_getSortKeysUTF8() for details.
+     *
+     * @param strings array of count pointers to the UTF-8 strings
+     * @param lengths array of count string lengths in bytes (negative for NUL-terminated strings),
+     *        or NULL if all of the strings are NUL-terminated
+     * @param count number of strings
+     * @param dest buffer for the sort keys
+     * @param destCapacity number of bytes available at dest
+     * @param offsets array of count+1 integers which receives the start offset
+     *        of each key, and the total length of all keys at offsets[count]
+     * @param runner function that runs the tasks concurrently, or NULL for serial processing
+     * @param runnerContext opaque pointer passed into the runner
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return total length of all sort keys
+     * @draft ICU 65
+     */
+    int32_t getSortKeysUTF8(const char *const *strings, const int32_t *lengths, int32_t count,
+                            uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                            UCollationTaskRunner *runner, const void *runnerContext,
+                            UErrorCode &errorCode) const;
+
+    /**
+     * Writes a short key with at most maxPrimaryLength bytes of the primary weights,
+     * for in-memory indexes. See ucol_getPrimaryPrefixKey() for details.
+     *
+     * @param s the string
+     * @param length its length, or -1 if it is NUL-terminated
+     * @param maxPrimaryLength maximum number of primary weight bytes in the key
+     * @param dest buffer for the key
+     * @param destCapacity number of bytes available at dest
+     * @param errorCode Standard ICU error code. Its input value must
+     *                  pass the U_SUCCESS() test, or else the function returns
+     *                  immediately. Check for U_FAILURE() on output or use with
+     *                  function chaining. (See User Guide for details.)
+     * @return the length of the key, including the terminating zero byte
+     * @draft ICU 65
+     */
+    int32_t getPrimaryPrefixKey(const char16_t *s, int32_t length, int32_t maxPrimaryLength,
+                                uint8_t *dest, int32_t destCapacity,
+                                UErrorCode &errorCode) const;
+#endif  // U_HIDE_DRAFT_API
+
     /**
      * Retrieves the reordering codes for this collator.
      * @param dest The array to fill with the script ordering.
@@ -836,6 +912,24 @@ class U_I18N_API RuleBasedCollator : public Collator {
     void writeIdenticalLevel(const char16_t *s, const char16_t *limit,
                              SortKeyByteSink &sink, UErrorCode &errorCode) const;
 
+    void writeSortKeys(const char16_t *const *strings, const int32_t *lengths,
+                       int32_t start, int32_t limit, int32_t *offsets,
+                       SortKeyByteSink &sink, UErrorCode &errorCode) const;
+
+    void writeSortKeysUTF8(const char *const *strings, const int32_t *lengths,
+                           int32_t start, int32_t limit, int32_t *offsets,
+                           SortKeyByteSink &sink, UErrorCode &errorCode) const;
+
+#ifndef U_HIDE_DRAFT_API
+    int32_t getSortKeysInBatches(const void *const *strings, UBool isUTF8,
+                                 const int32_t *lengths, int32_t count,
+                                 uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                                 UCollationTaskRunner *runner, const void *runnerContext,
+                                 UErrorCode &errorCode) const;
+
+    static void U_CALLCONV sortKeysTask(void *context, int32_t index);
+#endif  // U_HIDE_DRAFT_API
+
     const CollationSettings &getDefaultSettings() const;
 
     void setAttributeDefault(int32_t attribute) {
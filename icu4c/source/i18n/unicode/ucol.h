@@ -432,6 +432,35 @@ ucol_openRules( const UChar        *rules,
                 UParseError        *parseError,
                 UErrorCode         *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Sets the directory for precompiled snapshots of collators built from rules.
+ *
+ * Collators built from the same rule string (ucol_openRules(),
+ * RuleBasedCollator constructors) share one tailoring in a process-wide cache.
+ * When a snapshot directory is set, a tailoring that is not yet in the cache
+ * is memory-mapped from its snapshot file if there is one,
+ * rather than being built from the rules;
+ * after building a tailoring, its snapshot file is written.
+ * Snapshot files are specific to the ICU version and root collation data,
+ * and are ignored if they do not match.
+ * Failures to read or write snapshot files are otherwise ignored.
+ *
+ * The snapshot files are named rules*.col.
+ * The directory must exist and should be writable.
+ * Setting the directory does not affect tailorings that are already cached.
+ * Snapshots are not used if ICU is built with UCONFIG_NO_FILE_IO.
+ *
+ * @param path The directory path, or NULL or "" to stop using snapshots.
+ * @param pErrorCode ICU error code in/out parameter.
+ *                   Must fulfill U_SUCCESS before the function call.
+ * @see ucol_openRules
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucol_setRulesSnapshotDirectory(const char *path, UErrorCode *pErrorCode);
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_DEPRECATED_API
 /** 
  * Open a collator defined by a short form string.
@@ -1019,6 +1048,279 @@ ucol_getSortKey(const    UCollator    *coll,
         uint8_t        *result,
         int32_t        resultLength);
 
+#ifndef U_HIDE_DRAFT_API
+
+/**
+ * One task of a parallel collation operation, see UCollationTaskRunner.
+ *
+ * @param taskContext   The taskContext that was passed to the UCollationTaskRunner.
+ * @param index         The index of the task, 0..count-1.
+ * @draft ICU 65
+ */
+typedef void U_CALLCONV
+UCollationTask(void *taskContext, int32_t index);
+
+/**
+ * Function type for running tasks concurrently, for example on a thread pool.
+ * It is supplied by the caller of batch functions like ucol_getSortKeys().
+ *
+ * The function must call task(taskContext, i) exactly once for each i
+ * from 0 to count-1, in any order and on any threads,
+ * and it must return only after all of these calls have returned.
+ * A trivial implementation calls the task for each index in a loop.
+ *
+ * @param runnerContext The runnerContext that was passed into the ICU function.
+ * @param task          The task function.
+ * @param taskContext   Opaque pointer to be passed to each task call.
+ * @param count         The number of tasks.
+ * @draft ICU 65
+ */
+typedef void U_CALLCONV
+UCollationTaskRunner(const void *runnerContext,
+                     UCollationTask *task, void *taskContext,
+                     int32_t count);
+
+/**
+ * Writes the sort keys for an array of strings into one buffer.
+ * The result is the same as calling ucol_getSortKey() for each string
+ * and concatenating the keys, but the collation iterators and buffers
+ * are set up once for the whole batch rather than once per string.
+ *
+ * Each key ends with its terminating zero byte, as with ucol_getSortKey().
+ * Key i is at dest+offsets[i] and has length offsets[i+1]-offsets[i].
+ *
+ * With a runner, groups of strings are processed concurrently
+ * into temporary buffers which are then copied into dest.
+ * Small batches and a NULL runner are processed serially in the calling thread.
+ *
+ * @param coll          The UCollator containing the collation rules.
+ * @param strings       Array of count pointers to the UTF-16 strings.
+ * @param lengths       Array of count string lengths, where a negative length
+ *                      means that the string is NUL-terminated;
+ *                      or NULL if all of the strings are NUL-terminated.
+ * @param count         Number of strings.
+ * @param dest          Buffer for the sort keys.
+ * @param destCapacity  Number of bytes available at dest.
+ * @param offsets       Array of count+1 integers which receives the start offset
+ *                      of each key, and the total length of all keys at offsets[count].
+ *                      It is filled in even if destCapacity is too small.
+ * @param runner        Function that runs the tasks concurrently,
+ *                      or NULL for serial processing.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      Set to U_BUFFER_OVERFLOW_ERROR if destCapacity is too small,
+ *                      in which case the dest contents are undefined.
+ * @return Total length of all sort keys.
+ * @see ucol_getSortKey
+ * @see ucol_getSortKeysUTF8
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeys(const UCollator *coll,
+                 const UChar *const *strings, const int32_t *lengths, int32_t count,
+                 uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                 UCollationTaskRunner *runner, const void *runnerContext,
+                 UErrorCode *pErrorCode);
+
+/**
+ * Writes the sort keys for an array of UTF-8 strings into one buffer.
+ * Same as ucol_getSortKeys() but for UTF-8 input.
+ * The keys are the same as for the equivalent UTF-16 strings.
+ * Ill-formed UTF-8 is treated like U+FFFD, as in ucol_strcollUTF8().
+ *
+ * @param coll          The UCollator containing the collation rules.
+ * @param strings       Array of count pointers to the UTF-8 strings.
+ * @param lengths       Array of count string lengths in bytes, where a negative length
+ *                      means that the string is NUL-terminated;
+ *                      or NULL if all of the strings are NUL-terminated.
+ * @param count         Number of strings.
+ * @param dest          Buffer for the sort keys.
+ * @param destCapacity  Number of bytes available at dest.
+ * @param offsets       Array of count+1 integers which receives the start offset
+ *                      of each key, and the total length of all keys at offsets[count].
+ *                      It is filled in even if destCapacity is too small.
+ * @param runner        Function that runs the tasks concurrently,
+ *                      or NULL for serial processing.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      Set to U_BUFFER_OVERFLOW_ERROR if destCapacity is too small,
+ *                      in which case the dest contents are undefined.
+ * @return Total length of all sort keys.
+ * @see ucol_getSortKeys
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getSortKeysUTF8(const UCollator *coll,
+                     const char *const *strings, const int32_t *lengths, int32_t count,
+                     uint8_t *dest, int32_t destCapacity, int32_t *offsets,
+                     UCollationTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of strings according to the collator.
+ * The sort is stable: Strings that compare equal keep their relative order.
+ * The string pointers (and the lengths, if not NULL) are reordered in place;
+ * the string contents are not modified.
+ *
+ * Small arrays are sorted by comparing the strings with the collator.
+ * Larger arrays are sorted by their sort keys, which are written once
+ * into one shared buffer (see ucol_getSortKeys()) and then merge-sorted.
+ * With a runner, both the sort keys and the merge sort are computed
+ * in concurrent tasks.
+ *
+ * @param coll          The UCollator containing the collation rules.
+ * @param strings       Array of count pointers to the UTF-16 strings.
+ * @param lengths       Array of count string lengths, where a negative length
+ *                      means that the string is NUL-terminated;
+ *                      or NULL if all of the strings are NUL-terminated.
+ *                      A string pointer may be NULL only if its length is 0.
+ * @param count         Number of strings.
+ * @param runner        Function that runs the tasks concurrently,
+ *                      or NULL for serial processing.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      If an error occurs, the arrays are not modified.
+ * @see ucol_getSortKeys
+ * @see ucol_sortStringsUTF8
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStrings(const UCollator *coll,
+                 const UChar **strings, int32_t *lengths, int32_t count,
+                 UCollationTaskRunner *runner, const void *runnerContext,
+                 UErrorCode *pErrorCode);
+
+/**
+ * Sorts an array of UTF-8 strings according to the collator.
+ * Same as ucol_sortStrings() but for UTF-8 input.
+ * Ill-formed UTF-8 is treated like U+FFFD, as in ucol_strcollUTF8().
+ *
+ * @param coll          The UCollator containing the collation rules.
+ * @param strings       Array of count pointers to the UTF-8 strings.
+ * @param lengths       Array of count string lengths in bytes, where a negative length
+ *                      means that the string is NUL-terminated;
+ *                      or NULL if all of the strings are NUL-terminated.
+ *                      A string pointer may be NULL only if its length is 0.
+ * @param count         Number of strings.
+ * @param runner        Function that runs the tasks concurrently,
+ *                      or NULL for serial processing.
+ * @param runnerContext Opaque pointer passed into the runner.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      If an error occurs, the arrays are not modified.
+ * @see ucol_sortStrings
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucol_sortStringsUTF8(const UCollator *coll,
+                     const char **strings, int32_t *lengths, int32_t count,
+                     UCollationTaskRunner *runner, const void *runnerContext,
+                     UErrorCode *pErrorCode);
+
+/**
+ * Writes a short key for the string, for in-memory indexes like B-trees:
+ * The primary weights of the sort key, truncated to maxPrimaryLength bytes,
+ * followed by a flag byte and a terminating zero byte.
+ * The flag byte is 01 if all of the primary weights fit,
+ * or FF if they were truncated.
+ *
+ * Primary prefix keys compare with memcmp() or strcmp() consistently with the full sort keys:
+ * If the prefix key of a is less than the prefix key of b, then a sorts before b.
+ * If the prefix keys are equal, then the strings need to be compared with ucol_strcoll()
+ * or via their full sort keys (tie-break),
+ * except that when the flag byte is 01 the strings are equal at the primary level.
+ *
+ * @param coll             The UCollator containing the collation rules.
+ * @param source           The string.
+ * @param sourceLength     The length of source, or -1 if it is NUL-terminated.
+ * @param maxPrimaryLength The maximum number of primary weight bytes in the key.
+ * @param result           Buffer for the key.
+ * @param resultLength     Number of bytes available at result.
+ * @param pErrorCode       ICU error code in/out parameter.
+ *                         Must fulfill U_SUCCESS before the function call.
+ *                         Set to U_BUFFER_OVERFLOW_ERROR if resultLength is too small.
+ * @return The length of the key, including the terminating zero byte;
+ *         at most maxPrimaryLength+2.
+ * @see ucol_getSortKey
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_getPrimaryPrefixKey(const UCollator *coll,
+                         const UChar *source, int32_t sourceLength,
+                         int32_t maxPrimaryLength,
+                         uint8_t *result, int32_t resultLength,
+                         UErrorCode *pErrorCode);
+
+/**
+ * Front-codes an array of sort keys for compact storage:
+ * Each key is written as the length of the prefix that it shares
+ * with the previous key, followed by the rest of the key including its zero byte.
+ * The shared length takes one byte if it is less than 0x80, otherwise two bytes.
+ *
+ * The input is in the format written by ucol_getSortKeys().
+ * The keys are usually sorted so that adjacent keys share long prefixes,
+ * but any order works. Decode the keys in order with ucol_nextFrontCodedSortKey().
+ *
+ * @param keys          The sort keys, each with its terminating zero byte.
+ * @param offsets       Array of count+1 offsets: Key i is at keys+offsets[i]
+ *                      and ends before keys+offsets[i+1].
+ * @param count         Number of keys.
+ * @param dest          Buffer for the front-coded keys.
+ * @param destCapacity  Number of bytes available at dest.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      Set to U_BUFFER_OVERFLOW_ERROR if destCapacity is too small.
+ * @return The length of the front-coded keys.
+ * @see ucol_getSortKeys
+ * @see ucol_nextFrontCodedSortKey
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_frontCodeSortKeys(const uint8_t *keys, const int32_t *offsets, int32_t count,
+                       uint8_t *dest, int32_t destCapacity,
+                       UErrorCode *pErrorCode);
+
+/**
+ * Decodes the next sort key from the output of ucol_frontCodeSortKeys().
+ * The key buffer must contain the previous key that this function returned;
+ * the new key overwrites it after the prefix that they share.
+ *
+ * Typical use:
+ * <pre>
+ * int32_t index = 0, keyLength = 0;
+ * while ((keyLength = ucol_nextFrontCodedSortKey(src, srcLength, &index,
+ *                                                key, capacity, keyLength, &errorCode)) > 0) {
+ *     // use key[0..keyLength-1]
+ * }
+ * </pre>
+ *
+ * @param src           The front-coded keys.
+ * @param srcLength     The length of src.
+ * @param pIndex        In/out: the offset of the next key in src (0 for the first key).
+ *                      Advanced past the key if it was decoded.
+ * @param key           In/out: the previous key; receives the next key.
+ * @param keyCapacity   Number of bytes available at key.
+ * @param prevKeyLength The length of the previous key, or 0 for the first key.
+ * @param pErrorCode    ICU error code in/out parameter.
+ *                      Must fulfill U_SUCCESS before the function call.
+ *                      Set to U_BUFFER_OVERFLOW_ERROR if keyCapacity is too small,
+ *                      in which case *pIndex is not advanced;
+ *                      set to U_INVALID_FORMAT_ERROR if src is malformed.
+ * @return The length of the next key, including its zero byte,
+ *         or 0 if there are no more keys.
+ * @see ucol_frontCodeSortKeys
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_nextFrontCodedSortKey(const uint8_t *src, int32_t srcLength, int32_t *pIndex,
+                           uint8_t *key, int32_t keyCapacity, int32_t prevKeyLength,
+                           UErrorCode *pErrorCode);
+
+#endif  /* U_HIDE_DRAFT_API */
+
 
 /** Gets the next count bytes of a sort key. Caller needs
  *  to preserve state array between calls and to provide
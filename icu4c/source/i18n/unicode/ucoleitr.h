@@ -126,6 +126,21 @@ ucol_openElements(const UCollator  *coll,
 U_STABLE int32_t U_EXPORT2 
 ucol_keyHashCode(const uint8_t* key, int32_t length);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Computes the hash codes for an array of sort keys.
+ * hashCodes[i] is the same as ucol_keyHashCode(keys[i], lengths[i]).
+ * @param keys      the sort keys.
+ * @param lengths   the sizes of the key arrays.
+ * @param count     the number of keys.
+ * @param hashCodes receives the count hash codes.
+ * @draft ICU 65
+ */
+U_DRAFT void U_EXPORT2
+ucol_keyHashCodes(const uint8_t *const *keys, const int32_t *lengths, int32_t count,
+                  int32_t *hashCodes);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Close a UCollationElements.
  * Once closed, a UCollationElements may no longer be used.
@@ -175,6 +190,41 @@ ucol_next(UCollationElements *elems, UErrorCode *status);
 U_STABLE int32_t U_EXPORT2 
 ucol_previous(UCollationElements *elems, UErrorCode *status);
 
+#ifndef U_HIDE_DRAFT_API
+/**
+ * Fetches the following collation elements in bulk, as 64-bit CEs,
+ * continuing forward iteration from the current position.
+ *
+ * Each 64-bit CE has the primary weight in bits 63..32,
+ * the secondary weight in bits 31..16,
+ * and the case bits and tertiary weight in bits 15..0.
+ * ucol_next() returns each such CE as one or two 32-bit collation orders.
+ * Attributes like the strength do not modify the CEs.
+ *
+ * Fetching stops at the end of the text, when capacity CEs have been fetched,
+ * or before the CEs for text that starts at or after limitOffset.
+ * Subsequent calls continue where the previous one stopped.
+ * It is an error to call this function during backward iteration.
+ *
+ * @param elems The UCollationElements containing the text.
+ * @param limitOffset Stop before the CEs for text at or after this offset;
+ *                    -1 for the end of the text.
+ * @param ces Receives the CEs.
+ * @param offsets If not NULL, receives for each CE the offset that
+ *                ucol_getOffset() would return after ucol_next() returned that CE:
+ *                the limit of the text that the CE was generated from.
+ * @param capacity The number of CEs (and offsets) that fit into the arrays.
+ * @param status A pointer to a UErrorCode to receive any errors.
+ * @return The number of CEs written; 0 if there are no more CEs before limitOffset.
+ * @see ucol_next
+ * @draft ICU 65
+ */
+U_DRAFT int32_t U_EXPORT2
+ucol_nextCEs(UCollationElements *elems, int32_t limitOffset,
+             int64_t *ces, int32_t *offsets, int32_t capacity,
+             UErrorCode *status);
+#endif  /* U_HIDE_DRAFT_API */
+
 /**
  * Get the maximum length of any expansion sequences that end with the 
  * specified comparison order.
@@ -763,6 +763,132 @@ U_STABLE int32_t U_EXPORT2 usearch_previous(UStringSearch *strsrch,
 */
 U_STABLE void U_EXPORT2 usearch_reset(UStringSearch *strsrch);
 
+#ifndef U_HIDE_DRAFT_API
+/* multiple patterns --------------------------------------------------- */
+
+/**
+* Data structure for searching for several patterns at once.
+* @draft ICU 65
+*/
+struct UMultiStringSearch;
+/**
+* Data structure for searching for several patterns at once.
+* @draft ICU 65
+*/
+typedef struct UMultiStringSearch UMultiStringSearch;
+
+/**
+* Creates a search iterator data struct which finds all of the patterns
+* in a single pass over the text.
+* The patterns are matched on their processed collation elements, according
+* to the attributes of the collator, and each match is accepted or rejected
+* with the same rules as for a <tt>UStringSearch</tt> with default attributes
+* (see <tt>usearch_next</tt>):
+* A match must not start or end in the middle of a combining sequence or an
+* expansion, and its start and end must be boundaries of the break iterator,
+* if one is given.
+*
+* For each pattern, matches do not overlap, as with <tt>usearch_next</tt> and
+* <tt>USEARCH_OVERLAP</tt> off. Matches of different patterns may overlap.
+*
+* The user retains ownership of the collator, the patterns and the text,
+* which must remain valid until the search iterator is closed
+* or given new text.
+* @param patterns the patterns to search for
+* @param patternLengths lengths of the patterns, each -1 for null-termination;
+*                       can be NULL if all patterns are null-terminated
+* @param patternCount number of patterns
+* @param text text string
+* @param textlength length of the text string, -1 for null-termination
+* @param collator used for the language rules
+* @param breakiter A BreakIterator that will be used to restrict the points
+*                  at which matches are detected, as for
+*                  <tt>usearch_openFromCollator</tt>, or NULL.
+* @param status for errors if it occurs. If collator, patterns or text is NULL,
+*               if patternCount, any pattern length or textlength is 0,
+*               or if a pattern is completely ignorable with the collator's
+*               attributes, then an U_ILLEGAL_ARGUMENT_ERROR is returned.
+* @return search iterator data structure, or NULL if there is an error.
+* @draft ICU 65
+*/
+U_DRAFT UMultiStringSearch * U_EXPORT2 usearch_openMulti(
+                                         const UChar * const *patterns,
+                                         const int32_t        *patternLengths,
+                                               int32_t         patternCount,
+                                         const UChar          *text,
+                                               int32_t         textlength,
+                                         const UCollator      *collator,
+                                               UBreakIterator *breakiter,
+                                               UErrorCode     *status);
+
+/**
+* Destroying and cleaning up the multi-pattern search iterator data struct.
+* @param msearch data struct to clean up
+* @draft ICU 65
+*/
+U_DRAFT void U_EXPORT2 usearch_closeMulti(UMultiStringSearch *msearch);
+
+/**
+* Sets the text to be searched and resets the iteration.
+* The patterns and their collation elements are retained.
+* @param msearch multi-pattern search iterator data struct
+* @param text new string to look for matches
+* @param textlength length of the new string, -1 for null-termination
+* @param status for errors if it occurs. If text is NULL, or textlength is 0
+*               then an U_ILLEGAL_ARGUMENT_ERROR is returned.
+* @draft ICU 65
+*/
+U_DRAFT void U_EXPORT2 usearch_setMultiText(UMultiStringSearch *msearch,
+                                             const UChar        *text,
+                                                   int32_t       textlength,
+                                                   UErrorCode   *status);
+
+/**
+* Returns the next match of any of the patterns.
+* Matches are returned in the order in which their ends are reached in the
+* text's collation elements; matches which end at the same collation element
+* are returned longest pattern first.
+* @param msearch multi-pattern search iterator data struct
+* @param matchStart receives the start index of the match; can be NULL
+* @param matchLimit receives the limit index of the match; can be NULL
+* @param status for errors if it occurs
+* @return The index of the matching pattern in the array passed into
+*         <tt>usearch_openMulti</tt>, or <tt>USEARCH_DONE</tt> if there are
+*         no more matches.
+* @draft ICU 65
+*/
+U_DRAFT int32_t U_EXPORT2 usearch_nextMulti(UMultiStringSearch *msearch,
+                                             int32_t            *matchStart,
+                                             int32_t            *matchLimit,
+                                             UErrorCode         *status);
+
+/**
+* Resets the iteration to the start of the text.
+* @param msearch multi-pattern search iterator data struct
+* @draft ICU 65
+*/
+U_DRAFT void U_EXPORT2 usearch_resetMulti(UMultiStringSearch *msearch);
+
+#if U_SHOW_CPLUSPLUS_API
+
+U_NAMESPACE_BEGIN
+
+/**
+ * \class LocalUMultiStringSearchPointer
+ * "Smart pointer" class, closes a UMultiStringSearch via usearch_closeMulti().
+ * For most methods see the LocalPointerBase base class.
+ *
+ * @see LocalPointerBase
+ * @see LocalPointer
+ * @draft ICU 65
+ */
+U_DEFINE_LOCAL_OPEN_POINTER(LocalUMultiStringSearchPointer, UMultiStringSearch, usearch_closeMulti);
+
+U_NAMESPACE_END
+
+#endif
+#endif  /* U_HIDE_DRAFT_API */
+
 #ifndef U_HIDE_INTERNAL_API
 /**
   *  Simple forward search for the pattern, starting at a specified index,
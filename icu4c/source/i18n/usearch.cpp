@@ -20,9 +20,11 @@
 #include "normalizer2impl.h"
 #include "usrchimp.h"
 #include "cmemory.h"
+#include "uarrsort.h"
 #include "ucln_in.h"
 #include "uassert.h"
 #include "ustr_imp.h"
+#include "uvectr64.h"
 
 U_NAMESPACE_USE
 
@@ -1069,11 +1071,15 @@ inline UBool isOutOfBounds(int32_t textlength, int32_t offset)
 * @param strsrch string search data
 * @param start offset of possible match
 * @param end offset of possible match
+* @param pattern the pattern text
+* @param patternLength the pattern text length
 * @return TRUE if identical match is found
 */
 static
 inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
-                                  int32_t    end)
+                                  int32_t    end,
+                            const UChar     *pattern,
+                                  int32_t    patternLength)
 {
     if (strsrch->strength != UCOL_IDENTICAL) {
         return TRUE;
@@ -1086,11 +1092,22 @@ inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
     strsrch->nfd->normalize(
         UnicodeString(FALSE, strsrch->search->text + start, end - start), t2, status);
     strsrch->nfd->normalize(
-        UnicodeString(FALSE, strsrch->pattern.text, strsrch->pattern.textLength), p2, status);
+        UnicodeString(FALSE, pattern, patternLength), p2, status);
     // return FALSE if NFD failed
     return U_SUCCESS(status) && t2 == p2;
 }
 
+/**
+* Checks for identical match with the search pattern
+*/
+static
+inline UBool checkIdentical(const UStringSearch *strsrch, int32_t start,
+                                  int32_t    end)
+{
+    return checkIdentical(strsrch, start, end,
+                          strsrch->pattern.text, strsrch->pattern.textLength);
+}
+
 #if BOYER_MOORE
 /**
 * Checks to see if the match is repeated
@@ -3464,7 +3481,7 @@ namespace {
 #define   MAX_TARGET_IGNORABLES_PER_PAT_JAMO_L 8
 #define   MAX_TARGET_IGNORABLES_PER_PAT_OTHER 3
 #define   MIGHT_BE_JAMO_L(c) ((c >= 0x1100 && c <= 0x115E) || (c >= 0x3131 && c <= 0x314E) || (c >= 0x3165 && c <= 0x3186))
-struct CEIBuffer {
+struct CEIBuffer : public UMemory {
     CEI                  defBuf[DEFAULT_CEBUFFER_SIZE];
     CEI                 *buf;
     int32_t              bufSize;
@@ -3476,15 +3493,18 @@ struct CEIBuffer {
 
 
                CEIBuffer(UStringSearch *ss, UErrorCode *status);
+               CEIBuffer(UStringSearch *ss, int32_t size, UErrorCode *status);
                ~CEIBuffer();
+   void         reset(UErrorCode *status);
    const CEI   *get(int32_t index);
    const CEI   *getPrevious(int32_t index);
+
+private:
+   void         init(UStringSearch *ss, UErrorCode *status);
 };
 
 
 CEIBuffer::CEIBuffer(UStringSearch *ss, UErrorCode *status) {
-    buf = defBuf;
-    strSearch = ss;
     bufSize = ss->pattern.pcesLength + CEBUFFER_EXTRA;
     if (ss->search->elementComparisonType != 0) {
         const UChar * patText = ss->pattern.text;
@@ -3501,6 +3521,18 @@ CEIBuffer::CEIBuffer(UStringSearch *ss, UErrorCode *status) {
             }
         }
     }
+    init(ss, status);
+}
+
+// Buffer for a caller which looks back over at most size-1 CEs.
+CEIBuffer::CEIBuffer(UStringSearch *ss, int32_t size, UErrorCode *status) {
+    bufSize = size;
+    init(ss, status);
+}
+
+void CEIBuffer::init(UStringSearch *ss, UErrorCode *status) {
+    buf = defBuf;
+    strSearch = ss;
     ceIter    = ss->textIter;
     firstIx = 0;
     limitIx = 0;
@@ -3515,15 +3547,20 @@ CEIBuffer::CEIBuffer(UStringSearch *ss, UErrorCode *status) {
     }
 }
 
-// TODO: add a reset or init function so that allocated
-//       buffers can be retained & reused.
-
 CEIBuffer::~CEIBuffer() {
     if (buf != defBuf) {
         uprv_free(buf);
     }
 }
 
+// Empties the buffer, keeping its allocation, and restarts
+//   at the current position of the collation element iterator.
+void CEIBuffer::reset(UErrorCode *status) {
+    firstIx = 0;
+    limitIx = 0;
+    initTextProcessedIter(strSearch, status);
+}
+
 
 // Get the CE with the specified index.
 //   Index must be in the range
@@ -3829,6 +3866,176 @@ UChar32 codePointBefore(const USearch &search, int32_t index) {
 
 }  // namespace
 
+/*
+ * Checks a match in CE space of the pattern against the target CEs
+ * [targetIx, targetIx+targetIxOffset[, where patCE is the last pattern CE.
+ * Determines the bounds of the match in string index space, and returns FALSE
+ * if they do not correspond to an acceptable character range.
+ */
+static UBool checkMatchBounds(UStringSearch *strsrch, CEIBuffer &ceb,
+                              int32_t targetIx, int32_t targetIxOffset, int64_t patCE,
+                              const UChar *patText, int32_t patTextLength,
+                              int32_t *matchStart, int32_t *matchLimit) {
+    UBool      found    = TRUE;
+    const CEI *firstCEI = ceb.get(targetIx);
+    int32_t    mStart;
+    int32_t    mLimit;
+    int32_t    minLimit;
+    int32_t    maxLimit;
+
+    // We have found a match in CE space.
+    // Now determine the bounds in string index space.
+    //  There still is a chance of match failure if the CE range not correspond to
+    //     an acceptable character range.
+    //
+    const CEI *lastCEI  = ceb.get(targetIx + targetIxOffset - 1);
+
+    mStart   = firstCEI->lowIndex;
+    minLimit = lastCEI->lowIndex;
+
+    // Look at the CE following the match.  If it is UCOL_NULLORDER the match
+    //   extended to the end of input, and the match is good.
+
+    // Look at the high and low indices of the CE following the match. If
+    // they are the same it means one of two things:
+    //    1. The match extended to the last CE from the target text, which is OK, or
+    //    2. The last CE that was part of the match is in an expansion that extends
+    //       to the first CE after the match. In this case, we reject the match.
+    const CEI *nextCEI = 0;
+    if (strsrch->search->elementComparisonType == 0) {
+        nextCEI  = ceb.get(targetIx + targetIxOffset);
+        maxLimit = nextCEI->lowIndex;
+        if (nextCEI->lowIndex == nextCEI->highIndex && nextCEI->ce != UCOL_PROCESSED_NULLORDER) {
+            found = FALSE;
+        }
+    } else {
+        for ( ; ; ++targetIxOffset ) {
+            nextCEI = ceb.get(targetIx + targetIxOffset);
+            maxLimit = nextCEI->lowIndex;
+            // If we are at the end of the target too, match succeeds
+            if (  nextCEI->ce == UCOL_PROCESSED_NULLORDER ) {
+                break;
+            }
+            // As long as the next CE has primary weight of 0,
+            // it is part of the last target element matched by the pattern;
+            // make sure it can be part of a match with the last patCE
+            if ( (((nextCEI->ce) >> 32) & 0xFFFF0000UL) == 0 ) {
+                UCompareCEsResult ceMatch = compareCE64s(nextCEI->ce, patCE, strsrch->search->elementComparisonType);
+                if ( ceMatch == U_CE_NO_MATCH || ceMatch == U_CE_SKIP_PATN ) {
+                    found = FALSE;
+                    break;
+                }
+            // If lowIndex == highIndex, this target CE is part of an expansion of the last matched
+            // target element, but it has non-zero primary weight => match fails
+            } else if ( nextCEI->lowIndex == nextCEI->highIndex ) {
+                found = false;
+                break;
+            // Else the target CE is not part of an expansion of the last matched element, match succeeds
+            } else {
+                break;
+            }
+        }
+    }
+
+
+    // Check for the start of the match being within a combining sequence.
+    //   This can happen if the pattern itself begins with a combining char, and
+    //   the match found combining marks in the target text that were attached
+    //    to something else.
+    //   This type of match should be rejected for not completely consuming a
+    //   combining sequence.
+    if (!isBreakBoundary(strsrch, mStart)) {
+        found = FALSE;
+    }
+
+    // Check for the start of the match being within an Collation Element Expansion,
+    //   meaning that the first char of the match is only partially matched.
+    //   With expansions, the first CE will report the index of the source
+    //   character, and all subsequent (expansions) CEs will report the source index of the
+    //    _following_ character.
+    int32_t secondIx = firstCEI->highIndex;
+    if (mStart == secondIx) {
+        found = FALSE;
+    }
+
+    // Allow matches to end in the middle of a grapheme cluster if the following
+    // conditions are met; this is needed to make prefix search work properly in
+    // Indic, see #11750
+    // * the default breakIter is being used
+    // * the next collation element after this combining sequence
+    //   - has non-zero primary weight
+    //   - corresponds to a separate character following the one at end of the current match
+    //   (the second of these conditions, and perhaps both, may be redundant given the
+    //   subsequent check for normalization boundary; however they are likely much faster
+    //   tests in any case)
+    // * the match limit is a normalization boundary
+    UBool allowMidclusterMatch = FALSE;
+    if (strsrch->search->text != NULL && strsrch->search->textLength > maxLimit) {
+        allowMidclusterMatch =
+                strsrch->search->breakIter == NULL &&
+                nextCEI != NULL && (((nextCEI->ce) >> 32) & 0xFFFF0000UL) != 0 &&
+                maxLimit >= lastCEI->highIndex && nextCEI->highIndex > maxLimit &&
+                (strsrch->nfd->hasBoundaryBefore(codePointAt(*strsrch->search, maxLimit)) ||
+                    strsrch->nfd->hasBoundaryAfter(codePointBefore(*strsrch->search, maxLimit)));
+    }
+    // If those conditions are met, then:
+    // * do NOT advance the candidate match limit (mLimit) to a break boundary; however
+    //   the match limit may be backed off to a previous break boundary. This handles
+    //   cases in which mLimit includes target characters that are ignorable with current
+    //   settings (such as space) and which extend beyond the pattern match.
+    // * do NOT require that end of the combining sequence not extend beyond the match in CE space
+    // * do NOT require that match limit be on a breakIter boundary
+
+    //  Advance the match end position to the first acceptable match boundary.
+    //    This advances the index over any combining charcters.
+    mLimit = maxLimit;
+    if (minLimit < maxLimit) {
+        // When the last CE's low index is same with its high index, the CE is likely
+        // a part of expansion. In this case, the index is located just after the
+        // character corresponding to the CEs compared above. If the index is right
+        // at the break boundary, move the position to the next boundary will result
+        // incorrect match length when there are ignorable characters exist between
+        // the position and the next character produces CE(s). See ticket#8482.
+        if (minLimit == lastCEI->highIndex && isBreakBoundary(strsrch, minLimit)) {
+            mLimit = minLimit;
+        } else {
+            int32_t nba = nextBoundaryAfter(strsrch, minLimit);
+            // Note that we can have nba < maxLimit && nba >= minLImit, in which
+            // case we want to set mLimit to nba regardless of allowMidclusterMatch
+            // (i.e. we back off mLimit to the previous breakIterator boundary).
+            if (nba >= lastCEI->highIndex && (!allowMidclusterMatch || nba < maxLimit)) {
+                mLimit = nba;
+            }
+        }
+    }
+
+#ifdef USEARCH_DEBUG
+    if (getenv("USEARCH_DEBUG") != NULL) {
+        printf("minLimit, maxLimit, mLimit = %d, %d, %d\n", minLimit, maxLimit, mLimit);
+    }
+#endif
+
+    if (!allowMidclusterMatch) {
+        // If advancing to the end of a combining sequence in character indexing space
+        //   advanced us beyond the end of the match in CE space, reject this match.
+        if (mLimit > maxLimit) {
+            found = FALSE;
+        }
+
+        if (!isBreakBoundary(strsrch, mLimit)) {
+            found = FALSE;
+        }
+    }
+
+    if (! checkIdentical(strsrch, mStart, mLimit, patText, patTextLength)) {
+        found = FALSE;
+    }
+
+    *matchStart = mStart;
+    *matchLimit = mLimit;
+    return found;
+}
+
 U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
                                        int32_t        startIdx,
                                        int32_t        *matchStart,
@@ -3877,8 +4084,6 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
 
     int32_t  mStart = -1;
     int32_t  mLimit = -1;
-    int32_t  minLimit;
-    int32_t  maxLimit;
 
 
 
@@ -3949,151 +4154,9 @@ U_CAPI UBool U_EXPORT2 usearch_search(UStringSearch  *strsrch,
 
         // We have found a match in CE space.
         // Now determine the bounds in string index space.
-        //  There still is a chance of match failure if the CE range not correspond to
-        //     an acceptable character range.
-        //
-        const CEI *lastCEI  = ceb.get(targetIx + targetIxOffset - 1);
-
-        mStart   = firstCEI->lowIndex;
-        minLimit = lastCEI->lowIndex;
-
-        // Look at the CE following the match.  If it is UCOL_NULLORDER the match
-        //   extended to the end of input, and the match is good.
-
-        // Look at the high and low indices of the CE following the match. If
-        // they are the same it means one of two things:
-        //    1. The match extended to the last CE from the target text, which is OK, or
-        //    2. The last CE that was part of the match is in an expansion that extends
-        //       to the first CE after the match. In this case, we reject the match.
-        const CEI *nextCEI = 0;
-        if (strsrch->search->elementComparisonType == 0) {
-            nextCEI  = ceb.get(targetIx + targetIxOffset);
-            maxLimit = nextCEI->lowIndex;
-            if (nextCEI->lowIndex == nextCEI->highIndex && nextCEI->ce != UCOL_PROCESSED_NULLORDER) {
-                found = FALSE;
-            }
-        } else {
-            for ( ; ; ++targetIxOffset ) {
-                nextCEI = ceb.get(targetIx + targetIxOffset);
-                maxLimit = nextCEI->lowIndex;
-                // If we are at the end of the target too, match succeeds
-                if (  nextCEI->ce == UCOL_PROCESSED_NULLORDER ) {
-                    break;
-                }
-                // As long as the next CE has primary weight of 0,
-                // it is part of the last target element matched by the pattern;
-                // make sure it can be part of a match with the last patCE
-                if ( (((nextCEI->ce) >> 32) & 0xFFFF0000UL) == 0 ) {
-                    UCompareCEsResult ceMatch = compareCE64s(nextCEI->ce, patCE, strsrch->search->elementComparisonType);
-                    if ( ceMatch == U_CE_NO_MATCH || ceMatch == U_CE_SKIP_PATN ) {
-                        found = FALSE;
-                        break;
-                    }
-                // If lowIndex == highIndex, this target CE is part of an expansion of the last matched
-                // target element, but it has non-zero primary weight => match fails
-                } else if ( nextCEI->lowIndex == nextCEI->highIndex ) {
-                    found = false;
-                    break;
-                // Else the target CE is not part of an expansion of the last matched element, match succeeds
-                } else {
-                    break;
-                }
-            }
-        }
-
-
-        // Check for the start of the match being within a combining sequence.
-        //   This can happen if the pattern itself begins with a combining char, and
-        //   the match found combining marks in the target text that were attached
-        //    to something else.
-        //   This type of match should be rejected for not completely consuming a
-        //   combining sequence.
-        if (!isBreakBoundary(strsrch, mStart)) {
-            found = FALSE;
-        }
-
-        // Check for the start of the match being within an Collation Element Expansion,
-        //   meaning that the first char of the match is only partially matched.
-        //   With expansions, the first CE will report the index of the source
-        //   character, and all subsequent (expansions) CEs will report the source index of the
-        //    _following_ character.
-        int32_t secondIx = firstCEI->highIndex;
-        if (mStart == secondIx) {
-            found = FALSE;
-        }
-
-        // Allow matches to end in the middle of a grapheme cluster if the following
-        // conditions are met; this is needed to make prefix search work properly in
-        // Indic, see #11750
-        // * the default breakIter is being used
-        // * the next collation element after this combining sequence
-        //   - has non-zero primary weight
-        //   - corresponds to a separate character following the one at end of the current match
-        //   (the second of these conditions, and perhaps both, may be redundant given the
-        //   subsequent check for normalization boundary; however they are likely much faster
-        //   tests in any case)
-        // * the match limit is a normalization boundary
-        UBool allowMidclusterMatch = FALSE;
-        if (strsrch->search->text != NULL && strsrch->search->textLength > maxLimit) {
-            allowMidclusterMatch =
-                    strsrch->search->breakIter == NULL &&
-                    nextCEI != NULL && (((nextCEI->ce) >> 32) & 0xFFFF0000UL) != 0 &&
-                    maxLimit >= lastCEI->highIndex && nextCEI->highIndex > maxLimit &&
-                    (strsrch->nfd->hasBoundaryBefore(codePointAt(*strsrch->search, maxLimit)) ||
-                        strsrch->nfd->hasBoundaryAfter(codePointBefore(*strsrch->search, maxLimit)));
-        }
-        // If those conditions are met, then:
-        // * do NOT advance the candidate match limit (mLimit) to a break boundary; however
-        //   the match limit may be backed off to a previous break boundary. This handles
-        //   cases in which mLimit includes target characters that are ignorable with current
-        //   settings (such as space) and which extend beyond the pattern match.
-        // * do NOT require that end of the combining sequence not extend beyond the match in CE space
-        // * do NOT require that match limit be on a breakIter boundary
-
-        //  Advance the match end position to the first acceptable match boundary.
-        //    This advances the index over any combining charcters.
-        mLimit = maxLimit;
-        if (minLimit < maxLimit) {
-            // When the last CE's low index is same with its high index, the CE is likely
-            // a part of expansion. In this case, the index is located just after the
-            // character corresponding to the CEs compared above. If the index is right
-            // at the break boundary, move the position to the next boundary will result
-            // incorrect match length when there are ignorable characters exist between
-            // the position and the next character produces CE(s). See ticket#8482.
-            if (minLimit == lastCEI->highIndex && isBreakBoundary(strsrch, minLimit)) {
-                mLimit = minLimit;
-            } else {
-                int32_t nba = nextBoundaryAfter(strsrch, minLimit);
-                // Note that we can have nba < maxLimit && nba >= minLImit, in which
-                // case we want to set mLimit to nba regardless of allowMidclusterMatch
-                // (i.e. we back off mLimit to the previous breakIterator boundary).
-                if (nba >= lastCEI->highIndex && (!allowMidclusterMatch || nba < maxLimit)) {
-                    mLimit = nba;
-                }
-            }
-        }
-
-    #ifdef USEARCH_DEBUG
-        if (getenv("USEARCH_DEBUG") != NULL) {
-            printf("minLimit, maxLimit, mLimit = %d, %d, %d\n", minLimit, maxLimit, mLimit);
-        }
-    #endif
-
-        if (!allowMidclusterMatch) {
-            // If advancing to the end of a combining sequence in character indexing space
-            //   advanced us beyond the end of the match in CE space, reject this match.
-            if (mLimit > maxLimit) {
-                found = FALSE;
-            }
-
-            if (!isBreakBoundary(strsrch, mLimit)) {
-                found = FALSE;
-            }
-        }
-
-        if (! checkIdentical(strsrch, mStart, mLimit)) {
-            found = FALSE;
-        }
+        found = checkMatchBounds(strsrch, ceb, targetIx, targetIxOffset, patCE,
+                                 strsrch->pattern.text, strsrch->pattern.textLength,
+                                 &mStart, &mLimit);
 
         if (found) {
             break;
@@ -4941,4 +5004,434 @@ UBool usearch_handlePreviousCanonical(UStringSearch *strsrch,
 #endif
 }
 
+
+// multiple patterns ------------------------------------------------------
+
+/*
+ * Multi-pattern search:
+ * An Aho-Corasick automaton over the processed CEs of all of the patterns,
+ * run over the processed CEs of the text in a single pass.
+ * Each match in CE space is then checked with the same rules as in usearch_search().
+ *
+ * The trie nodes are numbered in breadth-first order, with node 0 as the root,
+ * so that the children of node i are the nodes [childStarts[i], childStarts[i+1]),
+ * sorted by the CE on the edge into each of them.
+ */
+struct UMultiStringSearch : public UMemory {
+    UMultiStringSearch(UErrorCode &errorCode)
+            : strsrch(NULL), patternCount(0), maxPCEsLength(0),
+              pces(errorCode), nodeCount(0) {}
+    ~UMultiStringSearch() {
+        usearch_close(strsrch);
+    }
+
+    void setPatterns(const UChar * const *patterns, const int32_t *lengths, int32_t count,
+                     UErrorCode &errorCode);
+    void buildAutomaton(UErrorCode &errorCode);
+    void reset(UErrorCode &errorCode);
+    int32_t next(int32_t *matchStart, int32_t *matchLimit);
+
+    int32_t findChild(int32_t node, int64_t ce) const {
+        int32_t start = childStarts[node];
+        int32_t limit = childStarts[node + 1];
+        while (start < limit) {
+            int32_t i = (start + limit) / 2;
+            uint64_t nodeCE = (uint64_t)nodeCEs[i];
+            if ((uint64_t)ce < nodeCE) {
+                limit = i;
+            } else if ((uint64_t)ce > nodeCE) {
+                start = i + 1;
+            } else {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    const int64_t *getPCEs(int32_t pattern) const {
+        return pces.getBuffer() + pceStarts[pattern];
+    }
+    int32_t getPCEsLength(int32_t pattern) const {
+        return pceStarts[pattern + 1] - pceStarts[pattern];
+    }
+
+    // Text & boundaries, the collator attributes and the text CE iterator.
+    UStringSearch *strsrch;
+    LocalPointer<CEIBuffer> ceb;
+
+    int32_t patternCount;
+    int32_t maxPCEsLength;
+    LocalMemory<const UChar *> patternTexts;
+    LocalMemory<int32_t> patternLengths;
+    // The processed CEs of pattern i are pces[pceStarts[i]..pceStarts[i+1]-1].
+    UVector64 pces;
+    LocalMemory<int32_t> pceStarts;
+    // Next pattern with the same CEs, or -1.
+    LocalMemory<int32_t> patternNext;
+
+    int32_t nodeCount;
+    LocalMemory<int64_t> nodeCEs;
+    LocalMemory<int32_t> childStarts;
+    LocalMemory<int32_t> fails;
+    // Nearest node on the failure chain that has patterns, or -1.
+    LocalMemory<int32_t> outputs;
+    // First pattern which ends at a node, or -1.
+    LocalMemory<int32_t> nodePatterns;
+
+    // Iteration state.
+    int32_t node;
+    int32_t ceIndex;  // index of the next text CE
+    int32_t outNode;  // node of the outPattern
+    int32_t outPattern;  // next candidate match ending at CE ceIndex-1, or -1
+    // Limit of the last match of each pattern, for non-overlapping matches.
+    LocalMemory<int32_t> matchLimits;
+    UBool done;
+};
+
+namespace {
+
+int32_t U_CALLCONV
+comparePatternPCEs(const void *context, const void *left, const void *right) {
+    const UMultiStringSearch *ms = static_cast<const UMultiStringSearch *>(context);
+    int32_t leftPattern = *static_cast<const int32_t *>(left);
+    int32_t rightPattern = *static_cast<const int32_t *>(right);
+    const int64_t *leftCEs = ms->getPCEs(leftPattern);
+    const int64_t *rightCEs = ms->getPCEs(rightPattern);
+    int32_t leftLength = ms->getPCEsLength(leftPattern);
+    int32_t rightLength = ms->getPCEsLength(rightPattern);
+    for (int32_t i = 0; i < leftLength && i < rightLength; ++i) {
+        if (leftCEs[i] != rightCEs[i]) {
+            return (uint64_t)leftCEs[i] < (uint64_t)rightCEs[i] ? -1 : 1;
+        }
+    }
+    return leftLength - rightLength;
+}
+
+}  // namespace
+
+void UMultiStringSearch::setPatterns(const UChar * const *patterns, const int32_t *lengths,
+                                     int32_t count, UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return; }
+    patternCount = count;
+    if (patternTexts.allocateInsteadAndReset(count) == NULL ||
+            patternLengths.allocateInsteadAndReset(count) == NULL ||
+            pceStarts.allocateInsteadAndReset(count + 1) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    UCollationElements *coleiter = ucol_openElements(strsrch->collator, patterns[0], 0,
+                                                     &errorCode);
+    for (int32_t i = 0; i < count && U_SUCCESS(errorCode); ++i) {
+        const UChar *pattern = patterns[i];
+        int32_t length = lengths != NULL ? lengths[i] : -1;
+        if (pattern == NULL || length < -1) {
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+            break;
+        }
+        if (length == -1) {
+            length = u_strlen(pattern);
+        }
+        patternTexts[i] = pattern;
+        patternLengths[i] = length;
+        pceStarts[i] = pces.size();
+        // Same processed CEs as in initializePatternPCETable().
+        ucol_setText(coleiter, pattern, length, &errorCode);
+        UCollationPCE iter(coleiter);
+        int64_t pce;
+        while ((pce = iter.nextProcessed(NULL, NULL, &errorCode)) != UCOL_PROCESSED_NULLORDER &&
+                U_SUCCESS(errorCode)) {
+            pces.addElement(pce, errorCode);
+        }
+        int32_t pcesLength = pces.size() - pceStarts[i];
+        if (pcesLength == 0) {
+            // Empty or completely ignorable pattern.
+            errorCode = U_ILLEGAL_ARGUMENT_ERROR;
+        } else if (pcesLength > maxPCEsLength) {
+            maxPCEsLength = pcesLength;
+        }
+    }
+    pceStarts[count] = pces.size();
+    ucol_closeElements(coleiter);
+}
+
+void UMultiStringSearch::buildAutomaton(UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return; }
+    // Sort the patterns by their CEs, so that the trie can be built
+    // in depth-first order with each node's children in sorted order.
+    LocalMemory<int32_t> order;
+    if (order.allocateInsteadAndReset(patternCount) == NULL ||
+            patternNext.allocateInsteadAndReset(patternCount) == NULL ||
+            matchLimits.allocateInsteadAndReset(patternCount) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    for (int32_t i = 0; i < patternCount; ++i) {
+        order[i] = i;
+    }
+    uprv_sortArray(order.getAlias(), patternCount, (int32_t)sizeof(int32_t),
+                   comparePatternPCEs, this, TRUE, &errorCode);
+    if (U_FAILURE(errorCode)) { return; }
+
+    // Temporary trie with first-child/next-sibling links.
+    int32_t capacity = 1 + pces.size();
+    LocalMemory<int64_t> tCEs;
+    LocalMemory<int32_t> tFirstChildren, tLastChildren, tNextSiblings, tPatterns, path;
+    if (tCEs.allocateInsteadAndReset(capacity) == NULL ||
+            tFirstChildren.allocateInsteadAndReset(capacity) == NULL ||
+            tLastChildren.allocateInsteadAndReset(capacity) == NULL ||
+            tNextSiblings.allocateInsteadAndReset(capacity) == NULL ||
+            tPatterns.allocateInsteadAndReset(capacity) == NULL ||
+            path.allocateInsteadAndReset(maxPCEsLength + 1) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    int32_t count = 1;
+    tFirstChildren[0] = tLastChildren[0] = tNextSiblings[0] = tPatterns[0] = -1;
+    path[0] = 0;
+    const int64_t *prevCEs = NULL;
+    int32_t prevLength = 0;
+    for (int32_t k = 0; k < patternCount; ++k) {
+        int32_t pattern = order[k];
+        const int64_t *ces = getPCEs(pattern);
+        int32_t length = getPCEsLength(pattern);
+        // The path nodes for the common prefix with the previous pattern are shared.
+        int32_t depth = 0;
+        while (depth < length && depth < prevLength && ces[depth] == prevCEs[depth]) {
+            ++depth;
+        }
+        for (; depth < length; ++depth) {
+            int32_t parent = path[depth];
+            int32_t n = count++;
+            tCEs[n] = ces[depth];
+            tFirstChildren[n] = tLastChildren[n] = tNextSiblings[n] = tPatterns[n] = -1;
+            if (tLastChildren[parent] < 0) {
+                tFirstChildren[parent] = n;
+            } else {
+                tNextSiblings[tLastChildren[parent]] = n;
+            }
+            tLastChildren[parent] = n;
+            path[depth + 1] = n;
+        }
+        int32_t n = path[length];
+        patternNext[pattern] = -1;
+        if (tPatterns[n] < 0) {
+            tPatterns[n] = pattern;
+        } else {
+            int32_t p = tPatterns[n];
+            while (patternNext[p] >= 0) { p = patternNext[p]; }
+            patternNext[p] = pattern;
+        }
+        prevCEs = ces;
+        prevLength = length;
+    }
+
+    // Renumber the nodes in breadth-first order.
+    nodeCount = count;
+    LocalMemory<int32_t> queue;
+    if (queue.allocateInsteadAndReset(nodeCount) == NULL ||
+            nodeCEs.allocateInsteadAndReset(nodeCount) == NULL ||
+            childStarts.allocateInsteadAndReset(nodeCount + 1) == NULL ||
+            fails.allocateInsteadAndReset(nodeCount) == NULL ||
+            outputs.allocateInsteadAndReset(nodeCount) == NULL ||
+            nodePatterns.allocateInsteadAndReset(nodeCount) == NULL) {
+        errorCode = U_MEMORY_ALLOCATION_ERROR;
+        return;
+    }
+    queue[0] = 0;
+    int32_t queueLimit = 1;
+    for (int32_t i = 0; i < nodeCount; ++i) {
+        int32_t t = queue[i];
+        nodeCEs[i] = tCEs[t];
+        nodePatterns[i] = tPatterns[t];
+        childStarts[i] = queueLimit;
+        for (int32_t c = tFirstChildren[t]; c >= 0; c = tNextSiblings[c]) {
+            queue[queueLimit++] = c;
+        }
+    }
+    childStarts[nodeCount] = queueLimit;
+
+    // Failure links: Each node's parent precedes it in breadth-first order.
+    fails[0] = 0;
+    outputs[0] = -1;
+    for (int32_t i = 0; i < nodeCount; ++i) {
+        for (int32_t child = childStarts[i]; child < childStarts[i + 1]; ++child) {
+            int32_t f = 0;
+            if (i != 0) {
+                f = fails[i];
+                for (;;) {
+                    int32_t w = findChild(f, nodeCEs[child]);
+                    if (w >= 0) {
+                        f = w;
+                        break;
+                    }
+                    if (f == 0) { break; }
+                    f = fails[f];
+                }
+            }
+            fails[child] = f;
+            outputs[child] = nodePatterns[f] >= 0 ? f : outputs[f];
+        }
+    }
+}
+
+void UMultiStringSearch::reset(UErrorCode &errorCode) {
+    if (U_FAILURE(errorCode)) { return; }
+    ucol_setOffset(strsrch->textIter, 0, &errorCode);
+    if (ceb.isNull()) {
+        ceb.adoptInsteadAndCheckErrorCode(
+            new CEIBuffer(strsrch, maxPCEsLength + CEBUFFER_EXTRA, &errorCode), errorCode);
+    } else {
+        ceb->reset(&errorCode);
+    }
+    node = 0;
+    ceIndex = 0;
+    outNode = -1;
+    outPattern = -1;
+    uprv_memset(matchLimits.getAlias(), 0, patternCount * sizeof(int32_t));
+    done = U_FAILURE(errorCode);
+}
+
+int32_t UMultiStringSearch::next(int32_t *matchStart, int32_t *matchLimit) {
+    for (;;) {
+        // Check the candidate matches which end with the last text CE.
+        while (outPattern >= 0) {
+            int32_t pattern = outPattern;
+            int32_t patternNode = outNode;
+            outPattern = patternNext[pattern];
+            if (outPattern < 0) {
+                outNode = outputs[outNode];
+                if (outNode >= 0) {
+                    outPattern = nodePatterns[outNode];
+                }
+            }
+            int32_t length = getPCEsLength(pattern);
+            int32_t targetIx = ceIndex - length;
+            if (ceb->get(targetIx)->lowIndex < matchLimits[pattern]) {
+                // Overlaps with the previous match of the same pattern.
+                continue;
+            }
+            if (checkMatchBounds(strsrch, *ceb, targetIx, length, nodeCEs[patternNode],
+                                 patternTexts[pattern], patternLengths[pattern],
+                                 matchStart, matchLimit)) {
+                matchLimits[pattern] = *matchLimit;
+                return pattern;
+            }
+        }
+        if (done) {
+            break;
+        }
+        int64_t ce = ceb->get(ceIndex)->ce;
+        if (ce == UCOL_PROCESSED_NULLORDER) {
+            done = TRUE;
+            break;
+        }
+        ++ceIndex;
+        for (;;) {
+            int32_t child = findChild(node, ce);
+            if (child >= 0) {
+                node = child;
+                break;
+            }
+            if (node == 0) { break; }
+            node = fails[node];
+        }
+        outNode = nodePatterns[node] >= 0 ? node : outputs[node];
+        if (outNode >= 0) {
+            outPattern = nodePatterns[outNode];
+        }
+    }
+    *matchStart = *matchLimit = USEARCH_DONE;
+    return USEARCH_DONE;
+}
+
+U_CAPI UMultiStringSearch * U_EXPORT2 usearch_openMulti(
+                                  const UChar * const *patterns,
+                                  const int32_t        *patternLengths,
+                                        int32_t         patternCount,
+                                  const UChar          *text,
+                                        int32_t         textlength,
+                                  const UCollator      *collator,
+                                        UBreakIterator *breakiter,
+                                        UErrorCode     *status)
+{
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    if (patterns == NULL || patternCount <= 0 || patterns[0] == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return NULL;
+    }
+    LocalPointer<UMultiStringSearch> result(new UMultiStringSearch(*status), *status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    // The single-pattern search object provides the text, the boundary checks and
+    // the text CE iterator; its own pattern is not used.
+    result->strsrch = usearch_openFromCollator(
+        patterns[0], patternLengths != NULL ? patternLengths[0] : -1,
+        text, textlength, collator, breakiter, status);
+    result->setPatterns(patterns, patternLengths, patternCount, *status);
+    result->buildAutomaton(*status);
+    result->reset(*status);
+    if (U_FAILURE(*status)) {
+        return NULL;
+    }
+    return result.orphan();
+}
+
+U_CAPI void U_EXPORT2 usearch_closeMulti(UMultiStringSearch *msearch)
+{
+    delete msearch;
+}
+
+U_CAPI void U_EXPORT2 usearch_setMultiText(UMultiStringSearch *msearch,
+                                           const UChar        *text,
+                                                 int32_t       textlength,
+                                                 UErrorCode   *status)
+{
+    if (U_FAILURE(*status)) {
+        return;
+    }
+    if (msearch == NULL) {
+        *status = U_ILLEGAL_ARGUMENT_ERROR;
+        return;
+    }
+    usearch_setText(msearch->strsrch, text, textlength, status);
+    msearch->reset(*status);
+}
+
+U_CAPI int32_t U_EXPORT2 usearch_nextMulti(UMultiStringSearch *msearch,
+                                           int32_t            *matchStart,
+                                           int32_t            *matchLimit,
+                                           UErrorCode         *status)
+{
+    int32_t start, limit;
+    int32_t pattern = USEARCH_DONE;
+    if (U_SUCCESS(*status)) {
+        if (msearch == NULL) {
+            *status = U_ILLEGAL_ARGUMENT_ERROR;
+        } else {
+            pattern = msearch->next(&start, &limit);
+        }
+    }
+    if (pattern == USEARCH_DONE) {
+        start = limit = USEARCH_DONE;
+    }
+    if (matchStart != NULL) {
+        *matchStart = start;
+    }
+    if (matchLimit != NULL) {
+        *matchLimit = limit;
+    }
+    return pattern;
+}
+
+U_CAPI void U_EXPORT2 usearch_resetMulti(UMultiStringSearch *msearch)
+{
+    if (msearch != NULL) {
+        UErrorCode status = U_ZERO_ERROR;
+        msearch->reset(status);
+    }
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -95,6 +95,17 @@ class U_I18N_API FCDUTF16CollationIterator : public UTF16CollationIterator {
 
     virtual ~FCDUTF16CollationIterator();
 
+    /**
+     * Starts iterating over new text, reusing the buffers of this iterator.
+     */
+    void setText(const UChar *s, const UChar *lim) {
+        UTF16CollationIterator::setText(s, lim);
+        rawStart = segmentStart = s;
+        segmentLimit = NULL;
+        rawLimit = lim;
+        checkDir = 1;
+    }
+
     virtual UBool operator==(const CollationIterator &other) const;
 
     virtual void resetToOffset(int32_t newOffset);
@@ -225,6 +225,19 @@ FCDUTF8CollationIterator::nextHasLccc() const {
     // CJK U+4000..U+DFFF except U+Axxx are also FCD-inert. (Lead bytes E4..ED except EA.)
     UChar32 c = u8[pos];
     if(c < 0xcc || (0xe4 <= c && c <= 0xed && c != 0xea)) { return FALSE; }
+    // Decode the common two- and three-byte sequences inline.
+    uint8_t t1, t2;
+    if(c < 0xe0) {
+        // Lead byte CC..DF.
+        if(((pos + 1) != length) && (t1 = (u8[pos + 1] - 0x80)) <= 0x3f) {
+            return CollationFCD::hasLccc(((c & 0x1f) << 6) | t1);
+        }
+    } else if(c < 0xf0 &&
+            ((pos + 2) < length || length < 0) &&
+            U8_IS_VALID_LEAD3_AND_T1(c, t1 = u8[pos + 1]) &&
+            (t2 = (u8[pos + 2] - 0x80)) <= 0x3f) {
+        return CollationFCD::hasLccc(((c & 0xf) << 12) | ((t1 & 0x3f) << 6) | t2);
+    }
     int32_t i = pos;
     U8_NEXT_OR_FFFD(u8, i, length, c);
     if(c > 0xffff) { c = U16_LEAD(c); }
@@ -387,8 +400,6 @@ FCDUTF8CollationIterator::nextSegment(UErrorCode &errorCode) {
     U_ASSERT(state == CHECK_FWD && pos != length);
     // The input text [start..pos[ passes the FCD check.
     int32_t segmentStart = pos;
-    // Collect the characters being checked, in case they need to be normalized.
-    UnicodeString s;
     uint8_t prevCC = 0;
     for(;;) {
         // Fetch the next character and its fcd16 value.
@@ -402,7 +413,6 @@ FCDUTF8CollationIterator::nextSegment(UErrorCode &errorCode) {
             pos = cpStart;
             break;
         }
-        s.append(c);
         if(leadCC != 0 && (prevCC > leadCC || CollationFCD::isFCD16OfTibetanCompositeVowel(fcd16))) {
             // Fails FCD check. Find the next FCD boundary and normalize.
             while(pos != length) {
@@ -412,9 +422,8 @@ FCDUTF8CollationIterator::nextSegment(UErrorCode &errorCode) {
                     pos = cpStart;
                     break;
                 }
-                s.append(c);
             }
-            if(!normalize(s, errorCode)) { return FALSE; }
+            if(!normalize(segmentStart, pos, errorCode)) { return FALSE; }
             start = segmentStart;
             limit = pos;
             state = IN_NORMALIZED;
@@ -466,8 +475,6 @@ FCDUTF8CollationIterator::previousSegment(UErrorCode &errorCode) {
     U_ASSERT(state == CHECK_BWD && pos != 0);
     // The input text [pos..limit[ passes the FCD check.
     int32_t segmentLimit = pos;
-    // Collect the characters being checked, in case they need to be normalized.
-    UnicodeString s;
     uint8_t nextCC = 0;
     for(;;) {
         // Fetch the previous character and its fcd16 value.
@@ -481,7 +488,6 @@ FCDUTF8CollationIterator::previousSegment(UErrorCode &errorCode) {
             pos = cpLimit;
             break;
         }
-        s.append(c);
         if(trailCC != 0 && ((nextCC != 0 && trailCC > nextCC) ||
                             CollationFCD::isFCD16OfTibetanCompositeVowel(fcd16))) {
             // Fails FCD check. Find the previous FCD boundary and normalize.
@@ -493,10 +499,8 @@ FCDUTF8CollationIterator::previousSegment(UErrorCode &errorCode) {
                     pos = cpLimit;
                     break;
                 }
-                s.append(c);
             }
-            s.reverse();
-            if(!normalize(s, errorCode)) { return FALSE; }
+            if(!normalize(pos, segmentLimit, errorCode)) { return FALSE; }
             limit = segmentLimit;
             start = pos;
             state = IN_NORMALIZED;
@@ -517,10 +521,14 @@ FCDUTF8CollationIterator::previousSegment(UErrorCode &errorCode) {
 }
 
 UBool
-FCDUTF8CollationIterator::normalize(const UnicodeString &s, UErrorCode &errorCode) {
+FCDUTF8CollationIterator::normalize(int32_t segmentStart, int32_t segmentLimit,
+                                    UErrorCode &errorCode) {
     // NFD without argument checking.
+    // A segment that fails the FCD check contains only characters with FCD data,
+    // and no ill-formed sequences (which would yield the FCD-inert U+FFFD).
+    // Decompose straight from the UTF-8 text, reusing the normalized buffer.
     U_ASSERT(U_SUCCESS(errorCode));
-    nfcImpl.decompose(s, normalized, errorCode);
+    nfcImpl.decompose(u8 + segmentStart, u8 + segmentLimit, normalized, errorCode);
     return U_SUCCESS(errorCode);
 }
 
@@ -40,6 +40,16 @@ class U_I18N_API UTF8CollationIterator : public CollationIterator {
 
     virtual ~UTF8CollationIterator();
 
+    /**
+     * Starts iterating over new text, reusing the buffers of this iterator.
+     */
+    void setText(const uint8_t *s, int32_t len) {
+        reset();
+        u8 = s;
+        pos = 0;
+        length = len;
+    }
+
     virtual void resetToOffset(int32_t newOffset);
 
     virtual int32_t getOffset() const;
@@ -87,6 +97,15 @@ class U_I18N_API FCDUTF8CollationIterator : public UTF8CollationIterator {
 
     virtual ~FCDUTF8CollationIterator();
 
+    /**
+     * Starts iterating over new text, reusing the buffers of this iterator.
+     */
+    void setText(const uint8_t *s, int32_t len) {
+        UTF8CollationIterator::setText(s, len);
+        state = CHECK_FWD;
+        start = 0;
+    }
+
     virtual void resetToOffset(int32_t newOffset);
 
     virtual int32_t getOffset() const;
@@ -132,7 +151,11 @@ class U_I18N_API FCDUTF8CollationIterator : public UTF8CollationIterator {
      */
     UBool previousSegment(UErrorCode &errorCode);
 
-    UBool normalize(const UnicodeString &s, UErrorCode &errorCode);
+    /**
+     * Normalizes the well-formed text segment [segmentStart..segmentLimit[ to NFD
+     * into the normalized buffer, without any other allocation.
+     */
+    UBool normalize(int32_t segmentStart, int32_t segmentLimit, UErrorCode &errorCode);
 
     enum State {
         /**
@@ -90,6 +90,10 @@ void addCollAPITest(TestNode** root)
     addTest(root, &TestBengaliSortKey, "tscoll/capitst/TestBengaliSortKey");
     addTest(root, &TestGetKeywordValuesForLocale, "tscoll/capitst/TestGetKeywordValuesForLocale");
     addTest(root, &TestStrcollNull, "tscoll/capitst/TestStrcollNull");
+    addTest(root, &TestGetSortKeys, "tscoll/capitst/TestGetSortKeys");
+    addTest(root, &TestSortStrings, "tscoll/capitst/TestSortStrings");
+    addTest(root, &TestPrimaryPrefixKeys, "tscoll/capitst/TestPrimaryPrefixKeys");
+    addTest(root, &TestFrontCodedSortKeys, "tscoll/capitst/TestFrontCodedSortKeys");
 }
 
 void TestGetSetAttr(void) {
@@ -1251,6 +1255,25 @@ void TestHashCode()
     doAssert( !(ucol_keyHashCode(sortk1, sortk1len) == ucol_keyHashCode(sortk2, sortk2len)), "Hash test2 result incorrect" );
     doAssert( ucol_keyHashCode(sortk2, sortk2len) == ucol_keyHashCode(sortk3, sortk3len), "Hash result not equal" );
 
+    log_verbose("ucol_keyHashCodes() testing ...\n");
+    {
+        const uint8_t *keys[4];
+        int32_t lengths[4];
+        int32_t hashCodes[4];
+        keys[0] = sortk1; lengths[0] = sortk1len;
+        keys[1] = sortk2; lengths[1] = sortk2len;
+        keys[2] = sortk3; lengths[2] = sortk3len;
+        keys[3] = sortk1; lengths[3] = 0;
+        ucol_keyHashCodes(keys, lengths, 4, hashCodes);
+        doAssert( hashCodes[0] == ucol_keyHashCode(sortk1, sortk1len), "Batch hash 0 not equal" );
+        doAssert( hashCodes[1] == ucol_keyHashCode(sortk2, sortk2len), "Batch hash 1 not equal" );
+        doAssert( hashCodes[2] == hashCodes[1], "Batch hash 2 not equal" );
+        doAssert( hashCodes[3] == ucol_keyHashCode(sortk1, 0), "Batch hash of empty key not equal" );
+        /* All bytes contribute to the hash code. */
+        doAssert( ucol_keyHashCode(sortk1, sortk1len - 1) != ucol_keyHashCode(sortk1, sortk1len),
+                  "Hash of a key prefix should differ" );
+    }
+
     log_verbose("hashCode tests end.\n");
     ucol_close(col);
     free(sortk1);
@@ -2565,4 +2588,495 @@ static void TestStrcollNull(void) {
     ucol_close(coll);
 }
 
+static void U_CALLCONV
+runTasksBackward(const void *runnerContext, UCollationTask *task, void *taskContext, int32_t count) {
+    int32_t i;
+    (void)runnerContext;
+    for (i = count - 1; i >= 0; --i) {
+        task(taskContext, i);
+    }
+}
+
+static void checkSortKeys(const char *name,
+                          const uint8_t *expected, const int32_t *expectedOffsets,
+                          const uint8_t *actual, const int32_t *actualOffsets,
+                          int32_t count, int32_t expectedTotal, int32_t actualTotal,
+                          UErrorCode errorCode) {
+    if (U_FAILURE(errorCode)) {
+        log_err("%s failed: %s\n", name, u_errorName(errorCode));
+    } else if (actualTotal != expectedTotal ||
+            uprv_memcmp(expectedOffsets, actualOffsets, (count + 1) * 4) != 0 ||
+            uprv_memcmp(expected, actual, expectedTotal) != 0) {
+        log_err("%s: sort keys differ from ucol_getSortKey()\n", name);
+    }
+}
+
+static void TestGetSortKeys(void) {
+    static const char *const words[] = {
+        "cote", "c\\u00F4te", "cot\\u00E9", "c\\u00F4t\\u00E9", "Hello", "\\uFB03",
+        "a\\u0323\\u0302", "\\u1100\\u1161\\u11A8", "\\U0001D15E", "Abc", "abc", "ABC",
+        "\\u4E00\\u4E8C", "\\u0428\\u0430\\u0440", "-", ""
+    };
+    enum { COUNT = 2600, MAX_LENGTH = 20 };
+    static const UColAttributeValue strengths[] = { UCOL_TERTIARY, UCOL_IDENTICAL };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("fr_CA", &errorCode);
+    UChar *s16 = (UChar *)malloc(COUNT * MAX_LENGTH * U_SIZEOF_UCHAR);
+    char *s8 = (char *)malloc(COUNT * MAX_LENGTH * 3);
+    const UChar **strings16 = (const UChar **)malloc(COUNT * sizeof(UChar *));
+    const char **strings8 = (const char **)malloc(COUNT * sizeof(char *));
+    int32_t *lengths16 = (int32_t *)malloc(COUNT * 4);
+    int32_t *lengths8 = (int32_t *)malloc(COUNT * 4);
+    int32_t *expectedOffsets = (int32_t *)malloc((COUNT + 1) * 4);
+    int32_t *offsets = (int32_t *)malloc((COUNT + 1) * 4);
+    int32_t i, s, capacity = COUNT * 100;
+    uint8_t *expected = (uint8_t *)malloc(capacity);
+    uint8_t *keys = (uint8_t *)malloc(capacity);
+    if (U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "ucol_open(fr_CA) failed - %s\n", u_errorName(errorCode));
+        goto cleanup;
+    }
+    if (s16 == NULL || s8 == NULL || strings16 == NULL || strings8 == NULL ||
+            lengths16 == NULL || lengths8 == NULL || expectedOffsets == NULL ||
+            offsets == NULL || expected == NULL || keys == NULL) {
+        log_err("out of memory\n");
+        goto cleanup;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        char suffix[16];
+        UChar *p16 = s16 + i * MAX_LENGTH;
+        char *p8 = s8 + i * MAX_LENGTH * 3;
+        int32_t length = u_unescape(words[i % UPRV_LENGTHOF(words)], p16, MAX_LENGTH);
+        sprintf(suffix, "%d", (int)(i / UPRV_LENGTHOF(words)));
+        u_uastrcpy(p16 + length, suffix);
+        lengths16[i] = u_strlen(p16);
+        strings16[i] = p16;
+        u_strToUTF8(p8, MAX_LENGTH * 3, &lengths8[i], p16, lengths16[i], &errorCode);
+        strings8[i] = p8;
+    }
+    if (U_FAILURE(errorCode)) {
+        log_err("unable to set up the test strings - %s\n", u_errorName(errorCode));
+        goto cleanup;
+    }
+
+    for (s = 0; s < UPRV_LENGTHOF(strengths); ++s) {
+        int32_t expectedTotal = 0, total;
+        ucol_setStrength(coll, strengths[s]);
+        for (i = 0; i < COUNT; ++i) {
+            expectedOffsets[i] = expectedTotal;
+            expectedTotal += ucol_getSortKey(coll, strings16[i], lengths16[i],
+                                             expected + expectedTotal, capacity - expectedTotal);
+        }
+        expectedOffsets[COUNT] = expectedTotal;
+        if (expectedTotal > capacity) {
+            log_err("test buffer too small\n");
+            break;
+        }
+
+        total = ucol_getSortKeys(coll, strings16, lengths16, COUNT, keys, capacity, offsets,
+                                 NULL, NULL, &errorCode);
+        checkSortKeys("ucol_getSortKeys(serial)", expected, expectedOffsets, keys, offsets,
+                      COUNT, expectedTotal, total, errorCode);
+        errorCode = U_ZERO_ERROR;
+        uprv_memset(keys, 0x55, capacity);
+        total = ucol_getSortKeys(coll, strings16, NULL, COUNT, keys, capacity, offsets,
+                                 runTasksBackward, NULL, &errorCode);
+        checkSortKeys("ucol_getSortKeys(runner, NUL-terminated)", expected, expectedOffsets,
+                      keys, offsets, COUNT, expectedTotal, total, errorCode);
+        errorCode = U_ZERO_ERROR;
+        uprv_memset(keys, 0x55, capacity);
+        total = ucol_getSortKeysUTF8(coll, strings8, lengths8, COUNT, keys, capacity, offsets,
+                                     NULL, NULL, &errorCode);
+        checkSortKeys("ucol_getSortKeysUTF8(serial)", expected, expectedOffsets, keys, offsets,
+                      COUNT, expectedTotal, total, errorCode);
+        errorCode = U_ZERO_ERROR;
+        uprv_memset(keys, 0x55, capacity);
+        total = ucol_getSortKeysUTF8(coll, strings8, lengths8, COUNT, keys, capacity, offsets,
+                                     runTasksBackward, NULL, &errorCode);
+        checkSortKeys("ucol_getSortKeysUTF8(runner)", expected, expectedOffsets, keys, offsets,
+                      COUNT, expectedTotal, total, errorCode);
+        errorCode = U_ZERO_ERROR;
+
+        /* preflighting, serial and with a runner */
+        total = ucol_getSortKeys(coll, strings16, lengths16, COUNT, NULL, 0, offsets,
+                                 NULL, NULL, &errorCode);
+        if (errorCode != U_BUFFER_OVERFLOW_ERROR || total != expectedTotal ||
+                offsets[COUNT] != expectedTotal || offsets[COUNT / 2] != expectedOffsets[COUNT / 2]) {
+            log_err("ucol_getSortKeys(preflighting) = %d %s, expected %d U_BUFFER_OVERFLOW_ERROR\n",
+                    (int)total, u_errorName(errorCode), (int)expectedTotal);
+        }
+        errorCode = U_ZERO_ERROR;
+        total = ucol_getSortKeysUTF8(coll, strings8, lengths8, COUNT, keys, expectedTotal - 1, offsets,
+                                     runTasksBackward, NULL, &errorCode);
+        if (errorCode != U_BUFFER_OVERFLOW_ERROR || total != expectedTotal ||
+                offsets[COUNT] != expectedTotal || offsets[COUNT / 2] != expectedOffsets[COUNT / 2]) {
+            log_err("ucol_getSortKeysUTF8(runner, too small) = %d %s, expected %d U_BUFFER_OVERFLOW_ERROR\n",
+                    (int)total, u_errorName(errorCode), (int)expectedTotal);
+        }
+        errorCode = U_ZERO_ERROR;
+    }
+
+    ucol_getSortKeys(coll, strings16, lengths16, -1, keys, capacity, offsets,
+                     NULL, NULL, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_getSortKeys(count=-1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+
+cleanup:
+    ucol_close(coll);
+    free(s16);
+    free(s8);
+    free((void *)strings16);
+    free((void *)strings8);
+    free(lengths16);
+    free(lengths8);
+    free(expectedOffsets);
+    free(offsets);
+    free(expected);
+    free(keys);
+}
+
+/*
+ * Checks that strings[0..count[ is a stable sort of the strings at base + i * stride:
+ * Equal strings must still be in ascending address order.
+ */
+static void checkSorted16(const char *name, const UCollator *coll,
+                          const UChar *base, int32_t stride,
+                          const UChar **strings, const int32_t *lengths, int32_t count,
+                          UBool *seen, UErrorCode errorCode) {
+    int32_t i;
+    if (U_FAILURE(errorCode)) {
+        log_err("%s failed: %s\n", name, u_errorName(errorCode));
+        return;
+    }
+    uprv_memset(seen, 0, count);
+    for (i = 0; i < count; ++i) {
+        int32_t index = (int32_t)(strings[i] - base) / stride;
+        if (seen[index] || (lengths != NULL && lengths[i] != u_strlen(strings[i]))) {
+            log_err("%s: result is not a permutation of the input at [%d]\n", name, (int)i);
+            return;
+        }
+        seen[index] = TRUE;
+        if (i > 0) {
+            UCollationResult result = ucol_strcoll(coll, strings[i - 1], -1, strings[i], -1);
+            if (result > 0 || (result == 0 && strings[i - 1] > strings[i])) {
+                log_err("%s: strings [%d] and [%d] are out of order\n", name, (int)i - 1, (int)i);
+                return;
+            }
+        }
+    }
+}
+
+static void checkSorted8(const char *name, const UCollator *coll,
+                         const char *base, int32_t stride,
+                         const char **strings, const int32_t *lengths, int32_t count,
+                         UBool *seen, UErrorCode errorCode) {
+    int32_t i;
+    if (U_FAILURE(errorCode)) {
+        log_err("%s failed: %s\n", name, u_errorName(errorCode));
+        return;
+    }
+    uprv_memset(seen, 0, count);
+    for (i = 0; i < count; ++i) {
+        int32_t index = (int32_t)(strings[i] - base) / stride;
+        if (seen[index] || (lengths != NULL && lengths[i] != (int32_t)uprv_strlen(strings[i]))) {
+            log_err("%s: result is not a permutation of the input at [%d]\n", name, (int)i);
+            return;
+        }
+        seen[index] = TRUE;
+        if (i > 0) {
+            UCollationResult result =
+                ucol_strcollUTF8(coll, strings[i - 1], -1, strings[i], -1, &errorCode);
+            if (result > 0 || (result == 0 && strings[i - 1] > strings[i])) {
+                log_err("%s: strings [%d] and [%d] are out of order\n", name, (int)i - 1, (int)i);
+                return;
+            }
+        }
+    }
+}
+
+static void TestSortStrings(void) {
+    static const char *const words[] = {
+        "cote", "c\\u00F4te", "cot\\u00E9", "c\\u00F4t\\u00E9", "Hello", "\\uFB03",
+        "a\\u0323\\u0302", "\\u1100\\u1161\\u11A8", "\\U0001D15E", "Abc", "abc", "ABC",
+        "\\u4E00\\u4E8C", "\\u0428\\u0430\\u0440", "-", ""
+    };
+    /* Enough strings for the concurrent merge passes, with many duplicates. */
+    enum { COUNT = 9000, MAX_LENGTH = 20 };
+    /* Exercise the string comparison sort, the serial and the concurrent sort key sort. */
+    static const int32_t counts[] = { 0, 1, 2, 40, 1000, COUNT };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("fr_CA", &errorCode);
+    UChar *s16 = (UChar *)malloc(COUNT * MAX_LENGTH * U_SIZEOF_UCHAR);
+    char *s8 = (char *)malloc(COUNT * MAX_LENGTH * 3);
+    const UChar **strings16 = (const UChar **)malloc(COUNT * sizeof(UChar *));
+    const char **strings8 = (const char **)malloc(COUNT * sizeof(char *));
+    int32_t *lengths16 = (int32_t *)malloc(COUNT * 4);
+    int32_t *lengths8 = (int32_t *)malloc(COUNT * 4);
+    UBool *seen = (UBool *)malloc(COUNT);
+    int32_t i, c;
+    if (U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "ucol_open(fr_CA) failed - %s\n", u_errorName(errorCode));
+        goto cleanup;
+    }
+    if (s16 == NULL || s8 == NULL || strings16 == NULL || strings8 == NULL ||
+            lengths16 == NULL || lengths8 == NULL || seen == NULL) {
+        log_err("out of memory\n");
+        goto cleanup;
+    }
+    ucol_setStrength(coll, UCOL_SECONDARY);
+
+    for (c = 0; c < UPRV_LENGTHOF(counts); ++c) {
+        int32_t count = counts[c];
+        char name[64];
+        /* Set up the strings in a scrambled order. */
+        for (i = 0; i < count; ++i) {
+            char suffix[16];
+            UChar *p16 = s16 + i * MAX_LENGTH;
+            char *p8 = s8 + i * MAX_LENGTH * 3;
+            int32_t length = u_unescape(words[(i * 7) % UPRV_LENGTHOF(words)], p16, MAX_LENGTH);
+            sprintf(suffix, "%d", (int)((count - i) % 300));
+            u_uastrcpy(p16 + length, suffix);
+            lengths16[i] = u_strlen(p16);
+            strings16[i] = p16;
+            u_strToUTF8(p8, MAX_LENGTH * 3, &lengths8[i], p16, lengths16[i], &errorCode);
+            strings8[i] = p8;
+        }
+        if (U_FAILURE(errorCode)) {
+            log_err("unable to set up the test strings - %s\n", u_errorName(errorCode));
+            break;
+        }
+
+        sprintf(name, "ucol_sortStrings(count=%d, serial)", (int)count);
+        ucol_sortStrings(coll, strings16, lengths16, count, NULL, NULL, &errorCode);
+        checkSorted16(name, coll, s16, MAX_LENGTH, strings16, lengths16, count, seen, errorCode);
+        errorCode = U_ZERO_ERROR;
+
+        sprintf(name, "ucol_sortStringsUTF8(count=%d, runner)", (int)count);
+        ucol_sortStringsUTF8(coll, strings8, lengths8, count, runTasksBackward, NULL, &errorCode);
+        checkSorted8(name, coll, s8, MAX_LENGTH * 3, strings8, lengths8, count, seen, errorCode);
+        errorCode = U_ZERO_ERROR;
+
+        /* Sorting again, NUL-terminated and with a runner, must not change the order. */
+        sprintf(name, "ucol_sortStrings(count=%d, runner, NUL-terminated)", (int)count);
+        ucol_sortStrings(coll, strings16, NULL, count, runTasksBackward, NULL, &errorCode);
+        checkSorted16(name, coll, s16, MAX_LENGTH, strings16, NULL, count, seen, errorCode);
+        errorCode = U_ZERO_ERROR;
+        for (i = 0; i < count; ++i) {
+            if ((int32_t)(strings16[i] - s16) / MAX_LENGTH !=
+                    (int32_t)(strings8[i] - s8) / (MAX_LENGTH * 3)) {
+                log_err("%s: UTF-16 and UTF-8 orders differ at [%d]\n", name, (int)i);
+                break;
+            }
+        }
+    }
+
+    ucol_sortStrings(coll, strings16, lengths16, -1, NULL, NULL, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_sortStrings(count=-1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+
+    /* A NULL string is allowed only with length 0. */
+    errorCode = U_ZERO_ERROR;
+    strings16[1] = NULL;
+    lengths16[1] = -1;
+    ucol_sortStrings(coll, strings16, lengths16, COUNT, NULL, NULL, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR || strings16[1] != NULL) {
+        log_err("ucol_sortStrings(NULL string, length -1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+    errorCode = U_ZERO_ERROR;
+    ucol_sortStrings(coll, strings16, NULL, 2, NULL, NULL, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_sortStrings(NULL string, NUL-terminated) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+    errorCode = U_ZERO_ERROR;
+    strings8[1] = NULL;
+    lengths8[1] = 5;
+    ucol_sortStringsUTF8(coll, strings8, lengths8, 2, NULL, NULL, &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_sortStringsUTF8(NULL string, length 5) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+    errorCode = U_ZERO_ERROR;
+    lengths8[1] = 0;
+    ucol_sortStringsUTF8(coll, strings8, lengths8, 2, NULL, NULL, &errorCode);
+    if (U_FAILURE(errorCode) || strings8[0] != NULL) {
+        log_err("ucol_sortStringsUTF8(NULL string, length 0) failed or did not sort it first - %s\n",
+                u_errorName(errorCode));
+    }
+
+cleanup:
+    ucol_close(coll);
+    free(s16);
+    free(s8);
+    free((void *)strings16);
+    free((void *)strings8);
+    free(lengths16);
+    free(lengths8);
+    free(seen);
+}
+
+
+static void TestPrimaryPrefixKeys(void) {
+    static const char *const words[] = {
+        "", "a", "A", "\\u00E4", "ab", "abc", "abcd", "abcdefgh", "abcdefgi", "Abcdefgh",
+        "ab-c", "ab c", "\\u4E00", "\\u4E00\\u4E8C\\u4E09", "\\U00020000\\U00020001",
+        "\\u0428\\u0430\\u0440", "\\u0428\\u0430", "a\\u0323\\u0302", "-", "\\uFFFE"
+    };
+    /* 0 writes only the flag bytes; 5 truncates most strings; 100 fits all of them. */
+    static const int32_t maxLengths[] = { 0, 1, 5, 100 };
+    enum { COUNT = UPRV_LENGTHOF(words) };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &errorCode);
+    UChar s[COUNT][20];
+    int32_t lengths[COUNT];
+    uint8_t keys[COUNT][110];
+    int32_t keyLengths[COUNT];
+    int32_t i, j, m;
+    if (U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "ucol_open(en) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        lengths[i] = u_unescape(words[i], s[i], UPRV_LENGTHOF(s[i]));
+    }
+    ucol_setAttribute(coll, UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, &errorCode);
+    for (m = 0; m < UPRV_LENGTHOF(maxLengths); ++m) {
+        int32_t maxLength = maxLengths[m];
+        for (i = 0; i < COUNT; ++i) {
+            uint8_t fullKey[200];
+            int32_t primaryLength = 0;
+            keyLengths[i] = ucol_getPrimaryPrefixKey(coll, s[i], lengths[i], maxLength,
+                                                     keys[i], UPRV_LENGTHOF(keys[i]), &errorCode);
+            if (U_FAILURE(errorCode)) {
+                log_err("ucol_getPrimaryPrefixKey(%s, max=%d) failed - %s\n",
+                        words[i], (int)maxLength, u_errorName(errorCode));
+                ucol_close(coll);
+                return;
+            }
+            /* The key is the primary level of the full sort key, with a flag byte. */
+            ucol_getSortKey(coll, s[i], lengths[i], fullKey, UPRV_LENGTHOF(fullKey));
+            while (fullKey[primaryLength] > 1) { ++primaryLength; }
+            if ((primaryLength <= maxLength ?
+                    (keyLengths[i] != primaryLength + 2 || keys[i][primaryLength] != 1) :
+                    (keyLengths[i] != maxLength + 2 || keys[i][maxLength] != 0xff)) ||
+                    uprv_memcmp(keys[i], fullKey, keyLengths[i] - 2) != 0 ||
+                    keys[i][keyLengths[i] - 1] != 0) {
+                log_err("ucol_getPrimaryPrefixKey(%s, max=%d) does not match the sort key\n",
+                        words[i], (int)maxLength);
+            }
+            /* Preflighting */
+            if (ucol_getPrimaryPrefixKey(coll, s[i], -1, maxLength, NULL, 0, &errorCode) !=
+                        keyLengths[i] ||
+                    errorCode != U_BUFFER_OVERFLOW_ERROR) {
+                log_err("ucol_getPrimaryPrefixKey(%s, max=%d, preflighting) = %s\n",
+                        words[i], (int)maxLength, u_errorName(errorCode));
+            }
+            errorCode = U_ZERO_ERROR;
+        }
+        /* Different prefix keys must sort like the strings. */
+        for (i = 0; i < COUNT; ++i) {
+            for (j = 0; j < COUNT; ++j) {
+                int32_t keyOrder = uprv_strcmp((const char *)keys[i], (const char *)keys[j]);
+                UCollationResult order = ucol_strcoll(coll, s[i], lengths[i], s[j], lengths[j]);
+                if ((keyOrder < 0 && order != UCOL_LESS) || (keyOrder > 0 && order != UCOL_GREATER)) {
+                    log_err("ucol_getPrimaryPrefixKey(max=%d): %s vs. %s key order differs from ucol_strcoll()\n",
+                            (int)maxLength, words[i], words[j]);
+                }
+            }
+        }
+    }
+    ucol_getPrimaryPrefixKey(coll, s[0], lengths[0], -1, keys[0], UPRV_LENGTHOF(keys[0]), &errorCode);
+    if (errorCode != U_ILLEGAL_ARGUMENT_ERROR) {
+        log_err("ucol_getPrimaryPrefixKey(max=-1) did not fail with U_ILLEGAL_ARGUMENT_ERROR\n");
+    }
+    ucol_close(coll);
+}
+
+static void TestFrontCodedSortKeys(void) {
+    static const char *const words[] = {
+        "", "a", "a", "ab", "abc", "abc", "abcd", "abd", "b", "ba", "bab", "\\u00E4",
+        "Abc", "abc-1", "abc-2", "abc-10", "xyz"
+    };
+    enum { COUNT = UPRV_LENGTHOF(words), LONG_LENGTH = 300 };
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UCollator *coll = ucol_open("en", &errorCode);
+    UChar s[COUNT + 2][LONG_LENGTH];
+    const UChar *strings[COUNT + 2];
+    int32_t lengths[COUNT + 2];
+    uint8_t keys[20000];
+    int32_t offsets[COUNT + 3];
+    uint8_t coded[20000];
+    uint8_t key[2000];
+    int32_t i, total, codedLength, index, keyLength;
+    if (U_FAILURE(errorCode)) {
+        log_err_status(errorCode, "ucol_open(en) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    for (i = 0; i < COUNT; ++i) {
+        lengths[i] = u_unescape(words[i], s[i], LONG_LENGTH);
+        strings[i] = s[i];
+    }
+    /* Two long keys that share a prefix of more than 0x80 bytes. */
+    for (i = 0; i < LONG_LENGTH; ++i) {
+        s[COUNT][i] = s[COUNT + 1][i] = (UChar)(0x61 + i % 26);
+    }
+    s[COUNT + 1][LONG_LENGTH - 1] = 0x41;
+    strings[COUNT] = s[COUNT];
+    strings[COUNT + 1] = s[COUNT + 1];
+    lengths[COUNT] = lengths[COUNT + 1] = LONG_LENGTH;
+    total = ucol_getSortKeys(coll, strings, lengths, COUNT + 2, keys, UPRV_LENGTHOF(keys), offsets,
+                             NULL, NULL, &errorCode);
+    codedLength = ucol_frontCodeSortKeys(keys, offsets, COUNT + 2, coded, UPRV_LENGTHOF(coded),
+                                         &errorCode);
+    if (U_FAILURE(errorCode)) {
+        log_err("ucol_frontCodeSortKeys() failed - %s\n", u_errorName(errorCode));
+        ucol_close(coll);
+        return;
+    }
+    if (codedLength >= total) {
+        log_err("ucol_frontCodeSortKeys() did not shorten the keys: %d >= %d\n",
+                (int)codedLength, (int)total);
+    }
+    if (ucol_frontCodeSortKeys(keys, offsets, COUNT + 2, coded, codedLength - 1, &errorCode) !=
+                codedLength ||
+            errorCode != U_BUFFER_OVERFLOW_ERROR) {
+        log_err("ucol_frontCodeSortKeys(too small) = %s\n", u_errorName(errorCode));
+    }
+    errorCode = U_ZERO_ERROR;
+
+    index = 0;
+    keyLength = 0;
+    for (i = 0; i <= COUNT + 2; ++i) {
+        keyLength = ucol_nextFrontCodedSortKey(coded, codedLength, &index,
+                                               key, UPRV_LENGTHOF(key), keyLength, &errorCode);
+        if (U_FAILURE(errorCode)) {
+            log_err("ucol_nextFrontCodedSortKey([%d]) failed - %s\n", (int)i, u_errorName(errorCode));
+            break;
+        }
+        if (i == COUNT + 2) {
+            if (keyLength != 0 || index != codedLength) {
+                log_err("ucol_nextFrontCodedSortKey() did not stop at the end\n");
+            }
+        } else if (keyLength != offsets[i + 1] - offsets[i] ||
+                uprv_memcmp(key, keys + offsets[i], keyLength) != 0) {
+            log_err("ucol_nextFrontCodedSortKey([%d]) differs from the sort key\n", (int)i);
+            break;
+        }
+    }
+
+    /* A key buffer that is too small, then a malformed input. */
+    index = 0;
+    keyLength = ucol_nextFrontCodedSortKey(coded, codedLength, &index, key, 1, 0, &errorCode);
+    if (errorCode != U_BUFFER_OVERFLOW_ERROR || keyLength != offsets[1] || index != 0) {
+        log_err("ucol_nextFrontCodedSortKey(too small) = %s\n", u_errorName(errorCode));
+    }
+    errorCode = U_ZERO_ERROR;
+    coded[0] = 5;
+    ucol_nextFrontCodedSortKey(coded, codedLength, &index, key, UPRV_LENGTHOF(key), 0, &errorCode);
+    if (errorCode != U_INVALID_FORMAT_ERROR) {
+        log_err("ucol_nextFrontCodedSortKey(bad prefix length) = %s\n", u_errorName(errorCode));
+    }
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
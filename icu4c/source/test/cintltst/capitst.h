@@ -137,6 +137,24 @@
      */
     static void TestStrcollNull(void);
 
+    /**
+     * Test batch sort keys
+     */
+    static void TestGetSortKeys(void);
+
+    /**
+     * Test sorting arrays of strings
+     */
+    static void TestSortStrings(void);
+    /**
+     * Test ucol_getPrimaryPrefixKey()
+     */
+    static void TestPrimaryPrefixKeys(void);
+    /**
+     * Test ucol_frontCodeSortKeys() and ucol_nextFrontCodedSortKey()
+     */
+    static void TestFrontCodedSortKeys(void);
+
 #endif /* #if !UCONFIG_NO_COLLATION */
 
 #endif
@@ -52,6 +52,9 @@ static void TestBreakIteratorTailoring(void);
 static void TestBreakIteratorRefresh(void);
 static void TestBug11665(void);
 static void TestBreakIteratorSuppressions(void);
+#if !UCONFIG_NO_FILE_IO
+static void TestBreakIteratorNextBoundaries(void);
+#endif
 
 void addBrkIterAPITest(TestNode** root);
 
@@ -71,6 +74,9 @@ void addBrkIterAPITest(TestNode** root)
 #if !UCONFIG_NO_FILTERED_BREAK_ITERATION
     addTest(root, &TestBreakIteratorSuppressions, "tstxtbd/cbiapts/TestBreakIteratorSuppressions");
 #endif
+#if !UCONFIG_NO_FILE_IO
+    addTest(root, &TestBreakIteratorNextBoundaries, "tstxtbd/cbiapts/TestBreakIteratorNextBoundaries");
+#endif
 }
 
 #define CLONETEST_ITERATOR_COUNT 2
@@ -1110,4 +1116,76 @@ static void TestBreakIteratorSuppressions(void) {
 }
 
 
+#if !UCONFIG_NO_FILE_IO
+/*
+ * TestBreakIteratorNextBoundaries
+ *
+ *     ubrk_nextBoundaries() returns the same boundaries and statuses as ubrk_next(),
+ *     for a rule based iterator and for a filtered (non-rule-based) iterator.
+ */
+static void TestBreakIteratorNextBoundaries(void) {
+    static const struct {
+        UBreakIteratorType type;
+        const char *locale;
+    } iterTypes[] = {
+        { UBRK_WORD, "en" },
+        { UBRK_SENTENCE, "en@ss=standard" }
+    };
+    UChar text[100];
+    int32_t textLength, i;
+    textLength = u_unescape("Mr. Smith said: \"Hello, world.\" Mrs. Jones went to \u0e20\u0e32\u0e29\u0e32\u0e44\u0e17\u0e22. Done?",
+                            text, UPRV_LENGTHOF(text));
+    for (i = 0; i < UPRV_LENGTHOF(iterTypes); ++i) {
+        int32_t expected[100], expectedStatus[100], boundaries[100], statuses[100];
+        int32_t count = 0, length, n, pos;
+        UErrorCode status = U_ZERO_ERROR;
+        UBreakIterator *bi = ubrk_open(iterTypes[i].type, iterTypes[i].locale, text, textLength, &status);
+        if (U_FAILURE(status)) {
+            log_data_err("FAIL: ubrk_open(%s) failed - %s (Are you missing data?)\n",
+                         iterTypes[i].locale, u_errorName(status));
+            continue;
+        }
+        while ((pos = ubrk_next(bi)) != UBRK_DONE) {
+            expectedStatus[count] = ubrk_getRuleStatus(bi);
+            expected[count++] = pos;
+        }
+
+        /* Everything at once. */
+        ubrk_first(bi);
+        length = ubrk_nextBoundaries(bi, INT32_MAX, boundaries, statuses, UPRV_LENGTHOF(boundaries), &status);
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT(length == count);
+        for (n = 0; n < length && n < count; ++n) {
+            if (boundaries[n] != expected[n] || statuses[n] != expectedStatus[n]) {
+                log_err("FAIL: %s ubrk_nextBoundaries() #%d = %d status %d, expected %d status %d\n",
+                        iterTypes[i].locale, n, boundaries[n], statuses[n], expected[n], expectedStatus[n]);
+                break;
+            }
+        }
+        TEST_ASSERT(ubrk_current(bi) == textLength);
+
+        /* Two at a time, up to a limit, leaving the iterator at the last boundary returned. */
+        ubrk_first(bi);
+        n = 0;
+        while ((length = ubrk_nextBoundaries(bi, expected[count - 2], boundaries, NULL, 2, &status)) > 0) {
+            int32_t j;
+            for (j = 0; j < length; ++j, ++n) {
+                if (boundaries[j] != expected[n]) {
+                    log_err("FAIL: %s ubrk_nextBoundaries() piecewise #%d = %d, expected %d\n",
+                            iterTypes[i].locale, n, boundaries[j], expected[n]);
+                }
+            }
+            TEST_ASSERT(ubrk_current(bi) == expected[n - 1]);
+        }
+        TEST_ASSERT_SUCCESS(status);
+        TEST_ASSERT(n == count - 1);
+        TEST_ASSERT(ubrk_next(bi) == expected[count - 1]);
+
+        ubrk_nextBoundaries(bi, INT32_MAX, NULL, NULL, -1, &status);
+        TEST_ASSERT(status == U_ILLEGAL_ARGUMENT_ERROR);
+        ubrk_close(bi);
+    }
+}
+#endif
+
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
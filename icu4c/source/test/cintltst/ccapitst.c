@@ -57,6 +57,7 @@ cnv_open(const char *name, UErrorCode *pErrorCode) {
 static void ListNames(void);
 static void TestFlushCache(void);
 static void TestDuplicateAlias(void);
+static void TestAliasHashTable(void);
 static void TestCCSID(void);
 static void TestJ932(void);
 static void TestJ1968(void);
@@ -72,6 +73,8 @@ static void TestEBCDICSwapLFNL(void);
 static void TestConvertEx(void);
 static void TestConvertExFromUTF8(void);
 static void TestConvertExFromUTF8_C5F0(void);
+static void TestConvertExToUTF8(void);
+static void TestConverterPool(void);
 static void TestConvertAlgorithmic(void);
        void TestDefaultConverterError(void);    /* defined in cctest.c */
        void TestDefaultConverterSet(void);    /* defined in cctest.c */
@@ -93,6 +96,7 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestFlushCache,              "tsconv/ccapitst/TestFlushCache"); 
     addTest(root, &TestAlias,                   "tsconv/ccapitst/TestAlias"); 
     addTest(root, &TestDuplicateAlias,          "tsconv/ccapitst/TestDuplicateAlias"); 
+    addTest(root, &TestAliasHashTable,          "tsconv/ccapitst/TestAliasHashTable");
     addTest(root, &TestConvertSafeClone,        "tsconv/ccapitst/TestConvertSafeClone");
 #if !UCONFIG_NO_LEGACY_CONVERSION
     addTest(root, &TestConvertSafeCloneCallback,"tsconv/ccapitst/TestConvertSafeCloneCallback");
@@ -107,6 +111,8 @@ void addTestConvert(TestNode** root)
     addTest(root, &TestConvertEx,               "tsconv/ccapitst/TestConvertEx");
     addTest(root, &TestConvertExFromUTF8,       "tsconv/ccapitst/TestConvertExFromUTF8");
     addTest(root, &TestConvertExFromUTF8_C5F0,  "tsconv/ccapitst/TestConvertExFromUTF8_C5F0");
+    addTest(root, &TestConvertExToUTF8,         "tsconv/ccapitst/TestConvertExToUTF8");
+    addTest(root, &TestConverterPool,           "tsconv/ccapitst/TestConverterPool");
     addTest(root, &TestConvertAlgorithmic,      "tsconv/ccapitst/TestConvertAlgorithmic");
     addTest(root, &TestDefaultConverterError,   "tsconv/ccapitst/TestDefaultConverterError");
     addTest(root, &TestDefaultConverterSet,     "tsconv/ccapitst/TestDefaultConverterSet");
@@ -1331,6 +1337,198 @@ static void TestDuplicateAlias(void) {
     }
 }
 
+typedef struct AliasEntry {
+    const char *alias;
+    const char *converterName;
+} AliasEntry;
+
+static int U_CALLCONV
+compareAliasEntries(const void *left, const void *right) {
+    return ucnv_compareNames(((const AliasEntry *)left)->alias, ((const AliasEntry *)right)->alias);
+}
+
+/*
+ * Binary search in the sorted alias entries, the way alias lookups work
+ * without the alias hash table.
+ * @return the index of the first entry for the alias, or -1 if not found
+ */
+static int32_t
+binarySearchAlias(const AliasEntry *entries, int32_t count, const char *alias) {
+    int32_t start = 0, limit = count;
+    while (start < limit) {
+        int32_t mid = (start + limit) / 2;
+        if (ucnv_compareNames(alias, entries[mid].alias) <= 0) {
+            limit = mid;
+        } else {
+            start = mid + 1;
+        }
+    }
+    return start < count && ucnv_compareNames(alias, entries[start].alias) == 0 ? start : -1;
+}
+
+/*
+ * Alias lookups with the alias hash table (cnvalias.icu formatVersion 3.1)
+ * must find the same converters as a binary search in the sorted aliases.
+ */
+static void TestAliasHashTable(void) {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    UEnumeration *allNames = ucnv_openAllNames(&errorCode);
+    int32_t numConverters = uenum_count(allNames, &errorCode);
+    AliasEntry *entries = NULL;
+    int32_t count = 0, capacity = 0;
+    const char *name, *converterName, *expectedName, *canonicalName;
+    char variant[100];
+    int32_t i, j, first, numStandards;
+    uint16_t k, numAliases;
+
+    if (U_FAILURE(errorCode) || numConverters <= 0) {
+        log_data_err("ucnv_openAllNames() failed - %s\n", u_errorName(errorCode));
+        uenum_close(allNames);
+        return;
+    }
+    /* all aliases of all converters */
+    for (i = 0; i < numConverters; ++i) {
+        converterName = uenum_next(allNames, NULL, &errorCode);
+        if (U_FAILURE(errorCode) || converterName == NULL) {
+            log_err("uenum_next(all converter names) failed at %d - %s\n", (int)i, u_errorName(errorCode));
+            break;
+        }
+        numAliases = ucnv_countAliases(converterName, &errorCode);
+        if (count + numAliases > capacity) {
+            AliasEntry *newEntries;
+            capacity = 2 * capacity + numAliases + 1000;
+            newEntries = (AliasEntry *)realloc(entries, capacity * sizeof(AliasEntry));
+            if (newEntries == NULL) {
+                log_err("out of memory\n");
+                break;
+            }
+            entries = newEntries;
+        }
+        for (k = 0; k < numAliases; ++k) {
+            name = ucnv_getAlias(converterName, k, &errorCode);
+            if (U_FAILURE(errorCode) || name == NULL) {
+                log_err("ucnv_getAlias(%s, %d) failed - %s\n", converterName, (int)k, u_errorName(errorCode));
+                errorCode = U_ZERO_ERROR;
+                continue;
+            }
+            entries[count].alias = name;
+            entries[count].converterName = converterName;
+            ++count;
+        }
+        errorCode = U_ZERO_ERROR;  /* ignore U_AMBIGUOUS_ALIAS_WARNING */
+    }
+    if (count == 0) {
+        log_data_err("no converter aliases\n");
+        free(entries);
+        uenum_close(allNames);
+        return;
+    }
+    qsort(entries, count, sizeof(AliasEntry), compareAliasEntries);
+    numStandards = ucnv_countStandards();
+
+    for (i = 0; i < count; ++i) {
+        name = entries[i].alias;
+        expectedName = entries[i].converterName;
+        first = binarySearchAlias(entries, count, name);
+        errorCode = U_ZERO_ERROR;
+        converterName = ucnv_getAlias(name, 0, &errorCode);
+        if (U_FAILURE(errorCode) || converterName == NULL || first < 0) {
+            log_err("ucnv_getAlias(%s, 0) failed - %s\n", name, u_errorName(errorCode));
+            continue;
+        }
+        /* an ambiguous alias resolves to one of the converters that have it */
+        for (j = first; j < count && ucnv_compareNames(name, entries[j].alias) == 0; ++j) {
+            if (strcmp(converterName, entries[j].converterName) == 0) {
+                break;
+            }
+        }
+        if (j == count || ucnv_compareNames(name, entries[j].alias) != 0) {
+            log_err("%s resolved to %s, not to a converter with that alias\n", name, converterName);
+            continue;
+        }
+
+        /* a case and punctuation variant must resolve to the same converter */
+        if (strlen(name) >= sizeof(variant)) {
+            continue;
+        }
+        strcpy(variant, name);
+        for (j = 0; name[j] != 0 && name[j] != ','; ++j) {  /* options are case-sensitive */
+            char c = name[j];
+            variant[j] = c == '-' ? '_' : c == '_' ? '-' : (char)(isupper((unsigned char)c) ? tolower(c) : toupper(c));
+        }
+        errorCode = U_ZERO_ERROR;
+        canonicalName = ucnv_getAlias(variant, 0, &errorCode);
+        if (canonicalName == NULL || strcmp(canonicalName, converterName) != 0 ||
+                binarySearchAlias(entries, count, variant) != first) {
+            log_err("variant %s of %s did not resolve to %s\n", variant, name, converterName);
+        }
+
+        /* the canonical name for a standard's alias */
+        for (j = 0; j < numStandards; ++j) {
+            UErrorCode standardErrorCode = U_ZERO_ERROR;
+            const char *standard = ucnv_getStandard((uint16_t)j, &standardErrorCode);
+            const char *standardName;
+            if (standard == NULL || *standard == 0) {
+                continue;
+            }
+            standardName = ucnv_getStandardName(expectedName, standard, &standardErrorCode);
+            if (standardName == NULL || ucnv_compareNames(standardName, name) != 0) {
+                continue;
+            }
+            standardErrorCode = U_ZERO_ERROR;
+            canonicalName = ucnv_getCanonicalName(variant, standard, &standardErrorCode);
+            if (canonicalName == NULL ||
+                    (strcmp(canonicalName, expectedName) != 0 &&
+                     standardErrorCode != U_AMBIGUOUS_ALIAS_WARNING)) {
+                log_err("ucnv_getCanonicalName(%s, %s) returned %s rather than %s\n",
+                        variant, standard, canonicalName != NULL ? canonicalName : "(none)",
+                        expectedName);
+            }
+        }
+
+        /* opening the alias opens the converter */
+        if (i % 7 == 0) {
+            UErrorCode cnvErrorCode = U_ZERO_ERROR;
+            UConverter *expected = ucnv_open(converterName, &cnvErrorCode);
+            if (U_SUCCESS(cnvErrorCode)) {
+                UConverter *cnv = ucnv_open(variant, &cnvErrorCode);
+                if (U_FAILURE(cnvErrorCode) ||
+                        strcmp(ucnv_getName(cnv, &cnvErrorCode), ucnv_getName(expected, &cnvErrorCode)) != 0) {
+                    log_err("ucnv_open(%s) did not open %s - %s\n",
+                            variant, converterName, u_errorName(cnvErrorCode));
+                }
+                ucnv_close(cnv);
+            }
+            ucnv_close(expected);
+        }
+    }
+
+    /* a miss */
+    errorCode = U_ZERO_ERROR;
+    name = "no-such-charset-x9";
+    if (binarySearchAlias(entries, count, name) >= 0 ||
+            ucnv_getAlias(name, 0, &errorCode) != NULL ||
+            ucnv_countAliases(name, &errorCode) != 0 ||
+            ucnv_getCanonicalName(name, "IANA", &errorCode) != NULL) {
+        log_err("%s was found\n", name);
+    }
+    errorCode = U_ZERO_ERROR;
+    ucnv_close(ucnv_open(name, &errorCode));
+    if (errorCode != U_FILE_ACCESS_ERROR) {
+        log_err("ucnv_open(%s) did not fail with U_FILE_ACCESS_ERROR - %s\n", name, u_errorName(errorCode));
+    }
+
+    /* ignorable punctuation */
+    errorCode = U_ZERO_ERROR;
+    converterName = ucnv_getAlias("u t.f:8", 0, &errorCode);
+    if (U_FAILURE(errorCode) || converterName == NULL || strcmp(converterName, "UTF-8") != 0) {
+        log_err("ucnv_getAlias(\"u t.f:8\", 0) did not return UTF-8 - %s\n", u_errorName(errorCode));
+    }
+
+    free(entries);
+    uenum_close(allNames);
+}
+
 
 /* Test safe clone callback */
 
@@ -2777,6 +2975,196 @@ static void TestConvertExFromUTF8_C5F0() {
     ucnv_close(utf8Cnv);
 }
 
+/*
+ * Conversion from legacy charsets to UTF-8 can bypass the UTF-16 pivot.
+ * Expect the same results as with toUnicode conversion followed by u_strToUTF8(),
+ * including for extension mappings, stateful encodings,
+ * unassigned and illegal byte sequences.
+ */
+static void TestConvertExToUTF8() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const char *const converterNames[]={
+        "windows-1252",
+        "ibm-1047,swaplfnl",
+        "shift-jis",
+        "windows-936",
+        "EUC-JP",
+        "ibm-970",
+        "gb18030",
+        "ibm-930",
+        "ibm-1390",
+        "ibm-16684"
+    };
+    static const UChar text[]={
+        0x61, 0x62, 0x63, 0x20, 0x31, 0x32, 0x33, 0xa, 0x85, 0xe4, 0xe9, 0x20ac,
+        0x3042, 0x30a2, 0x4e00, 0x4e8c, 0x20, 0xff61, 0x5b57, 0xac00, 0x391, 0x410,
+        0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c,
+        0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+        0xd840, 0xdc0b, 0x3000, 0xfffd, 0x7a,
+        /* single-byte characters between double-byte ones, for SI/SO and EUC state changes */
+        0x61, 0x4e00, 0x62, 0x3042, 0x20, 0x30a2, 0x31, 0x4e8c, 0x32, 0x5b57, 0xa, 0x3000, 0x7a
+    };
+    /* bytes that are unassigned or illegal in some of the charsets */
+    static const char badBytes[]={
+        (char)0xff, (char)0x80, (char)0xa0, (char)0x82, (char)0x7f, (char)0x0e, (char)0xfe, (char)0x0f
+    };
+
+    UConverter *utf8Cnv, *cnv;
+    UErrorCode errorCode;
+    int32_t i;
+
+    char src[400], expect[800];
+    UChar pivot[200];
+    int32_t srcLength, pivotLength, expectLength;
+
+    errorCode=U_ZERO_ERROR;
+    utf8Cnv=ucnv_open("UTF-8", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to open UTF-8 converter - %s\n", u_errorName(errorCode));
+        return;
+    }
+
+    for(i=0; i<UPRV_LENGTHOF(converterNames); ++i) {
+        errorCode=U_ZERO_ERROR;
+        cnv=ucnv_open(converterNames[i], &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open %s converter - %s\n", converterNames[i], u_errorName(errorCode));
+            continue;
+        }
+
+        /* text, bad bytes, text again */
+        srcLength=ucnv_fromUChars(cnv, src, 180, text, UPRV_LENGTHOF(text), &errorCode);
+        uprv_memcpy(src+srcLength, badBytes, sizeof(badBytes));
+        srcLength+=(int32_t)sizeof(badBytes);
+        srcLength+=ucnv_fromUChars(cnv, src+srcLength, 180, text, UPRV_LENGTHOF(text), &errorCode);
+
+        /* expected UTF-8 via UTF-16 */
+        pivotLength=ucnv_toUChars(cnv, pivot, UPRV_LENGTHOF(pivot), src, srcLength, &errorCode);
+        u_strToUTF8(expect, (int32_t)sizeof(expect), &expectLength, pivot, pivotLength, &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_err("unable to set up the %s to UTF-8 test - %s\n", converterNames[i], u_errorName(errorCode));
+        } else {
+            convertExMultiStreaming(cnv, utf8Cnv,
+                                    src, srcLength,
+                                    expect, expectLength,
+                                    converterNames[i],
+                                    U_ZERO_ERROR);
+            convertExStreaming(cnv, utf8Cnv,
+                               src, srcLength,
+                               expect, expectLength,
+                               CHUNK_SIZE, converterNames[i],
+                               U_ZERO_ERROR);
+        }
+        ucnv_close(cnv);
+    }
+    ucnv_close(utf8Cnv);
+#endif
+}
+
+static void
+TestConverterPool() {
+#if !UCONFIG_NO_LEGACY_CONVERSION
+    static const UChar text[]={ 0x61, 0x20ac, 0x4e00 };
+    UErrorCode errorCode=U_ZERO_ERROR;
+    UConverter *cnv, *cnv2;
+    int32_t hits, misses, hits2, misses2, length;
+    char bytes[20];
+    char subChars[4];
+    int8_t subCharLength=(int8_t)sizeof(subChars);
+
+    ucnv_flushCache();
+    ucnv_getPoolStatistics(&hits, &misses);
+
+    cnv=ucnv_acquire("windows-1252", &errorCode);
+    if(U_FAILURE(errorCode)) {
+        log_data_err("unable to ucnv_acquire(windows-1252) - %s\n", u_errorName(errorCode));
+        return;
+    }
+    errorCode=U_ZERO_ERROR;  /* ignore U_AMBIGUOUS_ALIAS_WARNING */
+    /* change settings that ucnv_release() must restore */
+    ucnv_setSubstChars(cnv, "!", 1, &errorCode);
+    ucnv_setFromUCallBack(cnv, UCNV_FROM_U_CALLBACK_STOP, NULL, NULL, NULL, &errorCode);
+    ucnv_setFallback(cnv, TRUE);
+    length=ucnv_fromUChars(cnv, bytes, (int32_t)sizeof(bytes), text, 2, &errorCode);
+    if(errorCode!=U_ZERO_ERROR || length!=2) {
+        log_err("ucnv_fromUChars(acquired windows-1252) failed - %s\n", u_errorName(errorCode));
+    }
+    ucnv_release(cnv);
+
+    /* an alias must find the pooled converter */
+    errorCode=U_ZERO_ERROR;
+    cnv2=ucnv_acquire("cp1252", &errorCode);
+    ucnv_getPoolStatistics(&hits2, &misses2);
+    if(U_FAILURE(errorCode) || cnv2!=cnv || hits2!=hits+1 || misses2!=misses+1) {
+        log_err("ucnv_acquire(cp1252) did not reuse the released windows-1252 converter - %s\n",
+                u_errorName(errorCode));
+    }
+    errorCode=U_ZERO_ERROR;
+    ucnv_getSubstChars(cnv2, subChars, &subCharLength, &errorCode);
+    if(U_FAILURE(errorCode) || subCharLength!=1 || subChars[0]!=0x1a || ucnv_usesFallback(cnv2)) {
+        log_err("ucnv_release() did not restore the default settings\n");
+    }
+    /* the default callback substitutes U+4E00 */
+    length=ucnv_fromUChars(cnv2, bytes, (int32_t)sizeof(bytes), text, 3, &errorCode);
+    if(errorCode!=U_ZERO_ERROR || length!=3 || bytes[2]!=0x1a) {
+        log_err("ucnv_fromUChars(pooled windows-1252) failed - %s\n", u_errorName(errorCode));
+    }
+
+    /* different options are a different pool key */
+    cnv=ucnv_acquire("ibm-1047", &errorCode);
+    ucnv_release(cnv);
+    cnv=ucnv_acquire("ibm-1047,swaplfnl", &errorCode);
+    if(U_FAILURE(errorCode) || uprv_strcmp(ucnv_getName(cnv, &errorCode), "ibm-1047_P100-1995,swaplfnl")!=0) {
+        log_err("ucnv_acquire(ibm-1047,swaplfnl) returned the wrong converter - %s\n",
+                u_errorName(errorCode));
+    }
+    ucnv_release(cnv);
+    ucnv_release(cnv2);
+
+    /* locale-dependent converters are not pooled */
+    ucnv_getPoolStatistics(&hits, &misses);
+    cnv=ucnv_acquire("ISO_2022,locale=ja,version=2", &errorCode);
+    ucnv_release(cnv);
+    cnv=ucnv_acquire("ISO_2022,locale=ja,version=2", &errorCode);
+    ucnv_release(cnv);
+    ucnv_getPoolStatistics(&hits2, &misses2);
+    if(U_FAILURE(errorCode) || hits2!=hits || misses2!=misses+2) {
+        log_err("ISO-2022 converters must not be pooled - %s\n", u_errorName(errorCode));
+    }
+
+    /* ucnv_flushCache() closes pooled converters so that their data can be unloaded */
+    if(ucnv_flushCache()<2) {
+        log_err("ucnv_flushCache() did not unload the data of pooled converters\n");
+    }
+#endif
+
+    /*
+     * u_cleanup() closes pooled converters and resets the statistics,
+     * even if only algorithmic converters were used since the last cleanup
+     * (so that no converter data was loaded).
+     */
+    if(!ctest_resetICU()) {
+        return;
+    }
+    errorCode=U_ZERO_ERROR;
+    cnv=ucnv_acquire("UTF-8", &errorCode);
+    ucnv_release(cnv);
+    if(U_FAILURE(errorCode) || !ctest_resetICU()) {
+        log_err("ucnv_acquire(UTF-8) failed - %s\n", u_errorName(errorCode));
+        return;
+    }
+    ucnv_getPoolStatistics(&hits, &misses);
+    if(hits!=0 || misses!=0) {
+        log_err("u_cleanup() did not reset the converter pool statistics\n");
+    }
+    cnv=ucnv_acquire("UTF-8", &errorCode);
+    ucnv_getPoolStatistics(&hits, &misses);
+    if(U_FAILURE(errorCode) || hits!=0 || misses!=1) {
+        log_err("u_cleanup() did not empty the converter pool - %s\n", u_errorName(errorCode));
+    }
+    ucnv_close(cnv);
+}
+
 static void
 TestConvertAlgorithmic() {
 #if !UCONFIG_NO_LEGACY_CONVERSION
@@ -58,6 +58,7 @@ void addCollIterTest(TestNode** root)
     addTest(root, &TestSmallBuffer, "tscoll/citertst/TestSmallBuffer");
     addTest(root, &TestDiscontiguos, "tscoll/citertst/TestDiscontiguos");
     addTest(root, &TestSearchCollatorElements, "tscoll/citertst/TestSearchCollatorElements");
+    addTest(root, &TestNextCEs, "tscoll/citertst/TestNextCEs");
 }
 
 /* The locales we support */
@@ -1258,4 +1259,51 @@ static void TestSearchCollatorElements(void)
     }
 }
 
+static void TestNextCEs(void)
+{
+    UErrorCode status = U_ZERO_ERROR;
+    UChar text[40];
+    int64_t ces[40];
+    int32_t offsets[40];
+    int32_t textLength, count, i;
+    UCollator *coll = ucol_open("de", &status);
+    UCollationElements *elems;
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(de) failed - %s\n", u_errorName(status));
+        return;
+    }
+    textLength = u_unescape("\\u00C4rger a\\u0301\\u0323 \\u00E6", text, UPRV_LENGTHOF(text));
+    elems = ucol_openElements(coll, text, textLength, &status);
+    count = ucol_nextCEs(elems, -1, ces, offsets, UPRV_LENGTHOF(ces), &status);
+    if (U_FAILURE(status)) {
+        log_err("ucol_nextCEs() failed - %s\n", u_errorName(status));
+        ucol_closeElements(elems);
+        ucol_close(coll);
+        return;
+    }
+    ucol_reset(elems);
+    for (i = 0; i < count; ++i) {
+        /* ucol_next() returns the upper halves of the primary, secondary and tertiary weights. */
+        uint32_t p = (uint32_t)(ces[i] >> 32);
+        uint32_t lower32 = (uint32_t)ces[i];
+        int32_t first = (int32_t)((p & 0xffff0000) | ((lower32 >> 16) & 0xff00) | ((lower32 >> 8) & 0xff));
+        uint32_t second = (p << 16) | ((lower32 >> 8) & 0xff00) | (lower32 & 0x3f);
+        if (ucol_next(elems, &status) != first || ucol_getOffset(elems) != offsets[i]) {
+            log_err("ucol_nextCEs()[%d] does not match ucol_next() and ucol_getOffset()\n", (int)i);
+            break;
+        }
+        if (second != 0) {
+            ucol_next(elems, &status);
+        }
+    }
+    if (ucol_next(elems, &status) != UCOL_NULLORDER) {
+        log_err("ucol_nextCEs() returned fewer CEs than ucol_next()\n");
+    }
+    if (ucol_nextCEs(elems, -1, ces, offsets, UPRV_LENGTHOF(ces), &status) != 0 || U_FAILURE(status)) {
+        log_err("ucol_nextCEs() at the end returned CEs or failed - %s\n", u_errorName(status));
+    }
+    ucol_closeElements(elems);
+    ucol_close(coll);
+}
+
 #endif /* #if !UCONFIG_NO_COLLATION */
@@ -91,6 +91,11 @@ static void TestDiscontiguos(void);
 */
 static void TestSearchCollatorElements(void);
 
+/**
+* Test ucol_nextCEs() against ucol_next() and ucol_getOffset()
+*/
+static void TestNextCEs(void);
+
 /*------------------------------------------------------------------------
  Internal utilities
  */
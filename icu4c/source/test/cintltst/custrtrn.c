@@ -38,6 +38,7 @@ static void Test_strFromUTF32_surrogates(void);
 static void Test_UChar_UTF8_API(void);
 static void Test_FromUTF8(void);
 static void Test_FromUTF8Lenient(void);
+static void Test_UTF8_ASCIIRuns(void);
 static void Test_UChar_WCHART_API(void);
 static void Test_widestrs(void);
 static void Test_WCHART_LongString(void);
@@ -55,6 +56,7 @@ addUCharTransformTest(TestNode** root)
    addTest(root, &Test_UChar_UTF8_API, "custrtrn/Test_UChar_UTF8_API");
    addTest(root, &Test_FromUTF8, "custrtrn/Test_FromUTF8");
    addTest(root, &Test_FromUTF8Lenient, "custrtrn/Test_FromUTF8Lenient");
+   addTest(root, &Test_UTF8_ASCIIRuns, "custrtrn/Test_UTF8_ASCIIRuns");
    addTest(root, &Test_UChar_WCHART_API,  "custrtrn/Test_UChar_WCHART_API");
    addTest(root, &Test_widestrs,  "custrtrn/Test_widestrs");
 #if !UCONFIG_NO_FILE_IO && !UCONFIG_NO_LEGACY_CONVERSION
@@ -928,6 +930,101 @@ Test_FromUTF8(void) {
     }
 }
 
+/*
+ * Long runs of ASCII are copied in blocks.
+ * Put a non-ASCII character at each position of an ASCII string and
+ * check the results of conversions and preflighting against the
+ * character-by-character expectations.
+ */
+static void
+Test_UTF8_ASCIIRuns(void) {
+    static const UChar32 specials[]={ 0xe9, 0x4e00, 0x1f600, 0xd800 };
+    enum { LENGTH=70 };
+    UChar src16[LENGTH+2], dest16[LENGTH+4], expected16[LENGTH+2];
+    char src8[LENGTH+4], dest8[LENGTH+4];
+    int32_t i, pos, length16, length8, expectedLength16, destLength, numSubstitutions;
+    UErrorCode errorCode;
+
+    for(i=0; i<UPRV_LENGTHOF(specials); ++i) {
+        UChar32 c=specials[i];
+        for(pos=0; pos<LENGTH; ++pos) {
+            int32_t j;
+            length16=0;
+            for(j=0; j<LENGTH; ++j) {
+                if(j==pos) {
+                    if(c<=0xffff) {
+                        src16[length16++]=(UChar)c;
+                    } else {
+                        src16[length16++]=U16_LEAD(c);
+                        src16[length16++]=U16_TRAIL(c);
+                    }
+                } else {
+                    src16[length16++]=(UChar)(0x20+j);
+                }
+            }
+            u_memcpy(expected16, src16, length16);
+            expectedLength16=length16;
+            if(c==0xd800) {
+                expected16[pos]=0xfffd;
+            }
+
+            /* UTF-16 to UTF-8 */
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8WithSub(dest8, UPRV_LENGTHOF(dest8), &length8, src16, length16,
+                               0xfffd, &numSubstitutions, &errorCode);
+            if(U_FAILURE(errorCode) || numSubstitutions!=(c==0xd800)) {
+                log_err("u_strToUTF8WithSub(U+%04lx at %ld) failed - %s\n",
+                        (long)c, (long)pos, u_errorName(errorCode));
+                continue;
+            }
+            errorCode=U_ZERO_ERROR;
+            u_strToUTF8WithSub(NULL, 0, &destLength, src16, length16,
+                               0xfffd, NULL, &errorCode);
+            if(errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=length8) {
+                log_err("u_strToUTF8WithSub(preflight U+%04lx at %ld) length %ld!=%ld - %s\n",
+                        (long)c, (long)pos, (long)destLength, (long)length8, u_errorName(errorCode));
+            }
+            uprv_memcpy(src8, dest8, length8);
+
+            /* UTF-8 to UTF-16 */
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8WithSub(dest16, UPRV_LENGTHOF(dest16), &destLength, src8, length8,
+                                 0xfffd, NULL, &errorCode);
+            if(U_FAILURE(errorCode) || destLength!=expectedLength16 ||
+                    0!=u_memcmp(dest16, expected16, destLength)) {
+                log_err("u_strFromUTF8WithSub(U+%04lx at %ld) failed - %s\n",
+                        (long)c, (long)pos, u_errorName(errorCode));
+            }
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8WithSub(NULL, 0, &destLength, src8, length8,
+                                 0xfffd, NULL, &errorCode);
+            if(errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength16) {
+                log_err("u_strFromUTF8WithSub(preflight U+%04lx at %ld) length %ld!=%ld - %s\n",
+                        (long)c, (long)pos, (long)destLength, (long)expectedLength16,
+                        u_errorName(errorCode));
+            }
+            /* destination overflow in the middle of the ASCII run */
+            errorCode=U_ZERO_ERROR;
+            u_memset(dest16, 0x55, UPRV_LENGTHOF(dest16));
+            u_strFromUTF8WithSub(dest16, LENGTH/2, &destLength, src8, length8,
+                                 0xfffd, NULL, &errorCode);
+            if(errorCode!=U_BUFFER_OVERFLOW_ERROR || destLength!=expectedLength16 ||
+                    dest16[LENGTH/2]!=0x55) {
+                log_err("u_strFromUTF8WithSub(overflow U+%04lx at %ld) failed - %s\n",
+                        (long)c, (long)pos, u_errorName(errorCode));
+            }
+            errorCode=U_ZERO_ERROR;
+            u_strFromUTF8Lenient(dest16, UPRV_LENGTHOF(dest16), &destLength, src8, length8,
+                                 &errorCode);
+            if(U_FAILURE(errorCode) || destLength!=expectedLength16 ||
+                    0!=u_memcmp(dest16, expected16, destLength)) {
+                log_err("u_strFromUTF8Lenient(U+%04lx at %ld) failed - %s\n",
+                        (long)c, (long)pos, u_errorName(errorCode));
+            }
+        }
+    }
+}
+
 /* test u_strFromUTF8Lenient() */
 static void
 Test_FromUTF8Lenient(void) {
@@ -51,6 +51,7 @@ static void TestUTF32(void);
 static void TestUTF32BE(void);
 static void TestUTF32LE(void);
 static void TestLATIN1(void);
+static void TestASCIIRuns(void);
 
 #if !UCONFIG_NO_LEGACY_CONVERSION
 static void TestSBCS(void);
@@ -274,6 +275,7 @@ void addTestNewConvert(TestNode** root)
 #endif
 
    addTest(root, &TestLATIN1, "tsconv/nucnvtst/TestLATIN1");
+   addTest(root, &TestASCIIRuns, "tsconv/nucnvtst/TestASCIIRuns");
 
 #if !UCONFIG_NO_LEGACY_CONVERSION
    addTest(root, &TestSBCS, "tsconv/nucnvtst/TestSBCS");
@@ -2400,6 +2402,117 @@ TestUTF32LE() {
     ucnv_close(cnv);
 }
 
+/*
+ * The UTF-8, ISO-8859-1 and US-ASCII converters copy runs of ASCII characters
+ * in blocks. Put one non-ASCII character at each position of an ASCII string
+ * and check the output and offsets of both directions against expectations,
+ * and the direct UTF-8 to Latin-1/ASCII conversion.
+ */
+static void
+TestASCIIRuns() {
+    static const char *const names[]={ "UTF-8", "ISO-8859-1", "US-ASCII" };
+    enum { LENGTH=50 };
+    UChar text[LENGTH], uOut[LENGTH+4];
+    char bytes[LENGTH+4], expBytes[LENGTH+4], utf8[LENGTH+4];
+    int32_t offsets[LENGTH+4], expOffsets[LENGTH+4];
+    int32_t n, pos, i, bytesLength, utf8Length;
+
+    for(n=0; n<UPRV_LENGTHOF(names); ++n) {
+        UErrorCode errorCode=U_ZERO_ERROR;
+        UConverter *cnv=ucnv_open(names[n], &errorCode);
+        UConverter *utf8Cnv=ucnv_open("UTF-8", &errorCode);
+        if(U_FAILURE(errorCode)) {
+            log_data_err("unable to open the %s converter - %s\n", names[n], u_errorName(errorCode));
+            ucnv_close(cnv);
+            ucnv_close(utf8Cnv);
+            continue;
+        }
+        /* US-ASCII gets an all-ASCII string: pos==LENGTH */
+        for(pos=(n==2 ? LENGTH : 0); pos<=LENGTH; ++pos) {
+            const char *src;
+            char *dest;
+            const UChar *uSrc;
+            UChar *uDest;
+
+            /* build the input and the expected output */
+            bytesLength=0;
+            for(i=0; i<LENGTH; ++i) {
+                if(i==pos) {
+                    text[i]=0xe9;
+                    if(n==0) {
+                        expOffsets[bytesLength]=i;
+                        expBytes[bytesLength++]=(char)0xc3;
+                        expOffsets[bytesLength]=i;
+                        expBytes[bytesLength++]=(char)0xa9;
+                    } else {
+                        expOffsets[bytesLength]=i;
+                        expBytes[bytesLength++]=(char)0xe9;
+                    }
+                } else {
+                    text[i]=(UChar)(0x21+i);
+                    expOffsets[bytesLength]=i;
+                    expBytes[bytesLength++]=(char)(0x21+i);
+                }
+            }
+
+            /* from Unicode */
+            ucnv_reset(cnv);
+            uSrc=text;
+            dest=bytes;
+            ucnv_fromUnicode(cnv, &dest, bytes+UPRV_LENGTHOF(bytes), &uSrc, text+LENGTH,
+                             offsets, TRUE, &errorCode);
+            if( U_FAILURE(errorCode) || (dest-bytes)!=bytesLength ||
+                0!=uprv_memcmp(bytes, expBytes, bytesLength) ||
+                0!=uprv_memcmp(offsets, expOffsets, bytesLength*4)
+            ) {
+                log_err("%s fromUnicode(U+00E9 at %d) failed - %s\n",
+                        names[n], (int)pos, u_errorName(errorCode));
+                break;
+            }
+
+            /* to Unicode */
+            ucnv_reset(cnv);
+            src=bytes;
+            uDest=uOut;
+            ucnv_toUnicode(cnv, &uDest, uOut+UPRV_LENGTHOF(uOut), &src, bytes+bytesLength,
+                           offsets, TRUE, &errorCode);
+            if( U_FAILURE(errorCode) || (uDest-uOut)!=LENGTH ||
+                0!=u_memcmp(uOut, text, LENGTH)
+            ) {
+                log_err("%s toUnicode(U+00E9 at %d) failed - %s\n",
+                        names[n], (int)pos, u_errorName(errorCode));
+                break;
+            }
+            for(i=0; i<LENGTH; ++i) {
+                int32_t expected= (n==0 && i>pos) ? i+1 : i;
+                if(offsets[i]!=expected) {
+                    log_err("%s toUnicode(U+00E9 at %d) offsets[%d]=%d!=%d\n",
+                            names[n], (int)pos, (int)i, (int)offsets[i], (int)expected);
+                    break;
+                }
+            }
+
+            /* from UTF-8 */
+            if(n!=0) {
+                utf8Length=ucnv_fromUChars(utf8Cnv, utf8, UPRV_LENGTHOF(utf8), text, LENGTH, &errorCode);
+                src=utf8;
+                dest=bytes;
+                ucnv_convertEx(cnv, utf8Cnv, &dest, bytes+UPRV_LENGTHOF(bytes), &src, utf8+utf8Length,
+                               NULL, NULL, NULL, NULL, TRUE, TRUE, &errorCode);
+                if( U_FAILURE(errorCode) || (dest-bytes)!=bytesLength ||
+                    0!=uprv_memcmp(bytes, expBytes, bytesLength)
+                ) {
+                    log_err("UTF-8 to %s (U+00E9 at %d) failed - %s\n",
+                            names[n], (int)pos, u_errorName(errorCode));
+                    break;
+                }
+            }
+        }
+        ucnv_close(cnv);
+        ucnv_close(utf8Cnv);
+    }
+}
+
 static void
 TestLATIN1() {
     /* test input */
@@ -3005,6 +3005,176 @@ static void TestIndicPrefixMatch(void)
     close();
 }
 
+typedef struct {
+    const char         *locale;
+    UCollationStrength  strength;
+    UBool               wordBreaks;
+    const char         *text;
+    const char         *patterns[8];
+} MultiPatternItem;
+
+static const MultiPatternItem multiPatternItems[] = {
+    { "en", UCOL_PRIMARY, FALSE,
+      "A quick r\\u00E9sum\\u00E9, a Resume, and the resume\\u0301s; co-op coop",
+      { "resume", "a", "the", "coop", "e", "sume", "r\\u00E9sum\\u00E9", NULL } },
+    { "en", UCOL_TERTIARY, FALSE,
+      "A quick r\\u00E9sum\\u00E9, a Resume, and the resume\\u0301s; co-op coop",
+      { "resume", "a", "the", "coop", "e", "sume", "r\\u00E9sum\\u00E9", NULL } },
+    { "de", UCOL_SECONDARY, FALSE,
+      "Stra\\u00DFe strasse STRASSE Strass",
+      { "strasse", "s", "ss", "e", "stra", "strasse", NULL } },
+    { "en", UCOL_PRIMARY, TRUE,
+      "the other theme then the",
+      { "the", "he", "then", "other", NULL } },
+    { "en", UCOL_PRIMARY, FALSE,
+      "aaaaa banana",
+      { "aa", "ana", "an", "a", NULL } },
+    { "en", UCOL_IDENTICAL, FALSE,
+      "a\\u0301 \\u00E1 a \\u00E1a",
+      { "\\u00E1", "a", "a\\u0301", NULL } },
+    { NULL, UCOL_DEFAULT, FALSE, NULL, { NULL } }
+};
+
+enum { MULTI_MAX_PATTERNS = 8, MULTI_MAX_MATCHES = 16 };
+
+static void TestMultiPattern(void)
+{
+    const MultiPatternItem *item;
+    for (item = multiPatternItems; item->locale != NULL; item++) {
+        UErrorCode status = U_ZERO_ERROR;
+        UChar text[128];
+        UChar patterns[MULTI_MAX_PATTERNS][32];
+        const UChar *patternPtrs[MULTI_MAX_PATTERNS];
+        int32_t patternCount = 0;
+        int32_t starts[MULTI_MAX_PATTERNS][MULTI_MAX_MATCHES];
+        int32_t limits[MULTI_MAX_PATTERNS][MULTI_MAX_MATCHES];
+        int32_t counts[MULTI_MAX_PATTERNS] = { 0 };
+        int32_t firstPattern = USEARCH_DONE, firstStart = USEARCH_DONE, firstLimit = USEARCH_DONE;
+        int32_t pattern, start, limit, i;
+        UCollator *coll;
+        UBreakIterator *breakiter = NULL;
+        UMultiStringSearch *msearch;
+
+        u_unescape(item->text, text, UPRV_LENGTHOF(text));
+        for (; item->patterns[patternCount] != NULL; ++patternCount) {
+            u_unescape(item->patterns[patternCount], patterns[patternCount], 32);
+            patternPtrs[patternCount] = patterns[patternCount];
+        }
+        coll = ucol_open(item->locale, &status);
+        if (U_FAILURE(status)) {
+            log_data_err("ucol_open(%s) failed: %s\n", item->locale, u_errorName(status));
+            continue;
+        }
+        ucol_setStrength(coll, item->strength);
+        if (item->wordBreaks) {
+            breakiter = ubrk_open(UBRK_WORD, item->locale, text, -1, &status);
+        }
+        msearch = usearch_openMulti(patternPtrs, NULL, patternCount, text, -1, coll, breakiter, &status);
+        if (U_FAILURE(status)) {
+            log_err("usearch_openMulti(%s) failed: %s\n", item->text, u_errorName(status));
+            ubrk_close(breakiter);
+            ucol_close(coll);
+            continue;
+        }
+        while ((pattern = usearch_nextMulti(msearch, &start, &limit, &status)) != USEARCH_DONE) {
+            if (pattern < 0 || pattern >= patternCount || counts[pattern] >= MULTI_MAX_MATCHES ||
+                    start < 0 || start >= limit) {
+                log_err("usearch_nextMulti(%s) returned bad match %d [%d, %d[\n",
+                        item->text, pattern, start, limit);
+                break;
+            }
+            if (firstPattern == USEARCH_DONE) {
+                firstPattern = pattern;
+                firstStart = start;
+                firstLimit = limit;
+            }
+            starts[pattern][counts[pattern]] = start;
+            limits[pattern][counts[pattern]] = limit;
+            ++counts[pattern];
+        }
+        if (U_FAILURE(status) || start != USEARCH_DONE || limit != USEARCH_DONE) {
+            log_err("usearch_nextMulti(%s) did not end properly: %s\n", item->text, u_errorName(status));
+        }
+
+        /* Each pattern must have the same matches as with a single-pattern search. */
+        for (i = 0; i < patternCount; ++i) {
+            UStringSearch *strsrch = usearch_openFromCollator(patternPtrs[i], -1, text, -1,
+                                                              coll, breakiter, &status);
+            int32_t count = 0;
+            while (U_SUCCESS(status) && (start = usearch_next(strsrch, &status)) != USEARCH_DONE) {
+                limit = start + usearch_getMatchedLength(strsrch);
+                if (count >= counts[i] || starts[i][count] != start || limits[i][count] != limit) {
+                    log_err("text %s pattern %s: usearch_next match %d is [%d, %d[ but multi-pattern search differs\n",
+                            item->text, item->patterns[i], count, start, limit);
+                }
+                ++count;
+            }
+            if (U_FAILURE(status)) {
+                log_err("usearch_next(%s) failed: %s\n", item->patterns[i], u_errorName(status));
+            } else if (count != counts[i]) {
+                log_err("text %s pattern %s: usearch_next found %d matches, multi-pattern search %d\n",
+                        item->text, item->patterns[i], count, counts[i]);
+            }
+            usearch_close(strsrch);
+        }
+
+        usearch_resetMulti(msearch);
+        pattern = usearch_nextMulti(msearch, &start, &limit, &status);
+        if (pattern != firstPattern || start != firstStart || limit != firstLimit) {
+            log_err("usearch_resetMulti(%s) did not restart the search\n", item->text);
+        }
+        usearch_closeMulti(msearch);
+        ubrk_close(breakiter);
+        ucol_close(coll);
+    }
+}
+
+static void TestMultiPatternErrors(void)
+{
+    static const UChar pattern1[] = { 0x61, 0 };  /* a */
+    static const UChar pattern2[] = { 0x301, 0 };  /* combining acute */
+    static const UChar text[] = { 0x61, 0x62, 0x63, 0 };
+    const UChar *patterns[] = { pattern1, pattern2 };
+    UErrorCode status = U_ZERO_ERROR;
+    UMultiStringSearch *msearch;
+    int32_t start, limit;
+    UCollator *coll = ucol_open("", &status);
+    if (U_FAILURE(status)) {
+        log_data_err("ucol_open(root) failed: %s\n", u_errorName(status));
+        return;
+    }
+    ucol_setStrength(coll, UCOL_PRIMARY);
+
+    /* A completely ignorable pattern cannot be matched. */
+    msearch = usearch_openMulti(patterns, NULL, 2, text, -1, coll, NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR || msearch != NULL) {
+        log_err("usearch_openMulti(ignorable pattern) should fail, got %s\n", u_errorName(status));
+    }
+    usearch_closeMulti(msearch);
+
+    status = U_ZERO_ERROR;
+    msearch = usearch_openMulti(patterns, NULL, 0, text, -1, coll, NULL, &status);
+    if (status != U_ILLEGAL_ARGUMENT_ERROR || msearch != NULL) {
+        log_err("usearch_openMulti(no patterns) should fail, got %s\n", u_errorName(status));
+    }
+    usearch_closeMulti(msearch);
+
+    status = U_ZERO_ERROR;
+    msearch = usearch_openMulti(patterns, NULL, 1, text, -1, coll, NULL, &status);
+    if (U_FAILURE(status) ||
+            usearch_nextMulti(msearch, &start, &limit, &status) != 0 || start != 0 || limit != 1 ||
+            usearch_nextMulti(msearch, &start, &limit, &status) != USEARCH_DONE) {
+        log_err("usearch_openMulti(\"a\") failed to find one match: %s\n", u_errorName(status));
+    }
+    usearch_setMultiText(msearch, text + 1, -1, &status);
+    if (U_FAILURE(status) ||
+            usearch_nextMulti(msearch, &start, &limit, &status) != USEARCH_DONE) {
+        log_err("usearch_setMultiText() failed: %s\n", u_errorName(status));
+    }
+    usearch_closeMulti(msearch);
+    ucol_close(coll);
+}
+
 /**
 * addSearchTest
 */
@@ -3068,6 +3238,8 @@ void addSearchTest(TestNode** root)
     addTest(root, &TestPCEBuffer_2surr, "tscoll/usrchtst/TestPCEBuffer/2_dfff");
     addTest(root, &TestMatchFollowedByIgnorables, "tscoll/usrchtst/TestMatchFollowedByIgnorables");
     addTest(root, &TestIndicPrefixMatch, "tscoll/usrchtst/TestIndicPrefixMatch");
+    addTest(root, &TestMultiPattern, "tscoll/usrchtst/TestMultiPattern");
+    addTest(root, &TestMultiPatternErrors, "tscoll/usrchtst/TestMultiPatternErrors");
 }
 
 #endif /* #if !UCONFIG_NO_COLLATION */
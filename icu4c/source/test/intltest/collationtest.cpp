@@ -11,6 +11,8 @@
 * created by: Markus W. Scherer
 */
 
+#include <stdio.h>
+
 #include "unicode/utypes.h"
 
 #if !UCONFIG_NO_COLLATION
@@ -23,6 +25,7 @@
 #include "unicode/std_string.h"
 #include "unicode/strenum.h"
 #include "unicode/tblcoll.h"
+#include "unicode/ucol.h"
 #include "unicode/uiter.h"
 #include "unicode/uniset.h"
 #include "unicode/unistr.h"
@@ -37,6 +40,8 @@
 #include "collationroot.h"
 #include "collationrootelements.h"
 #include "collationruleparser.h"
+#include "collationrulescache.h"
+#include "collationtailoring.h"
 #include "collationweights.h"
 #include "cstring.h"
 #include "intltest.h"
@@ -44,6 +49,7 @@
 #include "ucbuf.h"
 #include "uhash.h"
 #include "uitercollationiterator.h"
+#include "unifiedcache.h"
 #include "utf16collationiterator.h"
 #include "utf8collationiterator.h"
 #include "uvectr32.h"
@@ -76,6 +82,9 @@ class CollationTest : public IntlTest {
     void TestCollationWeights();
     void TestRootElements();
     void TestTailoredElements();
+    void TestFastScripts();
+    void TestIncrementalSortKeys();
+    void TestRulesSnapshots();
     void TestDataDriven();
 
 private:
@@ -146,6 +155,9 @@ void CollationTest::runIndexedTest(int32_t index, UBool exec, const char *&name,
     TESTCASE_AUTO(TestCollationWeights);
     TESTCASE_AUTO(TestRootElements);
     TESTCASE_AUTO(TestTailoredElements);
+    TESTCASE_AUTO(TestFastScripts);
+    TESTCASE_AUTO(TestIncrementalSortKeys);
+    TESTCASE_AUTO(TestRulesSnapshots);
     TESTCASE_AUTO(TestDataDriven);
     TESTCASE_AUTO_END;
 }
@@ -301,16 +313,22 @@ void CollationTest::TestIllegalUTF8() {
         u8"a\uFFFD\uFFFD\uFFFDz", "a\xed\xa0\x80z",  // lead surrogate: would be U+D800
         u8"a\uFFFD\uFFFD\uFFFDz", "a\xed\xbf\xbfz",  // trail surrogate: would be U+DFFF
         u8"a\uFFFD\uFFFD\uFFFD\uFFFDz", "a\xf0\x8f\xbf\xbfz",  // non-shortest form
-        u8"a\uFFFD\uFFFD\uFFFD\uFFFDz", "a\xf4\x90\x80\x80z"  // out of range: would be U+110000
+        u8"a\uFFFD\uFFFD\uFFFD\uFFFDz", "a\xf4\x90\x80\x80z",  // out of range: would be U+110000
+        // ill-formed sequences next to segments that fail the FCD check
+        u8"a\u0301\u0323\uFFFDz", "a\xcc\x81\xcc\xa3\x80z",
+        u8"\uFFFD\u00e1\u0323\uFFFD\u0308", "\xcc\xc3\xa1\xcc\xa3\xcc\xcc\x88"
     };
 
-    for(int32_t i = 0; i < UPRV_LENGTHOF(strings); i += 2) {
-        StringPiece fffd(strings[i]);
-        StringPiece illegal(strings[i + 1]);
-        UCollationResult order = coll->compareUTF8(fffd, illegal, errorCode);
-        if(order != UCOL_EQUAL) {
-            errln("compareUTF8(pair %d: U+FFFD, illegal UTF-8)=%d != UCOL_EQUAL",
-                  (int)i, order);
+    for(int32_t norm = 0; norm <= 1; ++norm) {
+        coll->setAttribute(UCOL_NORMALIZATION_MODE, norm ? UCOL_ON : UCOL_OFF, errorCode);
+        for(int32_t i = 0; i < UPRV_LENGTHOF(strings); i += 2) {
+            StringPiece fffd(strings[i]);
+            StringPiece illegal(strings[i + 1]);
+            UCollationResult order = coll->compareUTF8(fffd, illegal, errorCode);
+            if(order != UCOL_EQUAL) {
+                errln("compareUTF8(pair %d: U+FFFD, illegal UTF-8)=%d != UCOL_EQUAL (normalization %d)",
+                      (int)i, order, (int)norm);
+            }
         }
     }
 }
@@ -942,6 +960,329 @@ void CollationTest::TestTailoredElements() {
     uhash_close(prevLocales);
 }
 
+void CollationTest::TestFastScripts() {
+    // Greek and Cyrillic strings are compared via per-script fast tables
+    // when possible. Check the results against sort key order.
+    IcuTestErrorCode errorCode(*this, "TestFastScripts");
+    static const char *const strings[] = {
+        "", "1", "12", "a", "z", "A-1",
+        u8"α", u8"Α", u8"ά", u8"ά", u8"αβ",
+        u8"α β", u8"α-β", u8"αβ9", u8"σ", u8"ς",
+        u8"Σοφία", u8"σοφια",
+        u8"ωμέγα", u8"ω·", u8"αa",
+        u8"а", u8"А", u8"е", u8"ё", u8"ё", u8"й",
+        u8"й", u8"жз", u8"ж з", u8"ж, з",
+        u8"Москва", u8"москва",
+        u8"москва2", u8"москву10",
+        u8"ґ", u8"є", u8"і", u8"ї", u8"ј", u8"џ",
+        u8"ә", u8"ө", u8"я́", u8"я—", u8"аb",
+        u8"аα", u8"αа", u8"а一", u8"а\U0001F600"
+    };
+    static const char *const locales[] = {
+        "root", "ru", "uk", "bg", "sr", "mk", "be", "kk", "el", "en"
+    };
+    UnicodeString s16[UPRV_LENGTHOF(strings)];
+    for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+        s16[i] = UnicodeString::fromUTF8(strings[i]);
+    }
+    for(int32_t l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        LocalPointer<Collator> localeColl(Collator::createInstance(locales[l], errorCode));
+        if(errorCode.errDataIfFailureAndReset("Collator::createInstance(%s)", locales[l])) {
+            continue;
+        }
+        for(int32_t variant = 0; variant < 5; ++variant) {
+            LocalPointer<Collator> c(localeColl->clone());
+            switch(variant) {
+            case 1:
+                c->setAttribute(UCOL_STRENGTH, UCOL_PRIMARY, errorCode);
+                break;
+            case 2:
+                c->setAttribute(UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, errorCode);
+                break;
+            case 3:
+                c->setAttribute(UCOL_CASE_FIRST, UCOL_UPPER_FIRST, errorCode);
+                break;
+            case 4: {
+                static const int32_t codes[] = { USCRIPT_CYRILLIC, USCRIPT_GREEK, UCOL_REORDER_CODE_DIGIT };
+                c->setReorderCodes(codes, UPRV_LENGTHOF(codes), errorCode);
+                break;
+            }
+            default:
+                break;
+            }
+            if(errorCode.errIfFailureAndReset("%s variant %d: setting attributes", locales[l], (int)variant)) {
+                continue;
+            }
+            CollationKey keys[UPRV_LENGTHOF(strings)];
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                c->getCollationKey(s16[i], keys[i], errorCode);
+            }
+            for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+                for(int32_t j = 0; j < UPRV_LENGTHOF(strings); ++j) {
+                    UCollationResult expected = keys[i].compareTo(keys[j], errorCode);
+                    UCollationResult order16 = c->compare(s16[i], s16[j], errorCode);
+                    UCollationResult order8 = c->compareUTF8(strings[i], strings[j], errorCode);
+                    if(order16 != expected || order8 != expected) {
+                        errln("%s variant %d: strings %d & %d: compare()=%d compareUTF8()=%d "
+                              "but sort keys compare %d",
+                              locales[l], (int)variant, (int)i, (int)j,
+                              order16, order8, expected);
+                    }
+                }
+            }
+            errorCode.errIfFailureAndReset("%s variant %d", locales[l], (int)variant);
+        }
+    }
+}
+
+void CollationTest::TestIncrementalSortKeys() {
+    // The batch sort key functions reuse the state for the prefix that
+    // a string shares with the previous one.
+    // Check their keys against getSortKey() where the shared prefixes end in
+    // contractions, prefix matches, combining marks, digits, variable characters etc.
+    IcuTestErrorCode errorCode(*this, "TestIncrementalSortKeys");
+    static const char *const strings[] = {
+        "", "a", "a", "ab", "abc", "abc/d", "abc/d/e", "abc/d", "abc/x", "abc", "",
+        "usr/lib", "usr/lib/x86_64", "usr/lib/x86_64/libc.so", "usr/lib/x86_64/libc.so.6",
+        "usr/lib/x86_64/libm.so", "usr/local", "usr/local/bin",
+        "item 9", "item 10", "item 100", "item 1000", "item 10a", "item 1-0",
+        "c", "ch", "cha", "chb", "ch", "cz", "l", "ll", "lla", "la",
+        u8"cote", u8"coté", u8"côte", u8"côté", u8"côtés", u8"cô", u8"côte",
+        u8"ậ", u8"ạ", u8"ậ", u8"ậb",
+        u8"￾a", u8"x￾a", u8"x￾b", u8"x￾ab￾c", u8"x￾ab",
+        u8"xé", u8"xé￾éb", u8"xé￾ébè", u8"xé￾ébè", u8"xé￾éc", u8"xé",
+        u8"a b", u8"a  b", u8"a -b", u8"a -", u8"a - c", u8"a-́c",
+        u8"カー", u8"カーキ", u8"カ", u8"キー", u8"キ",
+        u8"เก", u8"เกา", u8"เ", u8"เข",
+        u8"ᄀ", u8"가", u8"각", u8"각", u8"각이",
+        u8"\U0001D15E", u8"\U0001D15E\U0001D15F", u8"\U00020000", u8"\U00020000\U00020001",
+        u8"Å", u8"Å", u8"Åb", u8"Å"
+    };
+    static const char *const locales[] = {
+        "root", "fr_CA", "es@collation=traditional", "sk", "ja", "th", "ko", "da"
+    };
+    const int32_t count = UPRV_LENGTHOF(strings);
+    UnicodeString s16[count];
+    const UChar *p16[count];
+    int32_t lengths16[count];
+    int32_t lengths8[count];
+    for(int32_t i = 0; i < count; ++i) {
+        s16[i] = UnicodeString::fromUTF8(strings[i]);
+        p16[i] = s16[i].getTerminatedBuffer();
+        lengths16[i] = s16[i].length();
+        lengths8[i] = (int32_t)uprv_strlen(strings[i]);
+    }
+    for(int32_t l = 0; l < UPRV_LENGTHOF(locales); ++l) {
+        LocalPointer<Collator> localeColl(Collator::createInstance(locales[l], errorCode));
+        if(errorCode.errDataIfFailureAndReset("Collator::createInstance(%s)", locales[l])) {
+            continue;
+        }
+        for(int32_t variant = 0; variant < 6; ++variant) {
+            LocalPointer<RuleBasedCollator> c(dynamic_cast<RuleBasedCollator *>(localeColl->clone()));
+            switch(variant) {
+            case 1:
+                c->setAttribute(UCOL_ALTERNATE_HANDLING, UCOL_SHIFTED, errorCode);
+                c->setAttribute(UCOL_STRENGTH, UCOL_QUATERNARY, errorCode);
+                break;
+            case 2:
+                c->setAttribute(UCOL_NUMERIC_COLLATION, UCOL_ON, errorCode);
+                break;
+            case 3:
+                c->setAttribute(UCOL_NORMALIZATION_MODE, UCOL_ON, errorCode);
+                c->setAttribute(UCOL_FRENCH_COLLATION, UCOL_ON, errorCode);
+                break;
+            case 4:
+                c->setAttribute(UCOL_CASE_LEVEL, UCOL_ON, errorCode);
+                c->setAttribute(UCOL_CASE_FIRST, UCOL_UPPER_FIRST, errorCode);
+                break;
+            case 5:
+                c->setAttribute(UCOL_STRENGTH, UCOL_IDENTICAL, errorCode);
+                break;
+            default:
+                break;
+            }
+            if(errorCode.errIfFailureAndReset("%s variant %d: setting attributes", locales[l], (int)variant)) {
+                continue;
+            }
+            CharString expected;
+            int32_t expectedOffsets[count + 1];
+            for(int32_t i = 0; i < count; ++i) {
+                uint8_t key[500];
+                int32_t keyLength = c->getSortKey(s16[i], key, UPRV_LENGTHOF(key));
+                expectedOffsets[i] = expected.length();
+                expected.append(reinterpret_cast<const char *>(key), keyLength, errorCode);
+            }
+            expectedOffsets[count] = expected.length();
+            uint8_t keys[20000];
+            int32_t offsets[count + 1];
+            for(int32_t form = 0; form < 3; ++form) {
+                int32_t total;
+                if(form == 0) {
+                    total = c->getSortKeys(p16, lengths16, count, keys, UPRV_LENGTHOF(keys),
+                                           offsets, NULL, NULL, errorCode);
+                } else if(form == 1) {
+                    total = c->getSortKeys(p16, NULL, count, keys, UPRV_LENGTHOF(keys),
+                                           offsets, NULL, NULL, errorCode);
+                } else {
+                    total = c->getSortKeysUTF8(strings, lengths8, count, keys, UPRV_LENGTHOF(keys),
+                                               offsets, NULL, NULL, errorCode);
+                }
+                if(errorCode.errIfFailureAndReset("%s variant %d form %d",
+                                                  locales[l], (int)variant, (int)form)) {
+                    continue;
+                }
+                if(total != expected.length()) {
+                    errln("%s variant %d form %d: total sort key length %d != %d",
+                          locales[l], (int)variant, (int)form, (int)total, (int)expected.length());
+                    continue;
+                }
+                for(int32_t i = 0; i < count; ++i) {
+                    int32_t start = expectedOffsets[i];
+                    int32_t length = expectedOffsets[i + 1] - start;
+                    if(offsets[i] != start || offsets[i + 1] != start + length ||
+                            uprv_memcmp(keys + start, expected.data() + start, length) != 0) {
+                        errln("%s variant %d form %d: string %d: batch sort key differs from getSortKey()",
+                              locales[l], (int)variant, (int)form, (int)i);
+                        infoln(printSortKey(keys + offsets[i], offsets[i + 1] - offsets[i]));
+                        infoln(printSortKey(reinterpret_cast<const uint8_t *>(expected.data()) + start,
+                                            length));
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void CollationTest::TestRulesSnapshots() {
+    // Collators built from the same rules share one cached tailoring.
+    // With a snapshot directory, the tailoring is written to a snapshot file,
+    // and after it has been evicted from the cache, it is loaded from that file.
+#if UCONFIG_NO_FILE_IO
+    logln("Skipping TestRulesSnapshots: UCONFIG_NO_FILE_IO");
+#else
+    IcuTestErrorCode errorCode(*this, "TestRulesSnapshots");
+    static const char *const rules[] = {
+        "&a<<<x<z<<\\u00e4 &[before 1]b<\\u00e6 &c<ch",
+        "[strength 2][reorder Grek]&\\u03b1<q",
+        "[caseFirst upper]",
+        "[reorder Cyrl Latn]",
+        "&b<\\u0301 &\\u00f6<<oe [backwards 2]"
+    };
+    static const char *const strings[] = {
+        "a", "A", "x", "z", "\\u00e4", "\\u00e6", "b", "c", "ch", "cz", "\\u03b1", "q",
+        "\\u0411", "o\\u0301", "\\u00f6", "oe", "co\\u0302te", "c\\u00f4te"
+    };
+    const CollationTailoring *root = CollationRoot::getRoot(errorCode);
+    const UnifiedCache *cache = UnifiedCache::getInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("CollationRoot::getRoot()")) {
+        return;
+    }
+    ucol_setRulesSnapshotDirectory(".", errorCode);
+    for(int32_t r = 0; r < UPRV_LENGTHOF(rules); ++r) {
+        UnicodeString ruleString = UnicodeString(rules[r], -1, US_INV).unescape();
+        CharString path("." U_FILE_SEP_STRING, errorCode);
+        CollationRulesCache::getSnapshotName(root, ruleString, path, errorCode);
+        path.append(".col", errorCode);
+        remove(path.data());
+        cache->flush();
+
+        LocalPointer<RuleBasedCollator> built(new RuleBasedCollator(ruleString, errorCode));
+        LocalPointer<RuleBasedCollator> shared(
+            new RuleBasedCollator(ruleString, Collator::SECONDARY, errorCode));
+        if(errorCode.errIfFailureAndReset("RuleBasedCollator(rules[%d])", (int)r)) {
+            continue;
+        }
+        if(built->getRules().getBuffer() != shared->getRules().getBuffer()) {
+            errln("rules[%d]: collators built from the same rules do not share the tailoring",
+                  (int)r);
+        }
+        assertEquals("shared collator strength", Collator::SECONDARY, shared->getStrength());
+        FILE *f = fopen(path.data(), "rb");
+        if(f == NULL) {
+            errln("rules[%d]: no snapshot file %s", (int)r, path.data());
+            continue;
+        }
+        fclose(f);
+        CharString expected[UPRV_LENGTHOF(strings)];
+        for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+            UnicodeString s = UnicodeString(strings[i], -1, US_INV).unescape();
+            uint8_t key[100];
+            int32_t keyLength = built->getSortKey(s, key, UPRV_LENGTHOF(key));
+            expected[i].append(reinterpret_cast<const char *>(key), keyLength, errorCode);
+        }
+        built.adoptInstead(NULL);
+        shared.adoptInstead(NULL);
+        cache->flush();
+
+        const CollationCacheEntry *entry = CollationRulesCache::getCacheEntry(ruleString, errorCode);
+        if(errorCode.errIfFailureAndReset("rules[%d]: getCacheEntry()", (int)r)) {
+            continue;
+        }
+        if(entry->tailoring->memory == NULL) {
+            errln("rules[%d]: the tailoring was not loaded from its snapshot file", (int)r);
+        }
+        entry->removeRef();
+        LocalPointer<RuleBasedCollator> loaded(new RuleBasedCollator(ruleString, errorCode));
+        if(errorCode.errIfFailureAndReset("rules[%d]: RuleBasedCollator(snapshot)", (int)r)) {
+            continue;
+        }
+        assertEquals("snapshot rules", ruleString, loaded->getRules());
+        for(int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+            UnicodeString s = UnicodeString(strings[i], -1, US_INV).unescape();
+            uint8_t key[100];
+            int32_t keyLength = loaded->getSortKey(s, key, UPRV_LENGTHOF(key));
+            if(keyLength != expected[i].length() ||
+                    uprv_memcmp(key, expected[i].data(), keyLength) != 0) {
+                errln("rules[%d] string %d: snapshot sort key differs from the built one",
+                      (int)r, (int)i);
+            }
+        }
+        loaded.adoptInstead(NULL);
+
+        // A truncated snapshot file is ignored, and the rules are built again.
+        MaybeStackArray<char, 4096> bytes;
+        int32_t fileLength = 0;
+        f = fopen(path.data(), "rb");
+        if(f != NULL) {
+            fseek(f, 0, SEEK_END);
+            fileLength = (int32_t)ftell(f);
+            fseek(f, 0, SEEK_SET);
+            if(bytes.resize(fileLength) == NULL ||
+                    fread(bytes.getAlias(), 1, fileLength, f) != (size_t)fileLength) {
+                fileLength = 0;
+            }
+            fclose(f);
+        }
+        if(fileLength <= 0) {
+            errln("rules[%d]: unable to read snapshot file %s", (int)r, path.data());
+            continue;
+        }
+        int32_t truncatedLengths[] = { fileLength - 2, fileLength / 2 };
+        for(int32_t t = 0; t < UPRV_LENGTHOF(truncatedLengths); ++t) {
+            f = fopen(path.data(), "wb");
+            if(f == NULL) { break; }
+            fwrite(bytes.getAlias(), 1, truncatedLengths[t], f);
+            fclose(f);
+            cache->flush();
+            entry = CollationRulesCache::getCacheEntry(ruleString, errorCode);
+            if(errorCode.errIfFailureAndReset("rules[%d]: getCacheEntry(truncated to %d)",
+                                              (int)r, (int)truncatedLengths[t])) {
+                continue;
+            }
+            if(entry->tailoring->memory != NULL) {
+                errln("rules[%d]: the tailoring was loaded from a snapshot truncated to %d bytes",
+                      (int)r, (int)truncatedLengths[t]);
+            }
+            assertEquals("rebuilt rules", ruleString, entry->tailoring->rules);
+            entry->removeRef();
+        }
+        remove(path.data());
+    }
+    ucol_setRulesSnapshotDirectory(NULL, errorCode);
+#endif  // !UCONFIG_NO_FILE_IO
+}
+
 UnicodeString CollationTest::printSortKey(const uint8_t *p, int32_t length) {
     UnicodeString s;
     for(int32_t i = 0; i < length; ++i) {
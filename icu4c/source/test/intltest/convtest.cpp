@@ -43,6 +43,8 @@
 #include "unicode/tstdtmod.h"
 #include <string.h>
 #include <stdlib.h>
+#include <atomic>
+#include <thread>
 
 enum {
     // characters used in test data for callbacks
@@ -77,6 +79,7 @@ ConversionTest::runIndexedTest(int32_t index, UBool exec, const char *&name, cha
     TESTCASE_AUTO(TestGetUnicodeSet2);
     TESTCASE_AUTO(TestDefaultIgnorableCallback);
     TESTCASE_AUTO(TestUTF8ToUTF8Overflow);
+    TESTCASE_AUTO(TestConvertParallel);
     TESTCASE_AUTO_END;
 }
 
@@ -834,6 +837,184 @@ ConversionTest::TestUTF8ToUTF8Overflow() {
     }
 }
 
+namespace {
+
+// Runs the tasks on a few threads which take the next task index from a shared counter.
+void U_CALLCONV
+runTasksOnThreads(const void *context, UConverterParallelTask *task, void *taskContext, int32_t count) {
+    int32_t numThreads = *static_cast<const int32_t *>(context);
+    std::atomic<int32_t> next(0);
+    std::thread threads[4];
+    for (int32_t t = 0; t < numThreads; ++t) {
+        threads[t] = std::thread([&]() {
+            int32_t i;
+            while ((i = next++) < count) {
+                task(taskContext, i);
+            }
+        });
+    }
+    for (int32_t t = 0; t < numThreads; ++t) {
+        threads[t].join();
+    }
+}
+
+}  // namespace
+
+void
+ConversionTest::TestConvertParallel() {
+    // Includes charsets that must be converted serially.
+    static const char *const charsets[] = {
+        "UTF-8", "UTF-16LE", "UTF-16BE", "UTF-32BE", "UTF-16",
+        "ISO-8859-1", "US-ASCII", "windows-1252", "ibm-1047",
+        "Shift_JIS", "EUC-JP", "windows-936", "GB18030",
+        "ibm-930", "ISO-2022-JP", "UTF-7", "SCSU"
+    };
+    static const int32_t numThreads = 4;
+    IcuTestErrorCode errorCode(*this, "TestConvertParallel");
+    LocalUConverterPointer utf8(ucnv_open("UTF-8", errorCode));
+    LocalUConverterPointer sjis(ucnv_open("Shift_JIS", errorCode));
+    if (errorCode.errIfFailureAndReset("ucnv_open(UTF-8 and Shift_JIS)")) {
+        return;
+    }
+
+    // Mixed text with lines, Japanese, Chinese and supplementary characters.
+    UnicodeString line(u"line 12: Grüße € 日本語のテキスト"
+                       u" 中文 \U00020B9F été\n");
+    UnicodeString text;
+    for (int32_t i = 0; i < 300; ++i) {
+        text.append(line);
+    }
+
+    for (int32_t c = 0; c < UPRV_LENGTHOF(charsets); ++c) {
+        const char *charset = charsets[c];
+        LocalUConverterPointer cnv(ucnv_open(charset, errorCode));
+        if (errorCode.errDataIfFailureAndReset("ucnv_open(%s)", charset)) {
+            continue;
+        }
+        int32_t sourceLength = ucnv_fromUChars(
+            cnv.getAlias(), NULL, 0, text.getBuffer(), text.length(), errorCode);
+        errorCode.reset();
+        LocalArray<char> source(new char[sourceLength + 20]);
+        ucnv_fromUChars(cnv.getAlias(), source.getAlias(), sourceLength + 20,
+                        text.getBuffer(), text.length(), errorCode);
+        // Sprinkle in some bytes that are unassigned or illegal in many charsets.
+        for (int32_t i = 1000; i < sourceLength; i += 1987) {
+            source[i] = (char)0xff;
+            source[i + 1] = (char)0x80;
+        }
+
+        // Expected results from serial conversion.
+        int32_t expectedLength = ucnv_convertParallel(
+            utf8.getAlias(), cnv.getAlias(), NULL, 0, source.getAlias(), sourceLength,
+            0, NULL, NULL, errorCode);
+        errorCode.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+        LocalArray<char> expected(new char[expectedLength + 1]);
+        ucnv_convertParallel(utf8.getAlias(), cnv.getAlias(), expected.getAlias(), expectedLength + 1,
+                             source.getAlias(), sourceLength, 0, NULL, NULL, errorCode);
+        int32_t expected16Length = ucnv_toUChars(
+            cnv.getAlias(), NULL, 0, source.getAlias(), sourceLength, errorCode);
+        errorCode.reset();
+        LocalArray<UChar> expected16(new UChar[expected16Length]);
+        LocalArray<int32_t> expectedOffsets(new int32_t[expected16Length]);
+        UChar *dest = expected16.getAlias();
+        const char *src = source.getAlias();
+        ucnv_resetToUnicode(cnv.getAlias());
+        ucnv_toUnicode(cnv.getAlias(), &dest, dest + expected16Length, &src, src + sourceLength,
+                       expectedOffsets.getAlias(), TRUE, errorCode);
+        if (errorCode.errIfFailureAndReset("%s serial conversion", charset)) {
+            continue;
+        }
+
+        // Small chunks for many split points.
+        for (int32_t chunkLength = 97; chunkLength <= 4000; chunkLength *= 6) {
+            char name[80];
+            sprintf(name, "%s chunk %d", charset, (int)chunkLength);
+            LocalArray<char> result(new char[expectedLength + 1]);
+            int32_t length = ucnv_convertParallel(
+                utf8.getAlias(), cnv.getAlias(), NULL, 0, source.getAlias(), sourceLength,
+                chunkLength, runTasksOnThreads, &numThreads, errorCode);
+            errorCode.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+            assertEquals(UnicodeString(name) + " preflighting", expectedLength, length);
+            length = ucnv_convertParallel(
+                utf8.getAlias(), cnv.getAlias(), result.getAlias(), expectedLength + 1,
+                source.getAlias(), sourceLength,
+                chunkLength, runTasksOnThreads, &numThreads, errorCode);
+            if (!errorCode.errIfFailureAndReset("ucnv_convertParallel(%s to UTF-8)", name) &&
+                    assertEquals(UnicodeString(name) + " to UTF-8 length", expectedLength, length)) {
+                assertTrue(UnicodeString(name) + " to UTF-8 same as serial",
+                           memcmp(expected.getAlias(), result.getAlias(), length) == 0 &&
+                           result[length] == 0);
+            }
+
+            // To a table-based charset.
+            int32_t sjisLength = ucnv_convertParallel(
+                sjis.getAlias(), cnv.getAlias(), NULL, 0, source.getAlias(), sourceLength,
+                0, NULL, NULL, errorCode);
+            errorCode.reset();
+            LocalArray<char> expectedSJIS(new char[sjisLength]);
+            LocalArray<char> resultSJIS(new char[sjisLength]);
+            ucnv_convertParallel(sjis.getAlias(), cnv.getAlias(), expectedSJIS.getAlias(), sjisLength,
+                                 source.getAlias(), sourceLength, 0, NULL, NULL, errorCode);
+            length = ucnv_convertParallel(
+                sjis.getAlias(), cnv.getAlias(), resultSJIS.getAlias(), sjisLength,
+                source.getAlias(), sourceLength,
+                chunkLength, runTasksOnThreads, &numThreads, errorCode);
+            errorCode.expectErrorAndReset(U_STRING_NOT_TERMINATED_WARNING);
+            if (assertEquals(UnicodeString(name) + " to Shift_JIS length", sjisLength, length)) {
+                assertTrue(UnicodeString(name) + " to Shift_JIS same as serial",
+                           memcmp(expectedSJIS.getAlias(), resultSJIS.getAlias(), length) == 0);
+            }
+
+            // To UTF-16 with offsets.
+            LocalArray<UChar> result16(new UChar[expected16Length]);
+            LocalArray<int32_t> offsets(new int32_t[expected16Length]);
+            length = ucnv_toUCharsParallel(
+                cnv.getAlias(), result16.getAlias(), expected16Length, offsets.getAlias(),
+                source.getAlias(), sourceLength,
+                chunkLength, runTasksOnThreads, &numThreads, errorCode);
+            errorCode.expectErrorAndReset(U_STRING_NOT_TERMINATED_WARNING);
+            if (assertEquals(UnicodeString(name) + " to UTF-16 length", expected16Length, length)) {
+                assertTrue(UnicodeString(name) + " to UTF-16 same as serial",
+                           u_memcmp(expected16.getAlias(), result16.getAlias(), length) == 0);
+                assertTrue(UnicodeString(name) + " to UTF-16 offsets same as serial",
+                           memcmp(expectedOffsets.getAlias(), offsets.getAlias(), length * 4) == 0);
+            }
+        }
+    }
+
+    // ibm-16684 maps <U+00E6 U+0300> together to one DBCS character.
+    // The UTF-16 source must not be split between those two code points.
+    // Every chunk of 100 bytes would end right before a U+0300.
+    LocalUConverterPointer utf16le(ucnv_open("UTF-16LE", errorCode));
+    LocalUConverterPointer dbcs(ucnv_open("ibm-16684", errorCode));
+    if (errorCode.errDataIfFailureAndReset("ucnv_open(UTF-16LE and ibm-16684)")) {
+        return;
+    }
+    UnicodeString pairs;
+    for (int32_t i = 0; i < 5000; ++i) {
+        pairs.append(i % 50 == 49 ? (UChar)0xe6 : (i % 50 == 0 && i > 0) ? (UChar)0x300 : (UChar)0x3042);
+    }
+    const char *pairsSource = reinterpret_cast<const char *>(pairs.getBuffer());
+    int32_t pairsSourceLength = pairs.length() * 2;
+    int32_t expectedLength = ucnv_convertParallel(
+        dbcs.getAlias(), utf16le.getAlias(), NULL, 0, pairsSource, pairsSourceLength,
+        0, NULL, NULL, errorCode);
+    errorCode.expectErrorAndReset(U_BUFFER_OVERFLOW_ERROR);
+    LocalArray<char> expected(new char[expectedLength]);
+    LocalArray<char> result(new char[expectedLength]);
+    ucnv_convertParallel(dbcs.getAlias(), utf16le.getAlias(), expected.getAlias(), expectedLength,
+                         pairsSource, pairsSourceLength, 0, NULL, NULL, errorCode);
+    errorCode.expectErrorAndReset(U_STRING_NOT_TERMINATED_WARNING);
+    int32_t length = ucnv_convertParallel(
+        dbcs.getAlias(), utf16le.getAlias(), result.getAlias(), expectedLength,
+        pairsSource, pairsSourceLength, 100, runTasksOnThreads, &numThreads, errorCode);
+    errorCode.expectErrorAndReset(U_STRING_NOT_TERMINATED_WARNING);
+    if (assertEquals("UTF-16LE to ibm-16684 chunk 100 length", expectedLength, length)) {
+        assertTrue("UTF-16LE to ibm-16684 chunk 100 same as serial",
+                   memcmp(expected.getAlias(), result.getAlias(), length) == 0);
+    }
+}
+
 // open testdata or ICU data converter ------------------------------------- ***
 
 UConverter *
@@ -77,6 +77,7 @@ class ConversionTest : public IntlTest {
     void TestGetUnicodeSet2();
     void TestDefaultIgnorableCallback();
     void TestUTF8ToUTF8Overflow();
+    void TestConvertParallel();
 
 private:
     UBool
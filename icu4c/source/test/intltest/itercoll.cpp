@@ -11,6 +11,7 @@
 #if !UCONFIG_NO_COLLATION
 
 #include "unicode/coll.h"
+#include "unicode/localpointer.h"
 #include "unicode/tblcoll.h"
 #include "unicode/unistr.h"
 #include "unicode/sortkey.h"
@@ -632,6 +633,120 @@ void CollationIteratorTest::TestStrengthOrder()
     delete coll;
 }
 
+void CollationIteratorTest::TestNextCEs()
+{
+    static const char *const strings[] = {
+        "", "abc", "This is a test", "change", "\\u00C6sop \\u00E6ther", "a\\u0301\\u0323b",
+        "\\u1100\\u1161\\u11A8\\uAC00", "\\u0E40\\u0E01\\u0E32", "item 123", "\\uD800\\uDC00x",
+        "\\u4E00\\u00E0\\uFFFE\\uFFFFz", "o\\u0308\\u0304ch"
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    RuleBasedCollator tailored("&a < ch < \\u00E4 &Z < \\u00E6 << ae", status);
+    if (U_FAILURE(status)) {
+        errln("Error creating the tailored collator - %s", u_errorName(status));
+        return;
+    }
+    tailored.setAttribute(UCOL_NORMALIZATION_MODE, UCOL_ON, status);
+    LocalPointer<RuleBasedCollator> numeric(static_cast<RuleBasedCollator *>(en_us->clone()));
+    numeric->setAttribute(UCOL_NUMERIC_COLLATION, UCOL_ON, status);
+    const RuleBasedCollator *colls[] = { en_us, &tailored, numeric.getAlias() };
+    for (int32_t c = 0; c < UPRV_LENGTHOF(colls); ++c) {
+        for (int32_t i = 0; i < UPRV_LENGTHOF(strings); ++i) {
+            UnicodeString s = UnicodeString(strings[i], -1, US_INV).unescape();
+            LocalPointer<CollationElementIterator> iter(colls[c]->createCollationElementIterator(s));
+            LocalPointer<CollationElementIterator> single(colls[c]->createCollationElementIterator(s));
+            int64_t ces[100];
+            int32_t offsets[100];
+            int32_t count = iter->nextCEs(-1, ces, offsets, UPRV_LENGTHOF(ces), status);
+            if (U_FAILURE(status)) {
+                errln("nextCEs() failed - %s", u_errorName(status));
+                return;
+            }
+            if (iter->nextCEs(-1, ces, offsets, UPRV_LENGTHOF(ces), status) != 0) {
+                errln("coll %d string %d: nextCEs() did not stop at the end", (int)c, (int)i);
+            }
+            // Each 64-bit CE must match one or two 32-bit orders from next().
+            for (int32_t j = 0; j < count; ++j) {
+                uint32_t p = (uint32_t)(ces[j] >> 32);
+                uint32_t lower32 = (uint32_t)ces[j];
+                int32_t first = (int32_t)((p & 0xffff0000) | ((lower32 >> 16) & 0xff00) |
+                                          ((lower32 >> 8) & 0xff));
+                uint32_t second = (p << 16) | ((lower32 >> 8) & 0xff00) | (lower32 & 0x3f);
+                int32_t order = single->next(status);
+                int32_t offset = single->getOffset();
+                if (order != first || offset != offsets[j]) {
+                    errln("coll %d string %d CE %d: next()=%08x at %d but nextCEs()=%08x at %d",
+                          (int)c, (int)i, (int)j, order, offset, first, offsets[j]);
+                    break;
+                }
+                if (second != 0) {
+                    order = single->next(status);
+                    if (order != (int32_t)(second | 0xc0)) {
+                        errln("coll %d string %d CE %d: continuation mismatch", (int)c, (int)i, (int)j);
+                        break;
+                    }
+                }
+            }
+            if (single->next(status) != CollationElementIterator::NULLORDER) {
+                errln("coll %d string %d: nextCEs() returned fewer CEs than next()", (int)c, (int)i);
+            }
+
+            // One CE at a time, and stopping at a limit offset.
+            for (int32_t limit = 0; limit <= s.length(); ++limit) {
+                iter->reset();
+                int64_t partCEs[100];
+                int32_t partOffsets[100];
+                int32_t length = 0;
+                int32_t n;
+                while ((n = iter->nextCEs(limit, partCEs + length, partOffsets + length,
+                                          1, status)) > 0) {
+                    length += n;
+                }
+                int32_t limitLength = length;
+                int32_t lastOffset = length == 0 ? 0 : partOffsets[length - 1];
+                // The text for each CE starts at the offset of the previous CE
+                // with a different offset.
+                int32_t start = 0;
+                for (int32_t j = 0; j < limitLength; ++j) {
+                    if (j > 0 && partOffsets[j] != partOffsets[j - 1]) {
+                        start = partOffsets[j - 1];
+                    }
+                    if (start >= limit) {
+                        errln("coll %d string %d limit %d: nextCEs() went past the limit",
+                              (int)c, (int)i, (int)limit);
+                        break;
+                    }
+                }
+                length += iter->nextCEs(-1, partCEs + length, partOffsets + length,
+                                        UPRV_LENGTHOF(partCEs) - length, status);
+                if (U_FAILURE(status)) {
+                    errln("nextCEs(limit) failed - %s", u_errorName(status));
+                    return;
+                }
+                if (length != count ||
+                        uprv_memcmp(partCEs, ces, count * 8) != 0 ||
+                        uprv_memcmp(partOffsets, offsets, count * 4) != 0) {
+                    errln("coll %d string %d limit %d: piecewise nextCEs() differ",
+                          (int)c, (int)i, (int)limit);
+                }
+                if (limitLength < count && lastOffset < limit) {
+                    errln("coll %d string %d limit %d: nextCEs() stopped before the limit",
+                          (int)c, (int)i, (int)limit);
+                }
+            }
+
+            // Mixing directions is an error.
+            iter->reset();
+            iter->previous(status);
+            iter->nextCEs(-1, ces, offsets, UPRV_LENGTHOF(ces), status);
+            if (status != U_INVALID_STATE_ERROR) {
+                errln("nextCEs() after previous() did not fail");
+            }
+            status = U_ZERO_ERROR;
+        }
+    }
+}
+
 /**
  * Return a string containing all of the collation orders
  * returned by calls to next on the specified iterator
@@ -691,6 +806,7 @@ void CollationIteratorTest::runIndexedTest(int32_t index, UBool exec, const char
           case  6: name = "TestAssignment";    if (exec) TestAssignment(/* par */);    break;
           case  7: name = "TestConstructors";  if (exec) TestConstructors(/* par */); break;
           case  8: name = "TestStrengthOrder"; if (exec) TestStrengthOrder(/* par */); break;
+          case  9: name = "TestNextCEs";       if (exec) TestNextCEs(/* par */);       break;
           default: name = ""; break;
       }
     } else {
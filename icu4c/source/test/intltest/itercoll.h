@@ -84,6 +84,11 @@ class CollationIteratorTest: public IntlTestCollator
     * Testing the strength order functionality
     */
     void TestStrengthOrder();
+
+    /**
+    * Testing nextCEs() against next() and getOffset()
+    */
+    void TestNextCEs();
     
     //------------------------------------------------------------------------
     // Internal utilities
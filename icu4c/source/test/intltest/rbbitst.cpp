@@ -42,6 +42,7 @@
 #include "intltest.h"
 #include "rbbitst.h"
 #include "rbbidata.h"
+#include "simplethread.h"
 #include "utypeinfo.h"  // for 'typeid' to work
 #include "uvector.h"
 #include "uvectr32.h"
@@ -114,6 +115,9 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
     TESTCASE_AUTO(TestBug13447);
     TESTCASE_AUTO(TestReverse);
     TESTCASE_AUTO(TestBug13692);
+    TESTCASE_AUTO(TestUTF8Text);
+    TESTCASE_AUTO(TestNextBoundaries);
+    TESTCASE_AUTO(TestChunkedSegmentation);
     TESTCASE_AUTO_END;
 }
 
@@ -126,6 +130,7 @@ void RBBITest::runIndexedTest( int32_t index, UBool exec, const char* &name, cha
 
 RBBITest::RBBITest() {
     fTestParams = NULL;
+    fSegmentation = NULL;
 }
 
 
@@ -4640,6 +4645,313 @@ void RBBITest::TestBug13692() {
     assertSuccess(WHERE, status);
 }
 
+//
+//  TestUTF8Text    Break iteration over UTF-8 text reads the bytes directly,
+//                  and must give the same boundaries as for the equivalent UTF-16 text,
+//                  with ill-formed sequences treated as U+FFFD.
+//
+void RBBITest::TestUTF8Text() {
+    static const char *const texts[] = {
+        "Hello, world! It's 3.14 o'clock. Don't panic.\r\nNew line: \xE2\x80\x9Cquoted\xE2\x80\x9D?",
+        "\xE0\xB8\x81\xE0\xB8\xB2\xE0\xB8\xA3\xE0\xB8\x97\xE0\xB8\x94\xE0\xB8\xAA\xE0\xB8\xAD\xE0\xB8\x9A "
+            "abc \xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xA7\xE3\x81\x99\xE3\x80\x82 "
+            "e\xCC\x81t\xC3\xA9 \xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9 \xF0\x9F\x87\xA9\xF0\x9F\x87\xAA",
+        // Ill-formed sequences: lone trail bytes, truncated sequences, surrogates, overlong forms.
+        "ab\x80 c\xE0\xB8 d\xED\xA0\x80 e\xC0\xAF f\xF0\x9F\x91 g\xFF. Next\xC3",
+    };
+    UErrorCode status = U_ZERO_ERROR;
+    const Locale &locale = Locale::getEnglish();
+    LocalPointer<BreakIterator> iters[4] = {
+        LocalPointer<BreakIterator>(BreakIterator::createCharacterInstance(locale, status)),
+        LocalPointer<BreakIterator>(BreakIterator::createWordInstance(locale, status)),
+        LocalPointer<BreakIterator>(BreakIterator::createLineInstance(locale, status)),
+        LocalPointer<BreakIterator>(BreakIterator::createSentenceInstance(locale, status))
+    };
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    for (int32_t t = 0; t < UPRV_LENGTHOF(texts); ++t) {
+        const char *s8 = texts[t];
+        int32_t length8 = (int32_t)strlen(s8);
+        // Convert to UTF-16 with U+FFFD substitution, and map the UTF-16 indexes to UTF-8.
+        UnicodeString s16;
+        std::vector<int32_t> map16To8;
+        for (int32_t i = 0; i < length8;) {
+            int32_t start = i;
+            UChar32 c;
+            U8_NEXT_OR_FFFD(s8, i, length8, c);
+            s16.append(c);
+            while (map16To8.size() < (size_t)s16.length()) {
+                map16To8.push_back(start);
+            }
+        }
+        map16To8.push_back(length8);
+
+        for (int32_t b = 0; b < UPRV_LENGTHOF(iters); ++b) {
+            BreakIterator &bi = *iters[b];
+            std::vector<int32_t> expected, expectedStatus;
+            bi.setText(s16);
+            for (int32_t p = bi.first(); p != BreakIterator::DONE; p = bi.next()) {
+                expected.push_back(map16To8[p]);
+                expectedStatus.push_back(bi.getRuleStatus());
+            }
+
+            LocalUTextPointer ut(utext_openUTF8(NULL, s8, t == 0 ? -1 : length8, &status));
+            bi.setText(ut.getAlias(), status);
+            if (!assertSuccess(WHERE, status)) {
+                return;
+            }
+            size_t n = 0;
+            for (int32_t p = bi.first(); p != BreakIterator::DONE; p = bi.next(), ++n) {
+                if (n >= expected.size() || p != expected[n] || bi.getRuleStatus() != expectedStatus[n]) {
+                    errln("%s:%d text %d iterator %d: boundary #%d at %d status %d, expected %d status %d",
+                          __FILE__, __LINE__, (int)t, (int)b, (int)n, (int)p, (int)bi.getRuleStatus(),
+                          n < expected.size() ? (int)expected[n] : -1,
+                          n < expected.size() ? (int)expectedStatus[n] : -1);
+                    break;
+                }
+            }
+            assertEquals(WHERE, (int32_t)expected.size(), (int32_t)n);
+
+            // Reverse iteration, and random access via the safe reverse rules.
+            n = expected.size();
+            for (int32_t p = bi.last(); p != BreakIterator::DONE; p = bi.previous()) {
+                if (n == 0 || p != expected[--n]) {
+                    errln("%s:%d text %d iterator %d: previous() boundary %d not expected",
+                          __FILE__, __LINE__, (int)t, (int)b, (int)p);
+                    break;
+                }
+            }
+            for (int32_t i = 0; i < length8; ++i) {
+                size_t k = 0;
+                while (expected[k] <= i) { ++k; }
+                if (bi.following(i) != expected[k]) {
+                    errln("%s:%d text %d iterator %d: following(%d) = %d expected %d",
+                          __FILE__, __LINE__, (int)t, (int)b, (int)i, (int)bi.current(), (int)expected[k]);
+                }
+            }
+        }
+    }
+}
+
+//
+//  TestNextBoundaries    Bulk boundary extraction must match iteration with next(),
+//                        including dictionary subdivided segments, and must
+//                        leave the iterator at the last boundary returned.
+//
+void RBBITest::TestNextBoundaries() {
+    UnicodeString text(
+        u"Hello, world! It's 3.14 o'clock. "
+        u"\u0e01\u0e32\u0e23\u0e17\u0e14\u0e2a\u0e2d\u0e1a\u0e20\u0e32\u0e29\u0e32\u0e44\u0e17\u0e22 "
+        u"abc \u65e5\u672c\u8a9e\u3067\u3059\u3002 Don't panic.\r\nNew line: \u201cquoted\u201d? ");
+    text.append(text);
+    UErrorCode status = U_ZERO_ERROR;
+    const Locale &locale = Locale::getEnglish();
+    LocalPointer<RuleBasedBreakIterator> iters[4] = {
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createCharacterInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createWordInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createLineInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createSentenceInstance(locale, status))
+    };
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    for (int32_t b = 0; b < UPRV_LENGTHOF(iters); ++b) {
+        RuleBasedBreakIterator &bi = *iters[b];
+        bi.setText(text);
+        std::vector<int32_t> expected, expectedStatus;
+        for (int32_t p = bi.first(); p != BreakIterator::DONE; p = bi.next()) {
+            expected.push_back(p);
+            expectedStatus.push_back(bi.getRuleStatus());
+        }
+        int32_t count = (int32_t)expected.size();
+
+        // All boundaries at once, from a freshly set text.
+        bi.setText(text);
+        std::vector<int32_t> boundaries(count + 1), statuses(count + 1);
+        int32_t length = bi.nextBoundaries(INT32_MAX, boundaries.data(), statuses.data(),
+                                           count + 1, status);
+        assertSuccess(WHERE, status);
+        assertEquals(WHERE, count - 1, length);
+        for (int32_t i = 0; i < length && i + 1 < count; ++i) {
+            if (boundaries[i] != expected[i + 1] || statuses[i] != expectedStatus[i + 1]) {
+                errln("%s:%d iterator %d: boundary #%d at %d status %d, expected %d status %d",
+                      __FILE__, __LINE__, (int)b, (int)i, (int)boundaries[i], (int)statuses[i],
+                      (int)expected[i + 1], (int)expectedStatus[i + 1]);
+                break;
+            }
+        }
+        assertEquals(WHERE, text.length(), bi.current());
+        assertEquals(WHERE, 0, bi.nextBoundaries(INT32_MAX, boundaries.data(), NULL, count + 1, status));
+        assertEquals(WHERE, BreakIterator::DONE, bi.next());
+
+        // Small pieces, interleaved with next() and previous() which must see
+        // the iterator at the last boundary returned.
+        bi.first();
+        int32_t n = 1;
+        while (n < count) {
+            int32_t piece[3], pieceStatus[3];
+            length = bi.nextBoundaries(INT32_MAX, piece, pieceStatus, UPRV_LENGTHOF(piece), status);
+            if (length == 0) {
+                errln("%s:%d iterator %d: no boundaries after %d", __FILE__, __LINE__,
+                      (int)b, (int)bi.current());
+                break;
+            }
+            for (int32_t i = 0; i < length; ++i, ++n) {
+                if (n >= count || piece[i] != expected[n] || pieceStatus[i] != expectedStatus[n]) {
+                    errln("%s:%d iterator %d: piecewise boundary #%d at %d, expected %d",
+                          __FILE__, __LINE__, (int)b, (int)n, (int)piece[i],
+                          n < count ? (int)expected[n] : -1);
+                    return;
+                }
+            }
+            assertEquals(WHERE, expected[n - 1], bi.current());
+            assertEquals(WHERE, expectedStatus[n - 1], bi.getRuleStatus());
+            if ((n % 2) == 0 && n < count) {
+                assertEquals(WHERE, expected[n - 2], bi.previous());
+                assertEquals(WHERE, expected[n - 1], bi.next());
+            } else if (n < count) {
+                assertEquals(WHERE, expected[n], bi.next());
+                ++n;
+            }
+        }
+
+        // Starting from arbitrary positions, up to arbitrary limits.
+        for (int32_t start = 0; start < text.length(); start += 7) {
+            int32_t limit = start + 13;
+            int32_t first = bi.following(start);
+            int32_t k = 0;
+            while (expected[k] <= first) { ++k; }
+            length = bi.nextBoundaries(limit, boundaries.data(), NULL, count + 1, status);
+            for (int32_t i = 0; i < length; ++i, ++k) {
+                if (k >= count || boundaries[i] != expected[k] || boundaries[i] > limit) {
+                    errln("%s:%d iterator %d: from %d to limit %d boundary #%d at %d not expected",
+                          __FILE__, __LINE__, (int)b, (int)first, (int)limit, (int)i,
+                          (int)boundaries[i]);
+                    break;
+                }
+            }
+            if (k < count && expected[k] <= limit) {
+                errln("%s:%d iterator %d: from %d to limit %d missing boundary %d",
+                      __FILE__, __LINE__, (int)b, (int)first, (int)limit, (int)expected[k]);
+            }
+            assertEquals(WHERE, length > 0 ? boundaries[length - 1] : first, bi.current());
+        }
+    }
+
+    int32_t boundary;
+    iters[0]->nextBoundaries(INT32_MAX, &boundary, NULL, -1, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
+//
+//  TestChunkedSegmentation    Segmenting a long text in chunks on multiple threads
+//                             must give the same boundaries as serial iteration.
+//
+void RBBITest::segmentChunkThread(int32_t chunkIndex) {
+    UErrorCode status = U_ZERO_ERROR;
+    fSegmentation->segmentChunk(chunkIndex, status);
+    assertSuccess(WHERE, status);
+}
+
+void RBBITest::TestChunkedSegmentation() {
+    static const UChar *const pieces[] = {
+        u"Hello, world! ", u"It's 3.14 o'clock. ", u"Mr. Smith went home.\r\n", u"\r\n\r\n",
+        u"\u0e01\u0e32\u0e23\u0e17\u0e14\u0e2a\u0e2d\u0e1a\u0e20\u0e32\u0e29\u0e32\u0e44\u0e17\u0e22",
+        u"\u0e2a\u0e27\u0e31\u0e2a\u0e14\u0e35\u0e04\u0e23\u0e31\u0e1a ",
+        u"\u65e5\u672c\u8a9e\u3067\u3059\u3002", u"\u4e2d\u6587\u5b57\u7b26",
+        u"(\"quoted\") ", u"e\u0301t\u00e9 ", u"\U0001F468\u200D\U0001F469 ", u"     ", u"1,234.5-"
+    };
+    // A long text with pseudo-random content, so that chunk starts fall into all kinds of contexts.
+    UnicodeString text;
+    uint32_t seed = 1;
+    while (text.length() < 200000) {
+        seed = seed * 1103515245 + 12345;
+        text.append(pieces[(seed >> 16) % UPRV_LENGTHOF(pieces)]);
+    }
+
+    UErrorCode status = U_ZERO_ERROR;
+    const Locale &locale = Locale::getEnglish();
+    LocalPointer<RuleBasedBreakIterator> iters[4] = {
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createCharacterInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createWordInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createLineInstance(locale, status)),
+        LocalPointer<RuleBasedBreakIterator>(
+            (RuleBasedBreakIterator *)BreakIterator::createSentenceInstance(locale, status))
+    };
+    if (!assertSuccess(WHERE, status, true)) {
+        return;
+    }
+    static const int32_t chunkCounts[] = { 1, 2, 5, 12 };
+    for (int32_t b = 0; b < UPRV_LENGTHOF(iters); ++b) {
+        RuleBasedBreakIterator &bi = *iters[b];
+        bi.setText(text);
+        std::vector<int32_t> expected, expectedStatus;
+        for (int32_t p = bi.first(); p != BreakIterator::DONE; p = bi.next()) {
+            expected.push_back(p);
+            expectedStatus.push_back(bi.getRuleStatus());
+        }
+        int32_t count = (int32_t)expected.size();
+
+        for (int32_t c = 0; c < UPRV_LENGTHOF(chunkCounts); ++c) {
+            ChunkedSegmentation segmentation(bi, chunkCounts[c], status);
+            if (!assertSuccess(WHERE, status)) {
+                return;
+            }
+            int32_t chunkCount = segmentation.getChunkCount();
+            assertTrue(WHERE, 1 <= chunkCount && chunkCount <= chunkCounts[c]);
+            assertTrue(WHERE, chunkCounts[c] == 1 || chunkCount > 1);
+            if (chunkCount > 1) {
+                // Not all of the chunks have been segmented yet.
+                UErrorCode errorCode = U_ZERO_ERROR;
+                segmentation.getBoundaries(NULL, NULL, 0, errorCode);
+                assertEquals(WHERE, U_INVALID_STATE_ERROR, errorCode);
+            }
+            fSegmentation = &segmentation;
+            ThreadPool<RBBITest> threads(this, chunkCount, &RBBITest::segmentChunkThread);
+            threads.start();
+            threads.join();
+            fSegmentation = NULL;
+
+            // Preflight, then get the boundaries.
+            assertEquals(WHERE, count, segmentation.getBoundaries(NULL, NULL, 0, status));
+            assertEquals(WHERE, U_BUFFER_OVERFLOW_ERROR, status);
+            status = U_ZERO_ERROR;
+            std::vector<int32_t> boundaries(count), statuses(count);
+            int32_t length = segmentation.getBoundaries(boundaries.data(), statuses.data(), count, status);
+            assertSuccess(WHERE, status);
+            assertEquals(WHERE, count, length);
+            for (int32_t i = 0; i < length && i < count; ++i) {
+                if (boundaries[i] != expected[i] || statuses[i] != expectedStatus[i]) {
+                    errln("%s:%d iterator %d, %d chunks: boundary #%d at %d status %d, expected %d status %d",
+                          __FILE__, __LINE__, (int)b, (int)chunkCount, (int)i, (int)boundaries[i],
+                          (int)statuses[i], (int)expected[i], (int)expectedStatus[i]);
+                    break;
+                }
+            }
+        }
+    }
+
+    // A short text is not divided.
+    UnicodeString shortText(u"Short text.");
+    iters[1]->setText(shortText);
+    ChunkedSegmentation segmentation(*iters[1], 8, status);
+    assertEquals(WHERE, 1, segmentation.getChunkCount());
+    segmentation.segmentChunk(0, status);
+    int32_t boundaries[10];
+    assertEquals(WHERE, 5, segmentation.getBoundaries(boundaries, NULL, UPRV_LENGTHOF(boundaries), status));
+    assertSuccess(WHERE, status);
+    segmentation.segmentChunk(1, status);
+    assertEquals(WHERE, U_ILLEGAL_ARGUMENT_ERROR, status);
+}
+
 //
 //  TestDebug    -  A place-holder test for debugging purposes.
 //                  For putting in fragments of other tests that can be invoked
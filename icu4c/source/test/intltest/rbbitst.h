@@ -82,6 +82,10 @@ class RBBITest: public IntlTest {
     void TestReverse();
     void TestReverse(std::unique_ptr<RuleBasedBreakIterator>bi);
     void TestBug13692();
+    void TestUTF8Text();
+    void TestNextBoundaries();
+    void TestChunkedSegmentation();
+    void segmentChunkThread(int32_t chunkIndex);
 
     void TestDebug();
     void TestProperties();
@@ -119,6 +123,9 @@ class RBBITest: public IntlTest {
 
     // Test parameters, from the test framework and test invocation.
     const char* fTestParams;
+
+    // The segmentation shared by the threads of TestChunkedSegmentation().
+    ChunkedSegmentation *fSegmentation;
 };
 
 #endif /* #if !UCONFIG_NO_BREAK_ITERATION */
@@ -25,6 +25,7 @@
 #include "tsmthred.h"
 #include "unicode/ushape.h"
 #include "unicode/translit.h"
+#include "unicode/ucnv.h"
 #include "sharedobject.h"
 #include "unifiedcache.h"
 #include "uassert.h"
@@ -75,6 +76,9 @@ void MultithreadTest::runIndexedTest( int32_t index, UBool exec,
 #if !UCONFIG_NO_TRANSLITERATION
     TESTCASE_AUTO(TestBreakTranslit);
     TESTCASE_AUTO(TestIncDec);
+#if !UCONFIG_NO_CONVERSION
+    TESTCASE_AUTO(TestConverterCache);
+#endif
 #if !UCONFIG_NO_FORMATTING
     TESTCASE_AUTO(Test20104);
 #endif /* #if !UCONFIG_NO_FORMATTING */
@@ -1333,6 +1337,93 @@ void MultithreadTest::TestIncDec()
     assertEquals(WHERE, NUM_THREADS, gIncDecCounter);
 }
 
+#if !UCONFIG_NO_CONVERSION
+//-------------------------------------------------------------------------------------------
+//
+//  TestConverterCache  Concurrent ucnv_open(), ucnv_safeClone() and ucnv_close() of converters
+//                      whose shared data is cached, while another thread flushes the cache.
+//
+//-------------------------------------------------------------------------------------------
+
+static const char *const gCacheTestCharsets[] = {
+    "ibm-1047", "windows-1252", "Shift_JIS", "GB18030", "EUC-KR", "ibm-1390"
+};
+
+static const UChar gCacheTestText[] = { 0x41, 0x20ac, 0x62 };
+static char gCacheTestExpected[UPRV_LENGTHOF(gCacheTestCharsets)][16];
+static int32_t gCacheTestExpectedLengths[UPRV_LENGTHOF(gCacheTestCharsets)];
+
+static u_atomic_int32_t gCacheTestErrors;
+static u_atomic_int32_t gCacheTestRunning;
+
+class ConverterCacheThread : public SimpleThread {
+public:
+    ConverterCacheThread(int32_t offset) : fOffset(offset) {}
+    virtual void run();
+private:
+    int32_t fOffset;
+};
+
+void ConverterCacheThread::run() {
+    for (int32_t i = 0; i < 10000; ++i) {
+        UErrorCode status = U_ZERO_ERROR;
+        int32_t cs = (i + fOffset) % UPRV_LENGTHOF(gCacheTestCharsets);
+        UConverter *cnv = ucnv_open(gCacheTestCharsets[cs], &status);
+        UConverter *clone = ucnv_safeClone(cnv, NULL, NULL, &status);
+        ucnv_close(cnv);
+        char bytes[16];
+        int32_t length = ucnv_fromUChars(clone, bytes, UPRV_LENGTHOF(bytes),
+                                         gCacheTestText, UPRV_LENGTHOF(gCacheTestText), &status);
+        if (U_FAILURE(status) || length != gCacheTestExpectedLengths[cs] ||
+                uprv_memcmp(bytes, gCacheTestExpected[cs], length) != 0) {
+            umtx_atomic_inc(&gCacheTestErrors);
+        }
+        ucnv_close(clone);
+    }
+    umtx_atomic_dec(&gCacheTestRunning);
+}
+
+class ConverterFlushThread : public SimpleThread {
+public:
+    virtual void run() {
+        while (umtx_loadAcquire(gCacheTestRunning) > 0) {
+            ucnv_flushCache();
+        }
+    }
+};
+
+void MultithreadTest::TestConverterCache() {
+    static constexpr int NUM_THREADS = 6;
+    for (int32_t cs = 0; cs < UPRV_LENGTHOF(gCacheTestCharsets); ++cs) {
+        UErrorCode status = U_ZERO_ERROR;
+        gCacheTestExpectedLengths[cs] = ucnv_convert(
+            gCacheTestCharsets[cs], "UTF-16LE", gCacheTestExpected[cs], UPRV_LENGTHOF(gCacheTestExpected[cs]),
+            (const char *)gCacheTestText, (int32_t)sizeof(gCacheTestText), &status);
+        if (U_FAILURE(status)) {
+            dataerrln("%s: unable to convert to %s - %s", WHERE, gCacheTestCharsets[cs], u_errorName(status));
+            return;
+        }
+    }
+    gCacheTestErrors = 0;
+    gCacheTestRunning = NUM_THREADS;
+    ConverterCacheThread *threads[NUM_THREADS];
+    for (int32_t i = 0; i < NUM_THREADS; ++i) {
+        threads[i] = new ConverterCacheThread(i);
+    }
+    ConverterFlushThread flushThread;
+    flushThread.start();
+    for (auto thread:threads) {
+        thread->start();
+    }
+    for (auto thread:threads) {
+        thread->join();
+        delete thread;
+    }
+    flushThread.join();
+    assertEquals(WHERE, 0, gCacheTestErrors);
+}
+#endif /* !UCONFIG_NO_CONVERSION */
+
 #if !UCONFIG_NO_FORMATTING
 static Calendar  *gSharedCalendar = {};
 
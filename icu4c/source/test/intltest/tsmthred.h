@@ -48,6 +48,7 @@ class MultithreadTest : public IntlTest
     void TestUnifiedCache();
     void TestBreakTranslit();
     void TestIncDec();
+    void TestConverterCache();
     void Test20104();
 };
 
@@ -10,6 +10,7 @@
 
 #if !UCONFIG_NO_NORMALIZATION
 
+#include "unicode/appendable.h"
 #include "unicode/uchar.h"
 #include "unicode/errorcode.h"
 #include "unicode/normlzr.h"
@@ -60,6 +61,8 @@ void BasicNormalizerTest::runIndexedTest(int32_t index, UBool exec,
     TESTCASE_AUTO(TestNormalizeIllFormedText);
     TESTCASE_AUTO(TestComposeJamoTBase);
     TESTCASE_AUTO(TestComposeBoundaryAfter);
+    TESTCASE_AUTO(TestLongLowPrefix);
+    TESTCASE_AUTO(TestStreamingNormalizer);
     TESTCASE_AUTO_END;
 }
 
@@ -1805,4 +1808,130 @@ BasicNormalizerTest::TestComposeBoundaryAfter() {
     assertFalse("U+FB2C boundary-after", nfkc->hasBoundaryAfter(0xFB2C));
 }
 
+void
+BasicNormalizerTest::TestLongLowPrefix() {
+    // The fast paths skip blocks of low code units at a time.
+    // Put a character that needs normalization at various offsets across block boundaries.
+    IcuTestErrorCode errorCode(*this, "TestLongLowPrefix");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFC/NFDInstance() call failed")) {
+        return;
+    }
+    for(int32_t prefixLength = 0; prefixLength < 40; ++prefixLength) {
+        UnicodeString prefix;
+        for(int32_t i = 0; i < prefixLength; ++i) {
+            prefix.append((UChar)(u'a' + i % 26));
+        }
+        UnicodeString suffix(u"bcdefghijklmnopqrstu");
+        UnicodeString decomposed = prefix + u"e\u0301" + suffix;
+        UnicodeString composed = prefix + u"\u00E9" + suffix;
+        char name[32];
+        sprintf(name, "prefix length %d", (int)prefixLength);
+        assertEquals(UnicodeString("NFC ") + name, composed, nfc->normalize(decomposed, errorCode));
+        assertEquals(UnicodeString("NFD ") + name, decomposed, nfd->normalize(composed, errorCode));
+        assertFalse(UnicodeString("NFC.isNormalized(decomposed) ") + name,
+                    nfc->isNormalized(decomposed, errorCode));
+        assertTrue(UnicodeString("NFC.isNormalized(composed) ") + name,
+                   nfc->isNormalized(composed, errorCode));
+        assertFalse(UnicodeString("NFD.isNormalized(composed) ") + name,
+                    nfd->isNormalized(composed, errorCode));
+        assertEquals(UnicodeString("NFC.spanQuickCheckYes ") + name,
+                     prefixLength, nfc->spanQuickCheckYes(decomposed, errorCode));
+        assertEquals(UnicodeString("NFD.spanQuickCheckYes ") + name,
+                     prefixLength, nfd->spanQuickCheckYes(composed, errorCode));
+
+        std::string decomposed8, composed8, result8;
+        decomposed.toUTF8String(decomposed8);
+        composed.toUTF8String(composed8);
+        StringByteSink<std::string> sink(&result8);
+        nfc->normalizeUTF8(0, decomposed8, sink, nullptr, errorCode);
+        assertEquals(UnicodeString("NFC UTF-8 ") + name, composed8.c_str(), result8.c_str());
+        assertFalse(UnicodeString("NFC.isNormalizedUTF8(decomposed) ") + name,
+                    nfc->isNormalizedUTF8(decomposed8, errorCode));
+        assertTrue(UnicodeString("NFC.isNormalizedUTF8(composed) ") + name,
+                   nfc->isNormalizedUTF8(composed8, errorCode));
+        assertSuccess(name, errorCode.get());
+    }
+}
+
+void
+BasicNormalizerTest::TestStreamingNormalizer() {
+    IcuTestErrorCode errorCode(*this, "TestStreamingNormalizer");
+    const Normalizer2 *nfc = Normalizer2::getNFCInstance(errorCode);
+    const Normalizer2 *nfd = Normalizer2::getNFDInstance(errorCode);
+    const Normalizer2 *nfkc = Normalizer2::getNFKCInstance(errorCode);
+    if(errorCode.errDataIfFailureAndReset("Normalizer2::getNFC/NFD/NFKCInstance() call failed")) {
+        return;
+    }
+    const Normalizer2 *normalizers[] = { nfc, nfd, nfkc };
+    const char *names[] = { "NFC", "NFD", "NFKC" };
+    // Combining sequences, Hangul, a supplementary character with a mark,
+    // a reordering case and some characters with compatibility mappings.
+    UnicodeString text = UnicodeString(
+        u"abc e\u0301\u0323 \u1100\u1161\u11A8 \uAC00\u11A8 "
+        u"\U0001D15E\u0301 \u0041\u0327\u030A x\u0302\u0323\u0302 "
+        u"\uFB2C\u05B6 \u00C5ffi\uFB01 \u1E9B\u0323 z\u0308").unescape();
+    std::string text8;
+    text.toUTF8String(text8);
+    // Ill-formed UTF-8 in the middle, and truncated at the end.
+    text8.insert(7, "\xCC");
+    text8.append("q\xE1\x84");
+    for(int32_t n = 0; n < UPRV_LENGTHOF(normalizers); ++n) {
+        const Normalizer2 &norm2 = *normalizers[n];
+        UnicodeString expected = norm2.normalize(text, errorCode);
+        std::string expected8;
+        StringByteSink<std::string> expectedSink(&expected8);
+        norm2.normalizeUTF8(0, text8, expectedSink, nullptr, errorCode);
+        StreamingNormalizer stream(norm2);
+        for(int32_t chunkLength = 1; chunkLength <= 9; ++chunkLength) {
+            UnicodeString result;
+            UnicodeStringAppendable appendable(result);
+            for(int32_t start = 0; start < text.length(); start += chunkLength) {
+                stream.append(text.tempSubString(start, chunkLength), appendable, errorCode);
+            }
+            stream.finish(appendable, errorCode);
+            char msg[64];
+            sprintf(msg, "%s chunks of %d UTF-16 units", names[n], (int)chunkLength);
+            assertEquals(msg, expected, result);
+
+            std::string result8;
+            StringByteSink<std::string> sink(&result8);
+            for(int32_t start = 0; start < (int32_t)text8.length(); start += chunkLength) {
+                stream.appendUTF8(StringPiece(text8).substr(start, chunkLength), sink, errorCode);
+            }
+            stream.finishUTF8(sink, errorCode);
+            sprintf(msg, "%s chunks of %d UTF-8 bytes", names[n], (int)chunkLength);
+            assertTrue(msg, expected8 == result8);
+            assertSuccess(msg, errorCode.get());
+        }
+    }
+
+    // UTF-8 and UTF-16 cannot be mixed while text is pending.
+    StreamingNormalizer stream(*nfc);
+    std::string result8;
+    StringByteSink<std::string> sink(&result8);
+    stream.appendUTF8("ab", sink, errorCode);
+    UnicodeString result;
+    UnicodeStringAppendable appendable(result);
+    stream.append(u"c", appendable, errorCode);
+    assertEquals("append() after appendUTF8()", U_ILLEGAL_ARGUMENT_ERROR, errorCode.reset());
+    stream.reset();
+    stream.append(u"c", appendable, errorCode);
+    stream.finish(appendable, errorCode);
+    assertEquals("append() after reset()", u"c", result);
+    assertSuccess("append() after reset()", errorCode.get());
+
+    // Empty chunks (with nullptr data) with and without pending text.
+    stream.reset();
+    result8.clear();
+    stream.appendUTF8(StringPiece(), sink, errorCode);
+    stream.appendUTF8("a", sink, errorCode);
+    stream.appendUTF8(StringPiece(), sink, errorCode);
+    stream.appendUTF8("\xCC\x8A", sink, errorCode);  // U+030A
+    stream.finishUTF8(sink, errorCode);
+    assertTrue("appendUTF8(empty chunks)", result8 == "\xC3\xA5");  // U+00E5
+    assertSuccess("appendUTF8(empty chunks)", errorCode.get());
+}
+
 #endif /* #if !UCONFIG_NO_NORMALIZATION */
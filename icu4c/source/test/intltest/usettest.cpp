@@ -14,6 +14,7 @@
 #include <stdio.h>
 
 #include <string.h>
+#include <string>
 #include "unicode/utypes.h"
 #include "usettest.h"
 #include "unicode/ucnv.h"
@@ -92,6 +93,7 @@ UnicodeSetTest::runIndexedTest(int32_t index, UBool exec,
     TESTCASE_AUTO(TestIntOverflow);
     TESTCASE_AUTO(TestUnusedCcc);
     TESTCASE_AUTO(TestDeepPattern);
+    TESTCASE_AUTO(TestSpanLongASCII);
     TESTCASE_AUTO_END;
 }
 
@@ -3978,3 +3980,59 @@ void UnicodeSetTest::TestDeepPattern() {
     assertTrue("[a[a[a...1000s...]]] -> error", errorCode.isFailure());
     errorCode.reset();
 }
+
+// Frozen sets span runs of ASCII characters in blocks of 16.
+// Compare with the spans of the unfrozen sets at every start offset,
+// with block boundaries falling before, on, and after non-matching characters.
+void UnicodeSetTest::TestSpanLongASCII() {
+    IcuTestErrorCode errorCode(*this, "TestSpanLongASCII");
+    static const char16_t *const patterns[] = {
+        u"[a-zA-Z0-9_]",
+        u"[\\t\\n\\r\\u0020]",
+        u"[]",
+        u"[\\u0000-\\u007f]",
+        u"[acegikmoqsuwy]",  // more ranges than the vector code handles
+        u"[:L:]",
+        u"[a-z{xy}{xz}{qq}]"
+    };
+    UnicodeString text;
+    for (int32_t i = 0; i < 40; ++i) { text.append(u'a' + (i % 26)); }
+    text.append(u"\\u00e9 \\t\\n  xyz\\u4e00abcdefghijklmnopqrstuvwxyz0123456789_");
+    text.append(u"                                \\uD83D\\uDE00Q9");
+    for (int32_t i = 0; i < 35; ++i) { text.append(u'!' + i); }
+    text.append(u"xzxyqqab\\u00e9");
+    UnicodeString unescaped = text.unescape();
+    std::string utf8;
+    unescaped.toUTF8String(utf8);
+    int32_t length16 = unescaped.length();
+    int32_t length8 = (int32_t)utf8.length();
+    for (const char16_t *pattern : patterns) {
+        UnicodeSet set(UnicodeString(pattern).unescape(), errorCode);
+        if (errorCode.errIfFailureAndReset("UnicodeSet(pattern)")) {
+            continue;
+        }
+        UnicodeSet frozen(set);
+        frozen.freeze();
+        for (int32_t cond = USET_SPAN_NOT_CONTAINED; cond <= USET_SPAN_SIMPLE; ++cond) {
+            USetSpanCondition spanCondition = (USetSpanCondition)cond;
+            for (int32_t start = 0; start < length16; ++start) {
+                int32_t expected = set.span(unescaped.getBuffer() + start, length16 - start, spanCondition);
+                int32_t actual = frozen.span(unescaped.getBuffer() + start, length16 - start, spanCondition);
+                if (expected != actual) {
+                    errln(UnicodeString(u"UTF-16 span mismatch for ") + pattern +
+                          u" condition " + cond + u" at " + start +
+                          u": expected " + expected + u" actual " + actual);
+                }
+            }
+            for (int32_t start = 0; start < length8; ++start) {
+                int32_t expected = set.spanUTF8(utf8.data() + start, length8 - start, spanCondition);
+                int32_t actual = frozen.spanUTF8(utf8.data() + start, length8 - start, spanCondition);
+                if (expected != actual) {
+                    errln(UnicodeString(u"UTF-8 span mismatch for ") + pattern +
+                          u" condition " + cond + u" at " + start +
+                          u": expected " + expected + u" actual " + actual);
+                }
+            }
+        }
+    }
+}
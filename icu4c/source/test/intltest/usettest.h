@@ -94,6 +94,7 @@ class UnicodeSetTest: public IntlTest {
     void TestIntOverflow();
     void TestUnusedCcc();
     void TestDeepPattern();
+    void TestSpanLongASCII();
 
 private:
 
@@ -10,6 +10,10 @@
 */
 
 #include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "unicode/localpointer.h"
 #include "unicode/uperf.h"
 #include "unicode/ucol.h"
@@ -950,6 +954,134 @@ void StringPieceSortC::call(UErrorCode* status) {
     ops = cc.counter;
 }
 
+namespace {
+
+// Runs the tasks on as many threads as the hardware supports.
+void U_CALLCONV
+runTasksOnThreads(const void * /*runnerContext*/, UCollationTask *task, void *taskContext,
+                  int32_t count) {
+    std::atomic<int32_t> next(0);
+    int32_t numThreads = std::min<int32_t>(count, std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int32_t i; (i = next++) < count;) {
+                task(taskContext, i);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace
+
+//
+// Test case sorting an array of NUL-terminated UTF-16 string pointers
+// with std::sort() and Collator::compare(), as callers do without a sort API.
+// One operation is one string.
+//
+class UCharsStdSort : public CollPerfFunction {
+public:
+    UCharsStdSort(const Collator& coll, const UCollator *ucoll, const CA_uchar* data16)
+            : CollPerfFunction(coll, ucoll), d16(data16),
+              source(new const UChar*[d16->count]), dest(new const UChar*[d16->count]) {
+        for (int32_t i = 0; i < d16->count; ++i) {
+            source[i] = d16->dataOf(i);
+        }
+    }
+    virtual ~UCharsStdSort();
+    virtual void call(UErrorCode* status);
+
+protected:
+    const CA_uchar* d16;
+    const UChar** source;
+    const UChar** dest;  // aliases only
+};
+
+UCharsStdSort::~UCharsStdSort() {
+    delete[] source;
+    delete[] dest;
+}
+
+void UCharsStdSort::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    int32_t count = d16->count;
+    memcpy(dest, source, count * sizeof(const UChar *));
+    const Collator& c = coll;
+    std::sort(dest, dest + count, [&c](const UChar *left, const UChar *right) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        return c.compare(left, -1, right, -1, errorCode) < 0;
+    });
+    ops = count;
+}
+
+//
+// Test case sorting an array of NUL-terminated UTF-16 string pointers with ucol_sortStrings(),
+// serially or with a runner that uses all hardware threads.
+// One operation is one string.
+//
+class UCharsSortStrings : public UCharsStdSort {
+public:
+    UCharsSortStrings(const Collator& coll, const UCollator *ucoll, const CA_uchar* data16,
+                      UCollationTaskRunner *runner)
+            : UCharsStdSort(coll, ucoll, data16), runner(runner) {}
+    virtual ~UCharsSortStrings();
+    virtual void call(UErrorCode* status);
+
+private:
+    UCollationTaskRunner *runner;
+};
+
+UCharsSortStrings::~UCharsSortStrings() {}
+
+void UCharsSortStrings::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    int32_t count = d16->count;
+    memcpy(dest, source, count * sizeof(const UChar *));
+    ucol_sortStrings(ucoll, dest, NULL, count, runner, NULL, status);
+    ops = count;
+}
+
+//
+// Test case sorting an array of NUL-terminated UTF-8 string pointers with ucol_sortStringsUTF8().
+// One operation is one string.
+//
+class UTF8SortStrings : public CollPerfFunction {
+public:
+    UTF8SortStrings(const Collator& coll, const UCollator *ucoll, const CA_char* data8)
+            : CollPerfFunction(coll, ucoll), d8(data8),
+              source(new const char*[d8->count]), dest(new const char*[d8->count]) {
+        for (int32_t i = 0; i < d8->count; ++i) {
+            source[i] = d8->dataOf(i);
+        }
+    }
+    virtual ~UTF8SortStrings();
+    virtual void call(UErrorCode* status);
+
+private:
+    const CA_char* d8;
+    const char** source;
+    const char** dest;  // aliases only
+};
+
+UTF8SortStrings::~UTF8SortStrings() {
+    delete[] source;
+    delete[] dest;
+}
+
+void UTF8SortStrings::call(UErrorCode* status) {
+    if (U_FAILURE(*status)) return;
+
+    int32_t count = d8->count;
+    memcpy(dest, source, count * sizeof(const char *));
+    ucol_sortStringsUTF8(ucoll, dest, NULL, count, NULL, NULL, status);
+    ops = count;
+}
+
 //
 // Test case performing binary searches in a sorted array of UnicodeString pointers.
 //
@@ -1123,6 +1255,11 @@ class CollPerf2Test : public UPerfTest
     UPerfFunction* TestStringPieceSortCpp();
     UPerfFunction* TestStringPieceSortC();
 
+    UPerfFunction* TestUCharsStdSort();
+    UPerfFunction* TestUCharsSortStrings();
+    UPerfFunction* TestUCharsSortStringsThreads();
+    UPerfFunction* TestUTF8SortStrings();
+
     UPerfFunction* TestUniStrBinSearch();
     UPerfFunction* TestStringPieceBinSearchCpp();
     UPerfFunction* TestStringPieceBinSearchC();
@@ -1430,6 +1567,11 @@ CollPerf2Test::runIndexedTest(int32_t index, UBool exec, const char *&name, char
     TESTCASE_AUTO(TestStringPieceSortCpp);
     TESTCASE_AUTO(TestStringPieceSortC);
 
+    TESTCASE_AUTO(TestUCharsStdSort);
+    TESTCASE_AUTO(TestUCharsSortStrings);
+    TESTCASE_AUTO(TestUCharsSortStringsThreads);
+    TESTCASE_AUTO(TestUTF8SortStrings);
+
     TESTCASE_AUTO(TestUniStrBinSearch);
     TESTCASE_AUTO(TestStringPieceBinSearchCpp);
     TESTCASE_AUTO(TestStringPieceBinSearchC);
@@ -1756,6 +1898,47 @@ UPerfFunction* CollPerf2Test::TestStringPieceSortC() {
     return testCase;
 }
 
+UPerfFunction* CollPerf2Test::TestUCharsStdSort() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new UCharsStdSort(*collObj, coll, getRandomData16(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestUCharsSortStrings() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new UCharsSortStrings(*collObj, coll, getRandomData16(status), NULL);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestUCharsSortStringsThreads() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase =
+        new UCharsSortStrings(*collObj, coll, getRandomData16(status), runTasksOnThreads);
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
+UPerfFunction* CollPerf2Test::TestUTF8SortStrings() {
+    UErrorCode status = U_ZERO_ERROR;
+    UPerfFunction *testCase = new UTF8SortStrings(*collObj, coll, getRandomData8(status));
+    if (U_FAILURE(status)) {
+        delete testCase;
+        return NULL;
+    }
+    return testCase;
+}
+
 UPerfFunction* CollPerf2Test::TestUniStrBinSearch() {
     UErrorCode status = U_ZERO_ERROR;
     UPerfFunction *testCase = new UniStrBinSearch(*collObj, coll, getSortedData16(status));
@@ -19,6 +19,7 @@
 #include "data.h"
 #include <stdio.h>
 #include "cmemory.h" // for UPRV_LENGTHOF
+#include "cstring.h"
 
 int main(int argc, const char* argv[]){
     UErrorCode status = U_ZERO_ERROR;
@@ -116,6 +117,23 @@ UPerfFunction* ConverterPerformanceTest::runIndexedTest(int32_t index, UBool exe
         TESTCASE(52,TestWinANSI_ISO2022JP_ToUnicode);
         TESTCASE(53,TestWinANSI_ISO2022JP_FromUnicode);
 
+        TESTCASE(54,TestICU_UTF8_Latin1_ConvertEx_1K);
+        TESTCASE(55,TestICU_UTF8_Latin1_ConvertEx_64K);
+        TESTCASE(56,TestICU_UTF8_Latin1_ConvertEx_1M);
+        TESTCASE(57,TestICU_UTF8_Latin1_ConvertEx_64M);
+        TESTCASE(58,TestICU_Latin1_UTF8_ConvertEx_1K);
+        TESTCASE(59,TestICU_Latin1_UTF8_ConvertEx_64K);
+        TESTCASE(60,TestICU_Latin1_UTF8_ConvertEx_1M);
+        TESTCASE(61,TestICU_Latin1_UTF8_ConvertEx_64M);
+        TESTCASE(62,TestICU_UTF8_ASCII_ConvertEx_1K);
+        TESTCASE(63,TestICU_UTF8_ASCII_ConvertEx_64K);
+        TESTCASE(64,TestICU_UTF8_ASCII_ConvertEx_1M);
+        TESTCASE(65,TestICU_UTF8_ASCII_ConvertEx_64M);
+        TESTCASE(66,TestICU_ASCII_UTF8_ConvertEx_1K);
+        TESTCASE(67,TestICU_ASCII_UTF8_ConvertEx_64K);
+        TESTCASE(68,TestICU_ASCII_UTF8_ConvertEx_1M);
+        TESTCASE(69,TestICU_ASCII_UTF8_ConvertEx_64M);
+
         default: 
             name = ""; 
             return NULL;
@@ -657,3 +675,89 @@ UPerfFunction*  ConverterPerformanceTest::TestWinANSI_ISO2022JP_ToUnicode(){
     }
     return pf;
 }
+
+//################ ucnv_convertEx() with buffers from 1 KB to 64 MB
+
+/* Mostly ASCII, with some Latin-1 letters. */
+static const UChar latin1Sample[] = u"Les na\u00effs \u00e6githales h\u00e2tifs pondant \u00e0 No\u00ebl o\u00f9 il g\u00e8le sont s\u00fbrs "
+    u"d'\u00eatre d\u00e9\u00e7us en voyant leurs dr\u00f4les d'oeufs ab\u00eem\u00e9s. The quick brown fox jumps over the lazy dog. ";
+/* Only ASCII, so that every character is mappable to US-ASCII. */
+static const UChar asciiSample[] = u"The quick brown fox jumps over the lazy dog. "
+    u"Pack my box with five dozen liquor jugs; 0123456789 (ASCII only). ";
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ConvertEx(const char* sourceName, const char* targetName, int32_t size){
+    UErrorCode status = U_ZERO_ERROR;
+    UBool isASCII = uprv_strcmp(sourceName, "US-ASCII") == 0 || uprv_strcmp(targetName, "US-ASCII") == 0;
+    const UChar* sample = isASCII ? asciiSample : latin1Sample;
+    int32_t sampleLen = isASCII ? UPRV_LENGTHOF(asciiSample) - 1 : UPRV_LENGTHOF(latin1Sample) - 1;
+    UPerfFunction* pf = new ICUConvertExPerfFunction(sourceName, targetName, sample, sampleLen, size, status);
+    if(U_FAILURE(status)){
+        delete pf;
+        return NULL;
+    }
+    return pf;
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_Latin1_ConvertEx_1K(){
+    return TestICU_ConvertEx("UTF-8", "ISO-8859-1", 1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_Latin1_ConvertEx_64K(){
+    return TestICU_ConvertEx("UTF-8", "ISO-8859-1", 64*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_Latin1_ConvertEx_1M(){
+    return TestICU_ConvertEx("UTF-8", "ISO-8859-1", 1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_Latin1_ConvertEx_64M(){
+    return TestICU_ConvertEx("UTF-8", "ISO-8859-1", 64*1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin1_UTF8_ConvertEx_1K(){
+    return TestICU_ConvertEx("ISO-8859-1", "UTF-8", 1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin1_UTF8_ConvertEx_64K(){
+    return TestICU_ConvertEx("ISO-8859-1", "UTF-8", 64*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin1_UTF8_ConvertEx_1M(){
+    return TestICU_ConvertEx("ISO-8859-1", "UTF-8", 1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_Latin1_UTF8_ConvertEx_64M(){
+    return TestICU_ConvertEx("ISO-8859-1", "UTF-8", 64*1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_ASCII_ConvertEx_1K(){
+    return TestICU_ConvertEx("UTF-8", "US-ASCII", 1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_ASCII_ConvertEx_64K(){
+    return TestICU_ConvertEx("UTF-8", "US-ASCII", 64*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_ASCII_ConvertEx_1M(){
+    return TestICU_ConvertEx("UTF-8", "US-ASCII", 1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_UTF8_ASCII_ConvertEx_64M(){
+    return TestICU_ConvertEx("UTF-8", "US-ASCII", 64*1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_UTF8_ConvertEx_1K(){
+    return TestICU_ConvertEx("US-ASCII", "UTF-8", 1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_UTF8_ConvertEx_64K(){
+    return TestICU_ConvertEx("US-ASCII", "UTF-8", 64*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_UTF8_ConvertEx_1M(){
+    return TestICU_ConvertEx("US-ASCII", "UTF-8", 1024*1024);
+}
+
+UPerfFunction* ConverterPerformanceTest::TestICU_ASCII_UTF8_ConvertEx_64M(){
+    return TestICU_ConvertEx("US-ASCII", "UTF-8", 64*1024*1024);
+}
@@ -117,6 +117,77 @@ class ICUFromUnicodePerfFunction : public UPerfFunction{
     }
 };
 
+/*
+ * Converts directly between two charsets with ucnv_convertEx()
+ * (using a UTF-16 pivot buffer if necessary).
+ * The input text is generated by repeating a sample string
+ * until it fills a buffer of the requested size.
+ */
+class ICUConvertExPerfFunction : public UPerfFunction{
+private:
+    UConverter* sourceConv;
+    UConverter* targetConv;
+    char* src;
+    int32_t srcLen;
+    char* target;
+    int32_t targetCapacity;
+    UChar pivot[1024];
+
+public:
+    ICUConvertExPerfFunction(const char* sourceName, const char* targetName,
+                             const UChar* sample, int32_t sampleLen,
+                             int32_t size, UErrorCode& status){
+        sourceConv = ucnv_open(sourceName, &status);
+        targetConv = ucnv_open(targetName, &status);
+        src = NULL;
+        target = NULL;
+        srcLen = 0;
+        targetCapacity = 0;
+        if(U_FAILURE(status)){
+            return;
+        }
+        char encodedSample[1024];
+        int32_t encodedLen = ucnv_fromUChars(sourceConv, encodedSample, (int32_t)sizeof(encodedSample),
+                                             sample, sampleLen, &status);
+        src = (char*)malloc(size);
+        targetCapacity = size * ucnv_getMaxCharSize(targetConv);
+        target = (char*)malloc(targetCapacity);
+        if(U_FAILURE(status)){
+            return;
+        }
+        if(src == NULL || target == NULL){
+            status = U_MEMORY_ALLOCATION_ERROR;
+            return;
+        }
+        /* repeat whole copies of the sample, and pad with spaces */
+        while((size - srcLen) >= encodedLen){
+            uprv_memcpy(src + srcLen, encodedSample, encodedLen);
+            srcLen += encodedLen;
+        }
+        while(srcLen < size){
+            src[srcLen++] = ' ';
+        }
+    }
+    virtual void call(UErrorCode* status){
+        const char* mySrc = src;
+        char* myTarget = target;
+        UChar* pivotSource = pivot;
+        UChar* pivotTarget = pivot;
+        ucnv_convertEx(targetConv, sourceConv, &myTarget, target + targetCapacity,
+                       &mySrc, src + srcLen, pivot, &pivotSource, &pivotTarget,
+                       pivot + UPRV_LENGTHOF(pivot), TRUE, TRUE, status);
+    }
+    virtual long getOperationsPerIteration(void){
+        return srcLen;
+    }
+    ~ICUConvertExPerfFunction(){
+        free(src);
+        free(target);
+        ucnv_close(sourceConv);
+        ucnv_close(targetConv);
+    }
+};
+
 class ICUOpenAllConvertersFunction : public UPerfFunction{
 private:
     UBool cleanup;
@@ -566,6 +637,26 @@ class  ConverterPerformanceTest : public UPerfTest{
     UPerfFunction* TestWinIML2_ISO2022JP_ToUnicode();
     UPerfFunction* TestWinIML2_ISO2022JP_FromUnicode(); 
 
+    UPerfFunction* TestICU_UTF8_Latin1_ConvertEx_1K();
+    UPerfFunction* TestICU_UTF8_Latin1_ConvertEx_64K();
+    UPerfFunction* TestICU_UTF8_Latin1_ConvertEx_1M();
+    UPerfFunction* TestICU_UTF8_Latin1_ConvertEx_64M();
+    UPerfFunction* TestICU_Latin1_UTF8_ConvertEx_1K();
+    UPerfFunction* TestICU_Latin1_UTF8_ConvertEx_64K();
+    UPerfFunction* TestICU_Latin1_UTF8_ConvertEx_1M();
+    UPerfFunction* TestICU_Latin1_UTF8_ConvertEx_64M();
+    UPerfFunction* TestICU_UTF8_ASCII_ConvertEx_1K();
+    UPerfFunction* TestICU_UTF8_ASCII_ConvertEx_64K();
+    UPerfFunction* TestICU_UTF8_ASCII_ConvertEx_1M();
+    UPerfFunction* TestICU_UTF8_ASCII_ConvertEx_64M();
+    UPerfFunction* TestICU_ASCII_UTF8_ConvertEx_1K();
+    UPerfFunction* TestICU_ASCII_UTF8_ConvertEx_64K();
+    UPerfFunction* TestICU_ASCII_UTF8_ConvertEx_1M();
+    UPerfFunction* TestICU_ASCII_UTF8_ConvertEx_64M();
+
+private:
+    UPerfFunction* TestICU_ConvertEx(const char* sourceName, const char* targetName, int32_t size);
+
 };
 
 #endif
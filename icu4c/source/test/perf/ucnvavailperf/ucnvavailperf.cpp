@@ -40,17 +40,28 @@
             // new behavior
             if (ucnv_canCreateConverter(converterName, &localStatus)) {
 #endif
+*
+*   It also measures the throughput of ucnv_open()+ucnv_close(),
+*   ucnv_safeClone()+ucnv_close() and ucnv_acquire()+ucnv_release()
+*   of converters whose data is already cached,
+*   with 1, 2, 4 and 8 threads, for the lock-free converter cache.
+*   With a scalable cache, the time per thread should not grow much
+*   with the number of threads (up to the number of CPU cores).
 */
 
 #include <malloc.h>
 #include <stdio.h>
+#include <atomic>
+#include <thread>
+#include <vector>
 #include "unicode/utypes.h"
 #include "unicode/putil.h"
 #include "unicode/uclean.h"
 #include "unicode/ucnv.h"
 #include "unicode/utimer.h"
 
-static size_t icuMemUsage = 0;
+// Atomic because the multi-threaded measurements allocate concurrently.
+static std::atomic<size_t> icuMemUsage(0);
 
 U_CDECL_BEGIN
 
@@ -84,6 +95,84 @@ my_realloc(const void *context, void *mem, size_t size) {
 
 U_CDECL_END
 
+#define LENGTHOF(array) (int32_t)(sizeof(array)/sizeof((array)[0]))
+
+static const char *const cachedCharsets[] = {
+    "windows-1252", "Shift_JIS", "GB18030", "EUC-KR", "ibm-1047", "ibm-1390"
+};
+
+static const int32_t OPEN_CLOSE_LOOPS = 200000;
+
+static void
+openCloseLoop(int32_t offset) {
+    for (int32_t i = 0; i < OPEN_CLOSE_LOOPS; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        ucnv_close(ucnv_open(cachedCharsets[(i + offset) % LENGTHOF(cachedCharsets)], &errorCode));
+    }
+}
+
+static UConverter *cachedConverters[LENGTHOF(cachedCharsets)];
+
+static void
+cloneCloseLoop(int32_t offset) {
+    const UConverter *cnv = cachedConverters[offset % LENGTHOF(cachedCharsets)];
+    for (int32_t i = 0; i < OPEN_CLOSE_LOOPS; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        ucnv_close(ucnv_safeClone(cnv, NULL, NULL, &errorCode));
+    }
+}
+
+static void
+acquireReleaseLoop(int32_t offset) {
+    for (int32_t i = 0; i < OPEN_CLOSE_LOOPS; ++i) {
+        UErrorCode errorCode = U_ZERO_ERROR;
+        ucnv_release(ucnv_acquire(cachedCharsets[(i + offset) % LENGTHOF(cachedCharsets)], &errorCode));
+    }
+}
+
+// Runs the loop on numThreads threads and returns the elapsed seconds.
+static double
+runThreads(int32_t numThreads, void (*loop)(int32_t)) {
+    std::vector<std::thread> threads;
+    UTimer start_time;
+    utimer_getTime(&start_time);
+    for (int32_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back(loop, t);
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    return utimer_getElapsedSeconds(&start_time);
+}
+
+static void
+measureOpenClose() {
+    UErrorCode errorCode = U_ZERO_ERROR;
+    for (int32_t i = 0; i < LENGTHOF(cachedCharsets); ++i) {
+        cachedConverters[i] = ucnv_open(cachedCharsets[i], &errorCode);
+    }
+    if (U_FAILURE(errorCode)) {
+        fprintf(stderr, "unable to open the test converters - %s\n", u_errorName(errorCode));
+        return;
+    }
+    printf("%d ucnv_open()+ucnv_close(), ucnv_safeClone()+ucnv_close() and "
+           "ucnv_acquire()+ucnv_release() per thread:\n",
+           (int)OPEN_CLOSE_LOOPS);
+    for (int32_t numThreads = 1; numThreads <= 8; numThreads *= 2) {
+        double openSeconds = runThreads(numThreads, openCloseLoop);
+        double cloneSeconds = runThreads(numThreads, cloneCloseLoop);
+        double poolSeconds = runThreads(numThreads, acquireReleaseLoop);
+        printf("  %d thread(s): open %g seconds, clone %g seconds, pool %g seconds\n",
+               (int)numThreads, openSeconds, cloneSeconds, poolSeconds);
+    }
+    int32_t hits, misses;
+    ucnv_getPoolStatistics(&hits, &misses);
+    printf("converter pool: %d hits, %d misses\n", (int)hits, (int)misses);
+    for (int32_t i = 0; i < LENGTHOF(cachedCharsets); ++i) {
+        ucnv_close(cachedConverters[i]);
+    }
+}
+
 int main(int argc, const char *argv[]) {
     UErrorCode errorCode = U_ZERO_ERROR;
 
@@ -125,6 +214,8 @@ int main(int argc, const char *argv[]) {
     printf("ucnv_countAvailable() took %g seconds to figure this out.\n", elapsed);
     printf("memory usage after ucnv_countAvailable(): %lu\n", (long)icuMemUsage);
 
+    measureOpenClose();
+
     ucnv_flushCache();
     printf("memory usage after ucnv_flushCache(): %lu\n", (long)icuMemUsage);
 
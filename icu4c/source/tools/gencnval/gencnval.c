@@ -86,7 +86,7 @@ static const UDataInfo dataInfo={
     0,
 
     {0x43, 0x76, 0x41, 0x6c},     /* dataFormat="CvAl" */
-    {3, 0, 1, 0},                 /* formatVersion */
+    {3, 1, 0, 0},                 /* formatVersion */
     {1, 4, 2, 0}                  /* dataVersion */
 };
 
@@ -978,10 +978,21 @@ createNormalizedAliasStrings(char *normalizedStrings, const char *origStringBloc
     }
 }
 
+/* Returns the alias hash table length for the number of unique aliases: a power of 2, at most half full. */
+static uint32_t
+getAliasHashTableCapacity(uint32_t uniqueAliasesSize) {
+    uint32_t capacity = 16;
+    while (capacity < 2 * uniqueAliasesSize) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
 static void
 writeAliasTable(UNewDataMemory *out) {
     uint32_t i, j;
     uint32_t uniqueAliasesSize;
+    uint32_t aliasHashTableCapacity;
     uint16_t aliasOffset = (uint16_t)(tagBlock.top/sizeof(uint16_t));
     uint16_t *aliasArrLists = (uint16_t *)uprv_malloc(tagCount * converterCount * sizeof(uint16_t));
     uint16_t *uniqueAliases = (uint16_t *)uprv_malloc(knownAliasesCount * sizeof(uint16_t));
@@ -1000,12 +1011,15 @@ writeAliasTable(UNewDataMemory *out) {
         }
     }
 
+    aliasHashTableCapacity = getAliasHashTableCapacity(uniqueAliasesSize);
+
     /* Write the size of the TOC */
     if (tableOptions.stringNormalizationType == UCNV_IO_UNNORMALIZED) {
         udata_write32(out, 8);
     }
     else {
-        udata_write32(out, 9);
+        /* normalized strings and the alias hash table */
+        udata_write32(out, 10);
     }
 
     /* Write the sizes of each section */
@@ -1020,6 +1034,7 @@ writeAliasTable(UNewDataMemory *out) {
     udata_write32(out, (tagBlock.top + stringBlock.top) / sizeof(uint16_t));
     if (tableOptions.stringNormalizationType != UCNV_IO_UNNORMALIZED) {
         udata_write32(out, (tagBlock.top + stringBlock.top) / sizeof(uint16_t));
+        udata_write32(out, aliasHashTableCapacity);
     }
 
     /* write the table of converters */
@@ -1071,6 +1086,15 @@ writeAliasTable(UNewDataMemory *out) {
 
         /* Write out the complete normalized array. */
         udata_writeString(out, normalizedStrings, tagBlock.top + stringBlock.top);
+
+        /* write the hash table for looking up normalized aliases */
+        {
+            uint16_t *aliasHashTable = (uint16_t *)uprv_malloc(aliasHashTableCapacity * sizeof(uint16_t));
+            ucnv_io_fillAliasHashTable(aliasHashTable, aliasHashTableCapacity,
+                                       uniqueAliases, uniqueAliasesSize, normalizedStrings);
+            udata_writeBlock(out, aliasHashTable, aliasHashTableCapacity * sizeof(uint16_t));
+            uprv_free(aliasHashTable);
+        }
         uprv_free(normalizedStrings);
     }
 
@@ -48,7 +48,7 @@ typedef struct ConvData {
 
 static void
 initConvData(ConvData *data) {
-    uprv_memset(data, 0, sizeof(ConvData));
+    uprv_memset((void *)data, 0, sizeof(ConvData));  /* UConverterSharedData has an atomic member */
     data->sharedData.structSize=sizeof(UConverterSharedData);
     data->staticData.structSize=sizeof(UConverterStaticData);
     data->sharedData.staticData=&data->staticData;